@@ -1,10 +1,16 @@
 //------------------------- APP ___________
 typedef struct {
     Parent window; // Window struct from window.h
+    const StartupReport* startup; // Time-to-first-frame breakdown (complete after the first present)
+    TimerWheel* timers; // Timers and tweens the main loop sleeps on (see timers.h)
 } App;
 
 App init_app(void) {
+    startup_begin_();  // Startup report measures from here
     App app = {0}; // Initialize struct members to zero
+    app.startup = &startup_report_;
+    init_timer_wheel_(&timer_wheel_);
+    app.timers = &timer_wheel_;
     
     // Set default theme (e.g., light mode)
     set_theme(&THEME_DARK);
@@ -31,70 +37,404 @@ int is_any_text_widget_active(void) {
     return 0;
 }
 
-void app_run_(Parent *parent) {
+// Returns the startup report; complete once app_run_ has presented its first frame
+const StartupReport* get_startup_report(App* app) {
+    return app ? app->startup : &startup_report_;
+}
+
+// ______________MAIN LOOP PIECES_____________
+// Shared by the classic loop and the update thread of the pipelined one.
+
+// Events after which the whole window is redrawn; for everything else, widgets mark
+// their own rect when their hover, press or value state changes
+static inline bool is_full_redraw_event_(SDL_Event event, bool resized) {
+    if (resized) return true;  // Size or DPI
+    if (event.type == SDL_RENDER_TARGETS_RESET || event.type == SDL_RENDER_DEVICE_RESET) return true;
+    if (event.type != SDL_WINDOWEVENT) return false;
+    return event.window.event == SDL_WINDOWEVENT_EXPOSED || event.window.event == SDL_WINDOWEVENT_SHOWN ||
+           event.window.event == SDL_WINDOWEVENT_SIZE_CHANGED;
+}
+
+// Handles one event on the UI thread; `resized` says whether it changed the window metrics.
+// Returns false on SDL_QUIT.
+static inline bool handle_app_event_(SDL_Event event, bool resized) {
+    if (is_full_redraw_event_(event, resized)) mark_all_dirty();
+    if (event.type == SDL_QUIT) return false;
+
+    // Window resize / DPI change: layouts react before widgets see the event
+    if (resized) {
+        update_all_registered_layouts();
+        update_all_registered_container_transforms();
+    }
+
+    // New: Handle theme switching on key press
+    if (event.type == SDL_KEYDOWN) {
+        switch (event.key.keysym.sym) {
+            case SDLK_l:  // 'L' for Light
+                set_theme(&THEME_LIGHT);
+                LOG_INFO("Switched to Light theme");
+                break;
+            case SDLK_d:  // 'D' for Dark
+                set_theme(&THEME_DARK);
+                LOG_INFO("Switched to Dark theme");
+                break;
+            case SDLK_h:  // 'H' for Hacker
+                set_theme(&THEME_HACKER);
+                LOG_INFO("Switched to Hacker theme");
+                break;
+            default:
+                break;
+        }
+    }
+
+    // Viewers under the cursor zoom on the wheel instead of the container scrolling
+    if (!update_all_registered_tiled_images(event)) {
+        update_all_registered_containers(event);
+    }
+    update_all_registered_radios(event);
+    update_all_registered_entrys(event);
+    update_all_registered_textboxs(event);
+    update_all_registered_sliders(event);  // Update sliders
+    update_all_registered_buttons(event);
+    update_all_registered_texts(event);
+    update_all_registered_drops(event);
+    update_all_registered_progress_bars(event);
+    update_all_registered_images(event);
+    update_all_registered_animated_images(event);
+    return true;
+}
+
+// Runs what is due before waiting for events; returns how long the loop may then sleep
+// (-1 = until an event)
+static inline int run_app_due_work_(void) {
+    // Due timers and tweens (cursor blink, fades, ...) mark only their own widget dirty
+    run_timers_();
+    int wake_ms = tick_animated_images_();  // Marks only the animated widgets' rects dirty
+    int timer_ms = next_timer_ms_();
+    if (timer_ms >= 0 && (wake_ms < 0 || timer_ms < wake_ms)) wake_ms = timer_ms;
+    return wake_ms;
+}
+
+// After the events of one iteration: cross-thread updates, then coalesced change callbacks
+static inline void run_app_posted_work_(void) {
+    // Updates posted by worker threads; the newest per widget and setter is applied. Setters
+    // mark their own widget dirty, and finished image loads mark the widgets waiting for them.
+    drain_widget_updates_();
+    // Slider/drop/radio changes from this iteration's events, at most once per frame each
+    flush_change_notifiers_();
+}
+
+// Layout for the frame about to be drawn
+static inline void layout_app_frame_(void) {
+    update_all_registered_layouts();
+    update_all_registered_container_transforms();  // Pick up drags from this frame's events
+    update_container_occluders();  // Opaque containers hide what is drawn below them
+}
+
+// ______________PIPELINED MODE_____________
+// The thread that created the window keeps it, the renderer and the event pump
+// (SDL requires that on most platforms) and becomes the render thread: it forwards
+// events to an update thread and presents the snapshots it publishes (snapshot.h).
+// Everything else that app_run_ does, including every widget callback, runs on the
+// update thread. The texture cache stays with the update thread too, but uploads and
+// texture frees are left to the render thread (defer_texture_uploads_, graphics.h).
+
+static bool pipelined_rendering_ = false;
+
+/**
+ * @brief Runs widgets on an update thread and presents on the window's thread, so a
+ *        slow present or GPU stall no longer delays input handling. Set before app_run_.
+ */
+static inline void set_pipelined_rendering(bool enabled) {
+    pipelined_rendering_ = enabled;
+}
+
+/**
+ * @brief An event handed to the update thread
+ */
+typedef struct {
+    SDL_Event event;
+    int w, h, pixel_w;  // SDL_WINDOWEVENT_SIZE_CHANGED: window metrics, measured by the render thread
+} ForwardedEvent;
+
+/**
+ * @brief Event queue from the render thread to the update thread, plus the state
+ *        that goes back
+ */
+typedef struct {
+    SDL_mutex* lock;          // Guards the queue and `quit`
+    SDL_cond* wake;           // Signalled when an event is queued or on quit
+    ForwardedEvent* events;   // Ring buffer; grows instead of dropping input
+    int head, count, capacity;
+    bool quit;
+    SDL_atomic_t text_input;  // Wanted SDL text input state; applied by the render thread
+    Parent* window;
+} AppPipeline;
+
+static AppPipeline app_pipeline_;
+
+// Render thread: queues one event, measuring the window for resizes
+static inline void forward_app_event_(AppPipeline* pipeline, SDL_Event* event) {
+    ForwardedEvent forwarded = {0};
+    forwarded.event = *event;
+    if (event->type == SDL_WINDOWEVENT && event->window.event == SDL_WINDOWEVENT_SIZE_CHANGED) {
+        int pixel_h;
+        SDL_GetWindowSize(pipeline->window->base.sdl_window, &forwarded.w, &forwarded.h);
+        SDL_GetRendererOutputSize(pipeline->window->base.sdl_renderer, &forwarded.pixel_w, &pixel_h);
+    }
+
+    SDL_LockMutex(pipeline->lock);
+    if (pipeline->count == pipeline->capacity) {
+        int capacity = pipeline->capacity ? pipeline->capacity * 2 : 256;
+        ForwardedEvent* grown = (ForwardedEvent*)malloc(sizeof(ForwardedEvent) * capacity);
+        if (!grown) {
+            SDL_UnlockMutex(pipeline->lock);
+            LOG_ERROR("Event queue full, dropping event %u", (unsigned)event->type);
+            return;
+        }
+        for (int i = 0; i < pipeline->count; i++) {
+            grown[i] = pipeline->events[(pipeline->head + i) % pipeline->capacity];
+        }
+        free(pipeline->events);
+        pipeline->events = grown;
+        pipeline->head = 0;
+        pipeline->capacity = capacity;
+    }
+    pipeline->events[(pipeline->head + pipeline->count) % pipeline->capacity] = forwarded;
+    pipeline->count++;
+    SDL_CondSignal(pipeline->wake);
+    SDL_UnlockMutex(pipeline->lock);
+}
+
+// Update thread: takes the next event, waiting up to timeout_ms (< 0 = until one comes).
+// Returns false on timeout or quit.
+static inline bool next_forwarded_event_(AppPipeline* pipeline, ForwardedEvent* out, int timeout_ms) {
+    SDL_LockMutex(pipeline->lock);
+    if (pipeline->count == 0 && !pipeline->quit && timeout_ms != 0) {
+        if (timeout_ms < 0) SDL_CondWait(pipeline->wake, pipeline->lock);
+        else SDL_CondWaitTimeout(pipeline->wake, pipeline->lock, (Uint32)timeout_ms);
+    }
+    bool have_event = pipeline->count > 0 && !pipeline->quit;
+    if (have_event) {
+        *out = pipeline->events[pipeline->head];
+        pipeline->head = (pipeline->head + 1) % pipeline->capacity;
+        pipeline->count--;
+    }
+    SDL_UnlockMutex(pipeline->lock);
+    return have_event;
+}
+
+static inline bool is_pipeline_quitting_(AppPipeline* pipeline) {
+    SDL_LockMutex(pipeline->lock);
+    bool quit = pipeline->quit;
+    SDL_UnlockMutex(pipeline->lock);
+    return quit;
+}
+
+// Update thread: records everything the classic loop would draw, in its order, into
+// the back snapshot (published separately)
+static inline void record_app_snapshot_(Parent* parent) {
+    begin_full_frame_();
+    record_frame_draw_lists_();
+    FrameSnapshot* snapshot = begin_frame_snapshot_(parent->color);
+    append_frame_slots_(&snapshot->list);
+    hold_snapshot_textures_(snapshot);
+    if (snapshot->list.failed) LOG_WARN("Out of memory recording a frame; it is drawn incomplete");
+    bake_snapshot_text_(snapshot);
+}
+
+static int app_update_thread_(void* data) {
+    AppPipeline* pipeline = (AppPipeline*)data;
+    Parent* parent = pipeline->window;
+    bool first_frame = true;  // Startup phases are timed until the first snapshot is published
+    bool running = true;
+    while (running && !is_pipeline_quitting_(pipeline)) {
+        Uint64 phase_start = first_frame ? startup_mark_() : 0;
+        update_all_registered_layouts();
+        update_parent_transform(parent);
+        update_all_registered_container_transforms();
+        startup_add_(STARTUP_FIRST_LAYOUT, phase_start);
+
+        int wake_ms = run_app_due_work_();
+        int timeout_ms = is_frame_dirty_() ? 0 : wake_ms;
+        ForwardedEvent forwarded;
+        bool have_event = next_forwarded_event_(pipeline, &forwarded, timeout_ms);
+        for (; have_event; have_event = next_forwarded_event_(pipeline, &forwarded, 0)) {
+            SDL_Event event = forwarded.event;
+            bool resized = false;
+            if (event.type == SDL_WINDOWEVENT && event.window.event == SDL_WINDOWEVENT_SIZE_CHANGED) {
+                resized = set_window_metrics_(parent, forwarded.w, forwarded.h, forwarded.pixel_w);
+            }
+            if (!handle_app_event_(event, resized)) running = false;
+        }
+        SDL_AtomicSet(&pipeline->text_input, is_any_text_widget_active());
+
+        run_app_posted_work_();
+
+        if (!is_frame_dirty_() || !running) continue;  // Nothing changed on screen
+
+        phase_start = first_frame ? startup_mark_() : 0;
+        layout_app_frame_();
+        startup_add_(STARTUP_FIRST_LAYOUT, phase_start);
+
+        phase_start = first_frame ? startup_mark_() : 0;
+        record_app_snapshot_(parent);
+        startup_add_(STARTUP_FIRST_RENDER, phase_start);
+        first_frame = false;  // The render thread completes the report once it presents this one
+        publish_frame_snapshot_();
+    }
+    return 0;
+}
+
+// Render thread: runs the pipelined loop until SDL_QUIT. Returns false (nothing
+// started) if the update thread could not be created, so the classic loop takes over.
+static inline bool app_run_pipelined_(Parent* parent) {
+    AppPipeline* pipeline = &app_pipeline_;
+    pipeline->window = parent;
+    pipeline->quit = false;
+    SDL_AtomicSet(&pipeline->text_input, 0);
+    if (!pipeline->lock) pipeline->lock = SDL_CreateMutex();
+    if (!pipeline->wake) pipeline->wake = SDL_CreateCond();
+    if (!pipeline->lock || !pipeline->wake) {
+        LOG_ERROR("Failed to create pipeline lock: %s", SDL_GetError());
+        return false;
+    }
+    start_frame_mailbox_();
+    defer_texture_uploads_(true);
+    SDL_Thread* update_thread = SDL_CreateThread(app_update_thread_, "update", pipeline);
+    if (!update_thread) {
+        defer_texture_uploads_(false);
+        LOG_WARN("Failed to start update thread, using the classic loop: %s", SDL_GetError());
+        return false;
+    }
+
+    SDL_Renderer* renderer = parent->base.sdl_renderer;
+    int text_input = 0;
+    bool running = true;
+    while (running) {
+        SDL_Event event;
+        // Without a wake-up event, poll for new snapshots at about the display rate
+        bool have_event = frame_mailbox_.wake_event ? SDL_WaitEvent(&event) : SDL_WaitEventTimeout(&event, 16);
+        for (; have_event; have_event = SDL_PollEvent(&event)) {
+            if (frame_mailbox_.wake_event && event.type == frame_mailbox_.wake_event) continue;  // Only wakes us
+            if (event.type == SDL_QUIT) running = false;
+            forward_app_event_(pipeline, &event);
+        }
+
+        // SDL text input belongs to the window's thread
+        int wanted = SDL_AtomicGet(&pipeline->text_input);
+        if (wanted != text_input) {
+            if (wanted) SDL_StartTextInput();
+            else SDL_StopTextInput();
+            text_input = wanted;
+        }
+
+        free_retired_textures_();  // Images the update thread released
+
+        FrameSnapshot* snapshot = acquire_frame_snapshot_();
+        if (!snapshot || !running) continue;
+        Uint64 phase_start = snapshot->sequence == 1 ? startup_mark_() : 0;
+        present_frame_snapshot_(renderer, snapshot);
+        if (snapshot->sequence == 1) {
+            startup_add_(STARTUP_FIRST_PRESENT, phase_start);
+            startup_complete_();
+            LOG_INFO("First frame presented %.1f ms after startup", startup_report_.total_ms);
+        }
+    }
+
+    SDL_LockMutex(pipeline->lock);
+    pipeline->quit = true;
+    SDL_CondSignal(pipeline->wake);
+    SDL_UnlockMutex(pipeline->lock);
+    SDL_WaitThread(update_thread, NULL);  // Widgets are the main thread's again from here
+
+    free(pipeline->events);
+    pipeline->events = NULL;
+    pipeline->head = pipeline->count = pipeline->capacity = 0;
+    SDL_DestroyCond(pipeline->wake);
+    SDL_DestroyMutex(pipeline->lock);
+    pipeline->wake = NULL;
+    pipeline->lock = NULL;
+    free_frame_snapshots_();
+    defer_texture_uploads_(false);
+    free_retired_textures_();
+    return true;
+}
+
+// ______________CLASSIC MODE_____________
+
+static inline void app_run_classic_(Parent* parent) {
     SDL_Event event;
     int running = 1;
     while (running) {
-        while (SDL_PollEvent(&event)) {
-            if (event.type == SDL_QUIT) {
+        // Re-run dirty layouts, then refresh cached container transforms (no-op unless something moved)
+        Uint64 phase_start = startup_mark_();
+        update_all_registered_layouts();
+        update_parent_transform(parent);
+        update_all_registered_container_transforms();
+        startup_add_(STARTUP_FIRST_LAYOUT, phase_start);
+
+        int wake_ms = run_app_due_work_();
+
+        // Nothing to draw: sleep until input or the next timer or animation frame
+        // (finished background jobs wake the loop with their own event)
+        int timeout_ms = is_frame_dirty_() ? 0 : wake_ms;
+        bool have_event = wait_for_event_(&event, timeout_ms);
+        for (; have_event; have_event = SDL_PollEvent(&event)) {
+            if (!handle_app_event_(event, update_window_metrics(parent, event))) {
                 running = 0;
+                continue;
+            }
+            // Global text input management after all updates
+            if (is_any_text_widget_active()) {
+                SDL_StartTextInput();
             } else {
-                // New: Handle theme switching on key press
-                if (event.type == SDL_KEYDOWN) {
-                    switch (event.key.keysym.sym) {
-                        case SDLK_l:  // 'L' for Light
-                            set_theme(&THEME_LIGHT);
-                            printf("Switched to Light theme\n");
-                            break;
-                        case SDLK_d:  // 'D' for Dark
-                            set_theme(&THEME_DARK);
-                            printf("Switched to Dark theme\n");
-                            break;
-                        case SDLK_h:  // 'H' for Hacker
-                            set_theme(&THEME_HACKER);
-                            printf("Switched to Hacker theme\n");
-                            break;
-                        default:
-                            break;
-                    }
-                }
-
-                update_all_registered_containers(event);
-                update_all_registered_radios(event);
-                update_all_registered_entrys(event);
-                update_all_registered_textboxs(event);
-                update_all_registered_sliders(event);  // Update sliders
-                update_all_registered_buttons(event);
-                update_all_registered_texts(event);
-                update_all_registered_drops(event);
-                update_all_registered_progress_bars(event);
-                update_all_registered_images(event);
-
-                // Global text input management after all updates
-                if (is_any_text_widget_active()) {
-                    SDL_StartTextInput();
-                } else {
-                    SDL_StopTextInput();
-                }
+                SDL_StopTextInput();
             }
         }
 
+        run_app_posted_work_();
+
+        if (!is_frame_dirty_() || !running) continue;  // Nothing changed on screen
+
+        phase_start = startup_mark_();
+        layout_app_frame_();
+        startup_add_(STARTUP_FIRST_LAYOUT, phase_start);
+
+        phase_start = startup_mark_();
+        begin_damage_frame_(parent->base.sdl_renderer);  // Clips the frame to the dirty region
         clear_screen_(&parent->base, parent->color);  /// to change bg color use app.window->color = COLOR; 	
-        render_all_registered_containers();
-        render_all_registered_drops();
-        render_all_registered_radios();
-        render_all_registered_entrys();
-        render_all_registered_textboxs();
-        render_all_registered_sliders();  // Render sliders
-        render_all_registered_buttons();
-		render_all_registered_texts();
-		render_all_registered_progress_bars();
-		render_all_registered_images();
+        record_frame_draw_lists_();  // Per-container draw lists, recorded on the job workers
+        submit_frame_slots_();  // Container by container, each over the ones before it
+        startup_add_(STARTUP_FIRST_RENDER, phase_start);
+
+        phase_start = startup_mark_();
+        end_damage_frame_(parent->base.sdl_renderer);
         present_(&parent->base);
+        if (!startup_report_.complete) {
+            startup_add_(STARTUP_FIRST_PRESENT, phase_start);
+            startup_complete_();
+            LOG_INFO("First frame presented %.1f ms after startup", startup_report_.total_ms);
+        }
+
+        enforce_texture_budget_();  // Evict textures that have not been drawn for a while if over budget
+    }
+}
+
+void app_run_(Parent *parent) {
+    startup_widgets_end_();
+    if (!pipelined_rendering_ || !app_run_pipelined_(parent)) {
+        app_run_classic_(parent);
     }
 
 	// free stuffs
+	shutdown_workers_();  // Waits for running jobs; their completions are dropped
+	close_all_ui_feeds_();  // Before the timers that drain them
+	free_tweens_();
+	free_timers_();
 	free_all_registered_images();
+	free_all_registered_tiled_images();
+	free_all_registered_animated_images();
 	free_all_registered_buttons();
 	free_all_registered_drops();
 	free_all_registered_radios();
@@ -104,5 +444,12 @@ void app_run_(Parent *parent) {
 	free_all_registered_progress_bars();
 	free_all_registered_sliders();
 	free_all_registered_textboxes();
+	free_all_registered_layouts();
+	shutdown_image_loader_();  // Settle in-flight decodes before their entries are freed
+	shutdown_jobs_();
+	free_frame_draw_lists_();
+	free_widget_updates_();  // Dropped unapplied; no thread is left that could post more
+	free_texture_cache_();  // Before the renderer goes away
+	free_damage_target_();
     destroy_parent(parent);
 }
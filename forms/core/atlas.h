@@ -0,0 +1,315 @@
+/**
+ * @file atlas.h
+ * @brief Packs small images into shared atlas pages and batches their draws.
+ *
+ * Images no larger than ATLAS_MAX_IMAGE_SIZE on either side are copied into
+ * ATLAS_PAGE_SIZE square textures with a skyline (bottom-left) packer, so many
+ * icons share one texture. Draws from the same page under the same clip rect are
+ * queued with atlas_batch_draw_ and submitted as a single SDL_RenderGeometry call
+ * by flush_atlas_batch_. Each page counts the images it holds: single slots are
+ * not reused when an image is released, but a page is destroyed as soon as its
+ * last image is (release_atlas_slot_), so its room goes to new pages. The rest are
+ * freed with the texture cache.
+ */
+
+#ifndef ATLAS_H
+#define ATLAS_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "log.h"
+#include "damage.h"  // set_clip_rect_
+
+#define ATLAS_PAGE_SIZE 1024      // Page width and height in pixels
+#define ATLAS_MAX_IMAGE_SIZE 64   // Larger images get their own texture
+#define ATLAS_MAX_PAGES 8
+#define ATLAS_PADDING 1           // Transparent gap between slots (avoids bleeding when filtered)
+
+/**
+ * @brief One segment of the skyline: the packed height over [x, x + w)
+ */
+typedef struct {
+    int x, y, w;
+} SkylineNode;
+
+/**
+ * @brief One atlas texture and its skyline
+ */
+typedef struct {
+    SDL_Renderer* renderer;
+    SDL_Texture* texture;
+    SkylineNode* nodes;
+    int node_count;
+    int node_capacity;
+    int live;           // Packed images not released yet
+} AtlasPage;
+
+static AtlasPage atlas_pages_[ATLAS_MAX_PAGES];
+static int atlas_page_count_ = 0;
+
+// Lowest y at which a w x h rect fits starting at node `index`, or -1
+static inline int skyline_fit_(AtlasPage* page, int index, int w, int h) {
+    int x = page->nodes[index].x;
+    if (x + w > ATLAS_PAGE_SIZE) return -1;
+
+    int y = 0;
+    int remaining = w;
+    for (int i = index; remaining > 0; i++) {
+        if (i >= page->node_count) return -1;
+        if (page->nodes[i].y > y) y = page->nodes[i].y;
+        if (y + h > ATLAS_PAGE_SIZE) return -1;
+        remaining -= page->nodes[i].w;
+    }
+    return y;
+}
+
+static inline bool skyline_insert_node_(AtlasPage* page, int index, SkylineNode node) {
+    if (page->node_count == page->node_capacity) {
+        int capacity = page->node_capacity ? page->node_capacity * 2 : 16;
+        SkylineNode* nodes = (SkylineNode*)realloc(page->nodes, sizeof(SkylineNode) * capacity);
+        if (!nodes) return false;
+        page->nodes = nodes;
+        page->node_capacity = capacity;
+    }
+    memmove(&page->nodes[index + 1], &page->nodes[index], sizeof(SkylineNode) * (page->node_count - index));
+    page->nodes[index] = node;
+    page->node_count++;
+    return true;
+}
+
+/**
+ * @brief Reserves a w x h slot with the bottom-left heuristic (lowest top edge, then leftmost).
+ */
+static inline bool skyline_pack_(AtlasPage* page, int w, int h, SDL_Rect* slot) {
+    int best_index = -1, best_y = ATLAS_PAGE_SIZE, best_x = ATLAS_PAGE_SIZE;
+    for (int i = 0; i < page->node_count; i++) {
+        int y = skyline_fit_(page, i, w, h);
+        if (y >= 0 && (y < best_y || (y == best_y && page->nodes[i].x < best_x))) {
+            best_index = i;
+            best_y = y;
+            best_x = page->nodes[i].x;
+        }
+    }
+    if (best_index < 0) return false;
+
+    SkylineNode raised = {best_x, best_y + h, w};
+    if (!skyline_insert_node_(page, best_index, raised)) return false;
+
+    // Trim or drop the nodes now covered by the raised segment
+    for (int i = best_index + 1; i < page->node_count; i++) {
+        SkylineNode* node = &page->nodes[i];
+        int covered = raised.x + raised.w - node->x;
+        if (covered <= 0) break;
+        if (covered < node->w) {
+            node->x += covered;
+            node->w -= covered;
+            break;
+        }
+        memmove(node, node + 1, sizeof(SkylineNode) * (page->node_count - i - 1));
+        page->node_count--;
+        i--;
+    }
+    // Merge neighbours at the same height
+    for (int i = 0; i + 1 < page->node_count; i++) {
+        if (page->nodes[i].y == page->nodes[i + 1].y) {
+            page->nodes[i].w += page->nodes[i + 1].w;
+            memmove(&page->nodes[i + 1], &page->nodes[i + 2], sizeof(SkylineNode) * (page->node_count - i - 2));
+            page->node_count--;
+            i--;
+        }
+    }
+
+    *slot = (SDL_Rect){best_x, best_y, w, h};
+    return true;
+}
+
+static inline AtlasPage* new_atlas_page_(SDL_Renderer* renderer) {
+    if (atlas_page_count_ >= ATLAS_MAX_PAGES) return NULL;
+
+    SDL_Texture* texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC,
+                                             ATLAS_PAGE_SIZE, ATLAS_PAGE_SIZE);
+    if (!texture) {
+        LOG_WARN("Failed to create atlas page: %s", SDL_GetError());
+        return NULL;
+    }
+    // Static textures start undefined; padding must be transparent
+    void* clear = calloc((size_t)ATLAS_PAGE_SIZE * ATLAS_PAGE_SIZE, 4);
+    if (clear) {
+        SDL_UpdateTexture(texture, NULL, clear, ATLAS_PAGE_SIZE * 4);
+        free(clear);
+    }
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+
+    AtlasPage* page = &atlas_pages_[atlas_page_count_];
+    memset(page, 0, sizeof(*page));
+    page->renderer = renderer;
+    page->texture = texture;
+    if (!skyline_insert_node_(page, 0, (SkylineNode){0, 0, ATLAS_PAGE_SIZE})) {
+        SDL_DestroyTexture(texture);
+        return NULL;
+    }
+    atlas_page_count_++;
+    return page;
+}
+
+/**
+ * @brief Copies a small surface into an atlas page.
+ * @param page_texture Receives the page texture (owned by the atlas)
+ * @param slot Receives the image's rect inside the page
+ * @return false if the surface is too large or no page has room (caller uploads it alone)
+ */
+static inline bool atlas_pack_surface_(SDL_Renderer* renderer, SDL_Surface* surface,
+                                       SDL_Texture** page_texture, SDL_Rect* slot) {
+    if (!renderer || !surface) return false;
+    if (surface->w > ATLAS_MAX_IMAGE_SIZE || surface->h > ATLAS_MAX_IMAGE_SIZE) return false;
+
+    int padded_w = surface->w + ATLAS_PADDING;
+    int padded_h = surface->h + ATLAS_PADDING;
+    AtlasPage* page = NULL;
+    SDL_Rect padded;
+    for (int i = 0; i < atlas_page_count_ && !page; i++) {
+        if (atlas_pages_[i].renderer == renderer && skyline_pack_(&atlas_pages_[i], padded_w, padded_h, &padded)) {
+            page = &atlas_pages_[i];
+        }
+    }
+    if (!page) {
+        page = new_atlas_page_(renderer);
+        if (!page || !skyline_pack_(page, padded_w, padded_h, &padded)) return false;
+    }
+
+    SDL_Surface* pixels = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_ARGB8888, 0);
+    if (!pixels) return false;  // The slot stays reserved; harmless
+    *slot = (SDL_Rect){padded.x, padded.y, surface->w, surface->h};
+    SDL_UpdateTexture(page->texture, slot, pixels->pixels, pixels->pitch);
+    SDL_FreeSurface(pixels);
+
+    page->live++;
+    *page_texture = page->texture;
+    return true;
+}
+
+/**
+ * @brief Gives back one image packed into `page_texture`; the page is destroyed with
+ *        its last image. Call where the image's texture would otherwise be destroyed.
+ */
+static inline void release_atlas_slot_(SDL_Texture* page_texture) {
+    for (int i = 0; i < atlas_page_count_; i++) {
+        AtlasPage* page = &atlas_pages_[i];
+        if (page->texture != page_texture) continue;
+        if (--page->live > 0) return;
+        SDL_DestroyTexture(page->texture);
+        free(page->nodes);
+        atlas_pages_[i] = atlas_pages_[--atlas_page_count_];  // Entries point at textures, not indices
+        memset(&atlas_pages_[atlas_page_count_], 0, sizeof(AtlasPage));
+        return;
+    }
+}
+
+static inline size_t get_atlas_memory_usage(void) {
+    return (size_t)atlas_page_count_ * ATLAS_PAGE_SIZE * ATLAS_PAGE_SIZE * 4;
+}
+
+// -------- Batched draws --------
+
+/**
+ * @brief Quads queued for one page under one clip rect
+ */
+typedef struct {
+    SDL_Renderer* renderer;
+    SDL_Texture* texture;
+    SDL_Rect clip;
+    bool has_clip;
+    SDL_Vertex* vertices;
+    int* indices;
+    int quad_count;
+    int quad_capacity;
+} AtlasBatch;
+
+static AtlasBatch atlas_batch_;
+
+/**
+ * @brief Submits the queued quads as one SDL_RenderGeometry call and clears the batch.
+ */
+static inline void flush_atlas_batch_(void) {
+    AtlasBatch* batch = &atlas_batch_;
+    if (batch->quad_count == 0) return;
+
+    set_clip_rect_(batch->renderer, batch->has_clip ? &batch->clip : NULL);
+    SDL_RenderGeometry(batch->renderer, batch->texture, batch->vertices, batch->quad_count * 4,
+                       batch->indices, batch->quad_count * 6);
+    set_clip_rect_(batch->renderer, NULL);
+    batch->quad_count = 0;
+}
+
+/**
+ * @brief Queues a draw of `src` (inside an atlas page) to `dst`. Consecutive draws from the
+ *        same page and clip are merged; anything else flushes first.
+ * @param clip Physical clip rect, or NULL for none
+ */
+static inline void atlas_batch_draw_(SDL_Renderer* renderer, SDL_Texture* page, const SDL_Rect* src,
+                                     const SDL_Rect* dst, const SDL_Rect* clip) {
+    AtlasBatch* batch = &atlas_batch_;
+    bool same_clip = clip ? (batch->has_clip && SDL_RectEquals(&batch->clip, clip)) : !batch->has_clip;
+    if (batch->quad_count > 0 && (batch->renderer != renderer || batch->texture != page || !same_clip)) {
+        flush_atlas_batch_();
+    }
+    if (batch->quad_count == batch->quad_capacity) {
+        int capacity = batch->quad_capacity ? batch->quad_capacity * 2 : 64;
+        SDL_Vertex* vertices = (SDL_Vertex*)realloc(batch->vertices, sizeof(SDL_Vertex) * 4 * capacity);
+        if (vertices) batch->vertices = vertices;
+        int* indices = (int*)realloc(batch->indices, sizeof(int) * 6 * capacity);
+        if (indices) batch->indices = indices;
+        if (!vertices || !indices) {
+            // Out of memory: draw this one directly
+            set_clip_rect_(renderer, clip);
+            SDL_RenderCopy(renderer, page, src, dst);
+            set_clip_rect_(renderer, NULL);
+            return;
+        }
+        batch->quad_capacity = capacity;
+    }
+    batch->renderer = renderer;
+    batch->texture = page;
+    batch->has_clip = clip != NULL;
+    if (clip) batch->clip = *clip;
+
+    float u0 = (float)src->x / ATLAS_PAGE_SIZE, v0 = (float)src->y / ATLAS_PAGE_SIZE;
+    float u1 = (float)(src->x + src->w) / ATLAS_PAGE_SIZE, v1 = (float)(src->y + src->h) / ATLAS_PAGE_SIZE;
+    float x0 = (float)dst->x, y0 = (float)dst->y;
+    float x1 = (float)(dst->x + dst->w), y1 = (float)(dst->y + dst->h);
+    SDL_Color white = {255, 255, 255, 255};
+
+    SDL_Vertex* v = &batch->vertices[batch->quad_count * 4];
+    v[0] = (SDL_Vertex){{x0, y0}, white, {u0, v0}};
+    v[1] = (SDL_Vertex){{x1, y0}, white, {u1, v0}};
+    v[2] = (SDL_Vertex){{x1, y1}, white, {u1, v1}};
+    v[3] = (SDL_Vertex){{x0, y1}, white, {u0, v1}};
+
+    int base = batch->quad_count * 4;
+    int* index = &batch->indices[batch->quad_count * 6];
+    index[0] = base; index[1] = base + 1; index[2] = base + 2;
+    index[3] = base; index[4] = base + 2; index[5] = base + 3;
+    batch->quad_count++;
+}
+
+/**
+ * @brief Destroys all pages and the batch buffers. Call before the renderer is destroyed.
+ */
+static inline void free_atlas_pages_(void) {
+    atlas_batch_.quad_count = 0;
+    free(atlas_batch_.vertices);
+    free(atlas_batch_.indices);
+    memset(&atlas_batch_, 0, sizeof(atlas_batch_));
+
+    for (int i = 0; i < atlas_page_count_; i++) {
+        if (atlas_pages_[i].texture) SDL_DestroyTexture(atlas_pages_[i].texture);
+        free(atlas_pages_[i].nodes);
+        memset(&atlas_pages_[i], 0, sizeof(AtlasPage));
+    }
+    atlas_page_count_ = 0;
+}
+
+#endif /* ATLAS_H */
@@ -0,0 +1,184 @@
+/**
+ * @file damage.h
+ * @brief Damage tracking: redraw only what changed, and sleep when nothing did.
+ *
+ * Anything that changes on screen marks a physical rect dirty (mark_dirty_rect):
+ * widgets mark their own rect when an event changes their state. The whole window
+ * (mark_all_dirty) is redrawn only after a resize, DPI or theme change, or an expose. app_run_ skips
+ * frames with no damage and waits for the next event or timer instead of spinning.
+ *
+ * Frames are drawn into a persistent target texture. When only part of the window
+ * is dirty, the frame is clipped to the bounding box of the damage: widgets outside
+ * it are culled (is_child_occluded) and the rest are clipped through set_clip_rect_,
+ * so the untouched pixels from earlier frames survive. The target is then copied to
+ * the window and presented. Without render-target support every frame is full.
+ */
+
+#ifndef DAMAGE_H
+#define DAMAGE_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+#include "log.h"
+
+/**
+ * @brief Pending damage and the state of the frame being drawn
+ */
+typedef struct {
+    bool full;               // Whole window is dirty
+    bool any;                // Something is dirty (bounds is valid unless full)
+    SDL_Rect bounds;         // Union of the dirty rects, physical pixels
+    bool clipping;           // This frame is partial; draws are limited to `clip`
+    SDL_Rect clip;
+    SDL_Texture* target;     // Persistent frame (NULL if render targets are unsupported)
+    int target_w, target_h;
+    bool target_failed;      // Don't retry creating the target every frame
+} DamageState;
+
+static DamageState damage_ = {.full = true, .any = true};  // The first frame is always full
+
+/**
+ * @brief Schedules a redraw of the whole window.
+ */
+static inline void mark_all_dirty(void) {
+    damage_.full = true;
+    damage_.any = true;
+}
+
+/**
+ * @brief Schedules a redraw of a physical rect (e.g. one animated widget).
+ */
+static inline void mark_dirty_rect(SDL_Rect rect) {
+    if (rect.w <= 0 || rect.h <= 0) return;
+    if (!damage_.any) damage_.bounds = rect;
+    else if (!damage_.full) SDL_UnionRect(&damage_.bounds, &rect, &damage_.bounds);
+    damage_.any = true;
+}
+
+static inline bool is_frame_dirty_(void) {
+    return damage_.any;
+}
+
+/**
+ * @brief Checks whether a physical rect is inside the region redrawn this frame.
+ */
+static inline bool is_in_damage_(SDL_Rect rect) {
+    if (!damage_.clipping) return true;
+    if (rect.w <= 0) rect.w = 1;
+    if (rect.h <= 0) rect.h = 1;
+    return SDL_HasIntersection(&rect, &damage_.clip);
+}
+
+/**
+ * @brief SDL_RenderSetClipRect limited to this frame's damage. Use it for all widget clipping.
+ * @param rect Physical clip rect, or NULL for no widget clip
+ */
+static inline void set_clip_rect_(SDL_Renderer* renderer, const SDL_Rect* rect) {
+    if (!damage_.clipping) {
+        SDL_RenderSetClipRect(renderer, rect);
+        return;
+    }
+    SDL_Rect clip;
+    if (!rect) {
+        clip = damage_.clip;
+    } else if (!SDL_IntersectRect(rect, &damage_.clip, &clip)) {
+        clip = (SDL_Rect){-1, -1, 1, 1};  // Nothing of it is dirty; an empty rect would disable clipping
+    }
+    SDL_RenderSetClipRect(renderer, &clip);
+}
+
+/**
+ * @brief Fills the part of the frame being redrawn (SDL_RenderClear ignores the clip rect).
+ */
+static inline void clear_damage_(SDL_Renderer* renderer, Uint8 r, Uint8 g, Uint8 b, Uint8 a) {
+    SDL_SetRenderDrawColor(renderer, r, g, b, a);
+    if (damage_.clipping) {
+        SDL_BlendMode blend;
+        SDL_GetRenderDrawBlendMode(renderer, &blend);
+        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);  // Replace, like a clear
+        SDL_RenderFillRect(renderer, &damage_.clip);
+        SDL_SetRenderDrawBlendMode(renderer, blend);
+    } else {
+        SDL_RenderClear(renderer);
+    }
+}
+
+// Creates or resizes the persistent frame; false if rendering goes straight to the window
+static inline bool ensure_damage_target_(SDL_Renderer* renderer, int w, int h) {
+    if (damage_.target && damage_.target_w == w && damage_.target_h == h) return true;
+    if (damage_.target_failed || !SDL_RenderTargetSupported(renderer)) return false;
+
+    if (damage_.target) SDL_DestroyTexture(damage_.target);
+    damage_.target = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, w, h);
+    if (!damage_.target) {
+        LOG_WARN("Partial redraw disabled, render target unavailable: %s", SDL_GetError());
+        damage_.target_failed = true;
+        return false;
+    }
+    damage_.target_w = w;
+    damage_.target_h = h;
+    damage_.full = true;  // New target has no earlier frame to keep
+    return true;
+}
+
+/**
+ * @brief Starts drawing a frame: binds the persistent target and sets up the damage clip.
+ */
+static inline void begin_damage_frame_(SDL_Renderer* renderer) {
+    int w = 0, h = 0;
+    SDL_GetRendererOutputSize(renderer, &w, &h);
+    bool have_target = ensure_damage_target_(renderer, w, h);
+    if (have_target) SDL_SetRenderTarget(renderer, damage_.target);
+
+    SDL_Rect window = {0, 0, w, h};
+    damage_.clipping = have_target && !damage_.full &&
+                       SDL_IntersectRect(&damage_.bounds, &window, &damage_.clip);
+    damage_.full = false;
+    damage_.any = false;  // Anything marked while drawing goes to the next frame
+    set_clip_rect_(renderer, NULL);
+}
+
+/**
+ * @brief Starts a frame that is drawn whole on another thread (pipelined mode, see
+ *        snapshot.h): takes the pending damage without touching a renderer.
+ */
+static inline void begin_full_frame_(void) {
+    damage_.clipping = false;
+    damage_.full = false;
+    damage_.any = false;  // Anything marked while recording goes to the next frame
+}
+
+/**
+ * @brief Finishes a frame: copies the persistent target to the window.
+ *        Call right before presenting.
+ */
+static inline void end_damage_frame_(SDL_Renderer* renderer) {
+    damage_.clipping = false;
+    SDL_RenderSetClipRect(renderer, NULL);
+    if (damage_.target) {
+        SDL_SetRenderTarget(renderer, NULL);
+        SDL_RenderCopy(renderer, damage_.target, NULL, NULL);
+    }
+}
+
+/**
+ * @brief Waits for the next event.
+ * @param timeout_ms 0 to poll, < 0 to wait indefinitely
+ * @return true if an event was stored in `event`
+ */
+static inline bool wait_for_event_(SDL_Event* event, int timeout_ms) {
+    if (timeout_ms == 0) return SDL_PollEvent(event);
+    if (timeout_ms < 0) return SDL_WaitEvent(event);
+    return SDL_WaitEventTimeout(event, timeout_ms);
+}
+
+// Frees the persistent frame. Call before the renderer is destroyed.
+static inline void free_damage_target_(void) {
+    if (damage_.target) SDL_DestroyTexture(damage_.target);
+    damage_.target = NULL;
+    damage_.target_w = damage_.target_h = 0;
+    mark_all_dirty();
+}
+
+#endif /* DAMAGE_H */
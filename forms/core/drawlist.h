@@ -0,0 +1,455 @@
+/**
+ * @file drawlist.h
+ * @brief Recorded draw commands, built on any thread and submitted on the main thread.
+ *
+ * A DrawList is a flat array of commands (clip, filled spans, text, textures) plus
+ * the pools they point into. The record_* functions mirror the draw_* ones in graphics.h but
+ * only compute: shapes are tessellated into horizontal spans (one SDL_Rect per row
+ * run instead of one point per pixel), and text is kept as a string to be
+ * rasterized at submit time, since SDL_ttf and SDL_Renderer are main-thread only.
+ * Recording touches nothing but the list, so independent lists can be built in
+ * parallel (see frame.h) and submitted afterwards with submit_draw_list_.
+ * Pipelined frames (snapshot.h) turn their text into SURFACE commands before they
+ * reach the render thread.
+ *
+ * Lists keep their capacity across clear_draw_list_, so a steady frame allocates nothing.
+ */
+
+#ifndef DRAWLIST_H
+#define DRAWLIST_H
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "color.h"
+#include "damage.h"    // set_clip_rect_
+#include "graphics.h"  // open_font_, draw_text_from_font_
+#include "log.h"
+
+typedef enum {
+    DRAW_CMD_CLIP,   // set_clip_rect_(clip), or no clip
+    DRAW_CMD_SPANS,  // Filled rects spans[first .. first + count) in one color
+    DRAW_CMD_TEXT,   // Text rasterized at submit time
+    DRAW_CMD_SURFACE, // Pixels rasterized ahead of time (baked text, see snapshot.h), copied to rect
+    DRAW_CMD_TEXTURE  // A region of an existing texture copied to rect (image widgets)
+} DrawCmdKind;
+
+typedef struct {
+    DrawCmdKind kind;
+    SDL_Renderer* renderer;
+    Color color;
+    bool has_clip;          // CLIP: false resets clipping
+    SDL_Rect rect;          // CLIP: clip rect; TEXT: box to center in (center) or origin (x, y); SURFACE, TEXTURE: destination
+    int first, count;       // SPANS: range in spans; TEXT: offset of the string in chars
+    const char* font_file;  // TEXT: NULL = FONT_FILE (what draw_text_ uses)
+    int font_size;          // TEXT
+    TextAlign align;        // TEXT: alignment around rect.x, as draw_text_from_font_
+    bool center;            // TEXT: centered in rect instead of placed at (rect.x, rect.y)
+    SDL_Surface* surface;   // SURFACE: not owned by the list
+    SDL_Texture* texture;   // TEXTURE: drawn when entry is NULL; not owned by the list
+    TextureCacheEntry* entry;  // TEXTURE: its texture and atlas slot are looked up at submit time; atlas entries are batched
+    SDL_Rect src;           // TEXTURE: region of the texture (has_src); with an entry, in the image's own pixels
+    bool has_src;           // TEXTURE: false copies the whole texture (or image)
+} DrawCmd;
+
+typedef struct {
+    DrawCmd* cmds;
+    int cmd_count, cmd_capacity;
+    SDL_Rect* spans;
+    int span_count, span_capacity;
+    char* chars;
+    int char_count, char_capacity;
+    bool failed;  // An allocation failed; the list is incomplete (submit still draws what it has)
+} DrawList;
+
+// Grows a pool to hold `extra` more items; false (and list->failed) if out of memory
+static inline bool reserve_draw_pool_(DrawList* list, void** items, int* capacity, int count, int extra, size_t size) {
+    if (count + extra <= *capacity) return true;
+    int new_capacity = *capacity ? *capacity : 64;
+    while (new_capacity < count + extra) new_capacity *= 2;
+    void* grown = realloc(*items, size * new_capacity);
+    if (!grown) {
+        list->failed = true;
+        return false;
+    }
+    *items = grown;
+    *capacity = new_capacity;
+    return true;
+}
+
+static inline DrawCmd* push_draw_cmd_(DrawList* list, DrawCmdKind kind, Base* base, Color color) {
+    if (!reserve_draw_pool_(list, (void**)&list->cmds, &list->cmd_capacity, list->cmd_count, 1, sizeof(DrawCmd))) {
+        return NULL;
+    }
+    DrawCmd* cmd = &list->cmds[list->cmd_count++];
+    memset(cmd, 0, sizeof(DrawCmd));
+    cmd->kind = kind;
+    cmd->renderer = base->sdl_renderer;
+    cmd->color = color;
+    return cmd;
+}
+
+// Appends one span, extending the last SPANS command when the color matches
+static inline void push_span_(DrawList* list, Base* base, Color color, int x, int y, int w, int h) {
+    if (w <= 0 || h <= 0) return;
+    DrawCmd* last = list->cmd_count > 0 ? &list->cmds[list->cmd_count - 1] : NULL;
+    if (!last || last->kind != DRAW_CMD_SPANS || last->renderer != base->sdl_renderer ||
+        memcmp(&last->color, &color, sizeof(Color)) != 0) {
+        last = push_draw_cmd_(list, DRAW_CMD_SPANS, base, color);
+        if (!last) return;
+        last->first = list->span_count;
+    }
+    if (!reserve_draw_pool_(list, (void**)&list->spans, &list->span_capacity, list->span_count, 1, sizeof(SDL_Rect))) {
+        return;
+    }
+    list->spans[list->span_count++] = (SDL_Rect){x, y, w, h};
+    last->count++;
+}
+
+/**
+ * @brief Empties a list, keeping its memory for the next frame.
+ */
+static inline void clear_draw_list_(DrawList* list) {
+    list->cmd_count = 0;
+    list->span_count = 0;
+    list->char_count = 0;
+    list->failed = false;
+}
+
+static inline void free_draw_list_(DrawList* list) {
+    free(list->cmds);
+    free(list->spans);
+    free(list->chars);
+    memset(list, 0, sizeof(DrawList));
+}
+
+/**
+ * @brief Appends a copy of `src` to `dst` (pool offsets are rebased).
+ * @return false if `dst` could not grow (it is marked failed and left as it was)
+ */
+static inline bool append_draw_list_(DrawList* dst, const DrawList* src) {
+    if (!reserve_draw_pool_(dst, (void**)&dst->cmds, &dst->cmd_capacity, dst->cmd_count, src->cmd_count, sizeof(DrawCmd)) ||
+        !reserve_draw_pool_(dst, (void**)&dst->spans, &dst->span_capacity, dst->span_count, src->span_count, sizeof(SDL_Rect)) ||
+        !reserve_draw_pool_(dst, (void**)&dst->chars, &dst->char_capacity, dst->char_count, src->char_count, 1)) {
+        return false;
+    }
+    for (int i = 0; i < src->cmd_count; i++) {
+        DrawCmd cmd = src->cmds[i];
+        if (cmd.kind == DRAW_CMD_SPANS) cmd.first += dst->span_count;
+        else if (cmd.kind == DRAW_CMD_TEXT) cmd.first += dst->char_count;
+        dst->cmds[dst->cmd_count + i] = cmd;
+    }
+    if (src->span_count) memcpy(dst->spans + dst->span_count, src->spans, sizeof(SDL_Rect) * src->span_count);
+    if (src->char_count) memcpy(dst->chars + dst->char_count, src->chars, (size_t)src->char_count);
+    dst->cmd_count += src->cmd_count;
+    dst->span_count += src->span_count;
+    dst->char_count += src->char_count;
+    if (src->failed) dst->failed = true;
+    return true;
+}
+
+// ______________RECORD FUNCTIONS_____________
+
+/**
+ * @brief Records set_clip_rect_(rect); NULL resets clipping.
+ */
+static inline void record_clip_(DrawList* list, Base* base, const SDL_Rect* rect) {
+    DrawCmd* cmd = push_draw_cmd_(list, DRAW_CMD_CLIP, base, (Color){0, 0, 0, 0});
+    if (!cmd) return;
+    cmd->has_clip = rect != NULL;
+    if (rect) cmd->rect = *rect;
+}
+
+/**
+ * @brief Records a filled rectangle (draw_rect_).
+ */
+static inline void record_rect_(DrawList* list, Base* base, int x, int y, int w, int h, Color color) {
+    push_span_(list, base, color, x, y, w, h);
+}
+
+// Largest k >= 0 with k * k <= n (n >= 0)
+static inline int isqrt_(int n) {
+    int k = (int)sqrt((double)n);
+    while (k > 0 && k * k > n) k--;
+    while ((k + 1) * (k + 1) <= n) k++;
+    return k;
+}
+
+/**
+ * @brief Records a filled circle covering the same pixels as draw_circle_.
+ */
+static inline void record_circle_(DrawList* list, Base* base, int x, int y, int radius, Color color) {
+    if (radius < 0) return;
+    for (int h = -radius; h <= radius; h++) {
+        int half = isqrt_(radius * radius - h * h);  // Widest |w| with w*w + h*h <= r*r
+        push_span_(list, base, color, x - half, y + h, 2 * half + 1, 1);
+    }
+}
+
+/**
+ * @brief Records a filled rounded rectangle covering the same pixels as draw_rounded_rect_:
+ *        one rect for the straight middle and one span per corner row.
+ */
+static inline void record_rounded_rect_(DrawList* list, Base* base, int x, int y, int w, int h, float roundness, Color color) {
+    if (w <= 0 || h <= 0) return;
+
+    float min_dim = (w < h) ? w : h;
+    int radius = roundness <= 0.0f ? 0 : (int)(roundness * min_dim / 2.0f);
+    if (radius <= 0) {
+        push_span_(list, base, color, x, y, w, h);
+        return;
+    }
+    // Clamp radius to avoid over-rounding
+    if (2 * radius > w) radius = w / 2;
+    if (2 * radius > h) radius = h / 2;
+
+    for (int dy = 0; dy < radius; dy++) {
+        // Corner centers sit at dx = radius and dx = w - radius, dy = radius
+        int k = isqrt_(radius * radius - (dy - radius) * (dy - radius));
+        int right = w - radius + k;
+        push_span_(list, base, color, x + radius - k, y + dy, right - (radius - k) + 1, 1);
+    }
+    push_span_(list, base, color, x, y + radius, w, h - 2 * radius);
+    for (int dy = h - radius; dy < h; dy++) {
+        // Bottom centers are one row higher (dy = h - radius), so the widest row reaches both sides
+        int k = isqrt_(radius * radius - (dy - (h - radius)) * (dy - (h - radius)));
+        int right = w - radius + k;
+        if (right > w - 1) right = w - 1;
+        push_span_(list, base, color, x + radius - k, y + dy, right - (radius - k) + 1, 1);
+    }
+}
+
+/**
+ * @brief Records a filled triangle covering the same pixels as draw_triangle_.
+ */
+static inline void record_triangle_(DrawList* list, Base* base, int x1, int y1, int x2, int y2, int x3, int y3, Color color) {
+    // Sort vertices by y-coordinate (v1 at top, v3 at bottom)
+    int temp_x, temp_y;
+    if (y1 > y2) {
+        temp_x = x1; temp_y = y1;
+        x1 = x2; y1 = y2;
+        x2 = temp_x; y2 = temp_y;
+    }
+    if (y2 > y3) {
+        temp_x = x2; temp_y = y2;
+        x2 = x3; y2 = y3;
+        x3 = temp_x; y3 = temp_y;
+    }
+    if (y1 > y2) {
+        temp_x = x1; temp_y = y1;
+        x1 = x2; y1 = y2;
+        x2 = temp_x; y2 = temp_y;
+    }
+    if (y1 == y3) return;
+
+    float dx12 = (y2 != y1) ? (float)(x2 - x1) / (y2 - y1) : 0;
+    float dx13 = (y3 != y1) ? (float)(x3 - x1) / (y3 - y1) : 0;
+    float dx23 = (y3 != y2) ? (float)(x3 - x2) / (y3 - y2) : 0;
+
+    for (int y = y1; y <= y3; y++) {
+        int x_start = x1 + (int)((y - y1) * dx13);
+        int x_end;
+        if (y <= y2) {
+            x_end = (y < y2) ? x1 + (int)((y - y1) * dx12) : x2 + (int)((y - y2) * dx23);
+        } else {
+            x_end = x2 + (int)((y - y2) * dx23);
+        }
+        if (x_start > x_end) {
+            int temp = x_start;
+            x_start = x_end;
+            x_end = temp;
+        }
+        push_span_(list, base, color, x_start, y, x_end - x_start + 1, 1);  // Lines include both ends
+    }
+}
+
+static inline DrawCmd* record_text_cmd_(DrawList* list, Base* base, const char* font_file, int font_size,
+                                        const char* text, Color color) {
+    if (!text) return NULL;
+    int len = (int)strlen(text) + 1;
+    if (!reserve_draw_pool_(list, (void**)&list->chars, &list->char_capacity, list->char_count, len, 1)) return NULL;
+    DrawCmd* cmd = push_draw_cmd_(list, DRAW_CMD_TEXT, base, color);
+    if (!cmd) return NULL;
+    cmd->first = list->char_count;
+    memcpy(list->chars + list->char_count, text, (size_t)len);
+    list->char_count += len;
+    cmd->font_file = font_file;
+    cmd->font_size = font_size;
+    return cmd;
+}
+
+/**
+ * @brief Records text drawn like draw_text_from_font_ with a font opened at submit time.
+ * @param font_file NULL for FONT_FILE, the font draw_text_ uses
+ */
+static inline void record_text_(DrawList* list, Base* base, const char* font_file, int font_size,
+                                const char* text, int x, int y, Color color, TextAlign align) {
+    DrawCmd* cmd = record_text_cmd_(list, base, font_file, font_size, text, color);
+    if (!cmd) return;
+    cmd->rect = (SDL_Rect){x, y, 0, 0};
+    cmd->align = align;
+}
+
+/**
+ * @brief Records text centered in `box` (measured at submit time, when the font is open).
+ */
+static inline void record_text_centered_(DrawList* list, Base* base, const char* font_file, int font_size,
+                                         const char* text, SDL_Rect box, Color color) {
+    DrawCmd* cmd = record_text_cmd_(list, base, font_file, font_size, text, color);
+    if (!cmd) return;
+    cmd->rect = box;
+    cmd->center = true;
+}
+
+/**
+ * @brief Records a texture region copied to `dst`, like draw_image_region_ (a `dst` of
+ *        size 0 takes the region's size).
+ * @param entry Cache entry to draw (texture is then unused), or NULL to draw `texture` as is.
+ *        The entry's texture may not exist yet when uploads are deferred (snapshot.h).
+ * @param src Region of the texture, or of the entry's image; NULL for all of it
+ */
+static inline void record_texture_(DrawList* list, Base* base, SDL_Texture* texture, TextureCacheEntry* entry,
+                                   const SDL_Rect* src, SDL_Rect dst) {
+    if (!texture && !entry) return;
+    DrawCmd* cmd = push_draw_cmd_(list, DRAW_CMD_TEXTURE, base, (Color){0, 0, 0, 0});
+    if (!cmd) return;
+    cmd->texture = texture;
+    cmd->entry = entry;
+    cmd->rect = dst;
+    cmd->has_src = src != NULL;
+    if (src) cmd->src = *src;
+}
+
+/**
+ * @brief Records pixels copied to `dst` (size 0 takes the surface's). The surface must
+ *        outlive the list; pipelined frames draw it on the render thread.
+ */
+static inline void record_surface_(DrawList* list, Base* base, SDL_Surface* surface, SDL_Rect dst) {
+    if (!surface) return;
+    DrawCmd* cmd = push_draw_cmd_(list, DRAW_CMD_SURFACE, base, (Color){0, 0, 0, 0});
+    if (!cmd) return;
+    cmd->surface = surface;
+    if (dst.w <= 0 || dst.h <= 0) {
+        dst.w = surface->w;
+        dst.h = surface->h;
+    }
+    cmd->rect = dst;
+}
+
+// ______________SUBMIT_____________
+
+// Texture a TEXTURE command draws, the region of it (an entry's is moved into its atlas
+// slot) and the destination with a size of 0 resolved. NULL if there is nothing to draw.
+static inline SDL_Texture* texture_cmd_target_(const DrawCmd* cmd, SDL_Rect* src, SDL_Rect* dst) {
+    SDL_Texture* texture = cmd->entry ? cmd->entry->texture : cmd->texture;
+    if (!texture) return NULL;
+    if (cmd->entry) {
+        *src = cmd->entry->src_rect;
+        if (cmd->has_src) *src = (SDL_Rect){src->x + cmd->src.x, src->y + cmd->src.y, cmd->src.w, cmd->src.h};
+    } else if (cmd->has_src) {
+        *src = cmd->src;
+    } else {
+        *src = (SDL_Rect){0, 0, 0, 0};
+        SDL_QueryTexture(texture, NULL, NULL, &src->w, &src->h);
+    }
+    *dst = cmd->rect;
+    if (dst->w <= 0 || dst->h <= 0) {
+        dst->w = src->w;
+        dst->h = src->h;
+    }
+    return texture;
+}
+
+// Draws queued atlas quads beneath what comes next, then restores the list's clip
+static inline void flush_draw_list_batch_(const DrawCmd* clip) {
+    if (atlas_batch_.quad_count == 0) return;
+    flush_atlas_batch_();
+    if (clip) set_clip_rect_(clip->renderer, clip->has_clip ? &clip->rect : NULL);
+}
+
+static DrawList immediate_draw_list_;  // Scratch list behind the immediate render_* functions
+
+/**
+ * @brief Replays a list on its renderers. Main thread only.
+ */
+static inline void submit_draw_list_(const DrawList* list) {
+    const DrawCmd* clip = NULL;  // Last CLIP command; atlas batches carry their own clip
+    for (int i = 0; i < list->cmd_count; i++) {
+        const DrawCmd* cmd = &list->cmds[i];
+        bool batched = cmd->kind == DRAW_CMD_TEXTURE && cmd->entry && cmd->entry->in_atlas;
+        if (!batched && cmd->kind != DRAW_CMD_CLIP) flush_draw_list_batch_(clip);
+        switch (cmd->kind) {
+            case DRAW_CMD_CLIP:
+                set_clip_rect_(cmd->renderer, cmd->has_clip ? &cmd->rect : NULL);
+                clip = cmd;
+                break;
+            case DRAW_CMD_SPANS:
+                SDL_SetRenderDrawColor(cmd->renderer, cmd->color.r, cmd->color.g, cmd->color.b, cmd->color.a);
+                SDL_RenderFillRects(cmd->renderer, &list->spans[cmd->first], cmd->count);
+                break;
+            case DRAW_CMD_TEXT: {
+                const char* text = list->chars + cmd->first;
+                const char* font_file = cmd->font_file ? cmd->font_file : FONT_FILE;
+                TTF_Font* font = open_font_(font_file, cmd->font_size);
+                if (!font) {
+                    LOG_ERROR("Failed to load font '%s': %s", font_file, TTF_GetError());
+                    break;
+                }
+                Base base = {0};
+                base.sdl_renderer = cmd->renderer;
+                if (cmd->center) {
+                    int text_w, text_h;
+                    TTF_SizeText(font, text, &text_w, &text_h);
+                    draw_text_from_font_(&base, font, text, cmd->rect.x + (cmd->rect.w - text_w) / 2,
+                                         cmd->rect.y + (cmd->rect.h - text_h) / 2, cmd->color, ALIGN_LEFT);
+                } else {
+                    draw_text_from_font_(&base, font, text, cmd->rect.x, cmd->rect.y, cmd->color, cmd->align);
+                }
+                TTF_CloseFont(font);
+                break;
+            }
+            case DRAW_CMD_SURFACE: {
+                SDL_Texture* texture = SDL_CreateTextureFromSurface(cmd->renderer, cmd->surface);
+                if (!texture) {
+                    LOG_ERROR("Failed to create texture from surface: %s", SDL_GetError());
+                    break;
+                }
+                SDL_RenderCopy(cmd->renderer, texture, NULL, &cmd->rect);
+                SDL_DestroyTexture(texture);
+                break;
+            }
+            case DRAW_CMD_TEXTURE: {
+                SDL_Rect src, dst;
+                SDL_Texture* texture = texture_cmd_target_(cmd, &src, &dst);
+                if (!texture) break;
+                if (batched) {
+                    // Consecutive atlas images under the same clip go out as one geometry call
+                    atlas_batch_draw_(cmd->renderer, texture, &src, &dst, clip && clip->has_clip ? &clip->rect : NULL);
+                } else {
+                    SDL_RenderCopy(cmd->renderer, texture, &src, &dst);
+                }
+                break;
+            }
+        }
+    }
+    flush_draw_list_batch_(clip);
+}
+
+/**
+ * @brief Scratch list for drawing one widget right away (record, then end_immediate_draw_).
+ *        Main thread only.
+ */
+static inline DrawList* begin_immediate_draw_(void) {
+    clear_draw_list_(&immediate_draw_list_);
+    return &immediate_draw_list_;
+}
+
+static inline void end_immediate_draw_(void) {
+    submit_draw_list_(&immediate_draw_list_);
+}
+
+#endif /* DRAWLIST_H */
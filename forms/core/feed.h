@@ -0,0 +1,264 @@
+/**
+ * @file feed.h
+ * @brief Keyed widget updates from another process over a shared-memory feed.
+ *
+ * open_ui_feed creates (or takes over) the shared-memory ring described in
+ * feed_writer.h, which a producer process fills with post_feed_int/_text/_point.
+ * Keys are bound to observables (bind_feed_int, bind_feed_text), which widgets bind
+ * to as usual (bind_progress_bar, bind_text, ...), or to a callback for series
+ * points (on_feed_points). A repeating timer drains the ring once per frame on the
+ * UI thread: it reads the write index, walks the new records and publishes the read
+ * index, with no system calls. Only the newest int or text per key is applied, like
+ * the in-process update queue (updates.h); every point is delivered, in order.
+ *
+ * Records left over from a previous run of the app are skipped when it opens the
+ * feed, and a producer that is already attached keeps posting.
+ */
+
+#ifndef FEED_H
+#define FEED_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "feed_writer.h"
+#include "log.h"
+#include "observable.h"
+#include "timers.h"
+
+#define MAX_UI_FEEDS 4
+#define MAX_FEED_BINDINGS 64  // Per feed
+#define FEED_POLL_MS 16       // Drain interval: one frame at 60 Hz
+
+/**
+ * @brief Called for every series point posted under a key, in posting order
+ */
+typedef void (*FeedPointFn)(void* userdata, double x, double y);
+
+typedef struct {
+    FeedKind kind;
+    uint32_t key_hash;
+    char key[FEED_KEY_MAX];
+    Observable* cell;          // FEED_INT, FEED_TEXT
+    FeedPointFn on_point;      // FEED_POINT
+    void* userdata;
+    bool pending;              // A value arrived during this drain
+    int pending_int;
+    char pending_text[FEED_TEXT_MAX];
+} FeedBinding;
+
+/**
+ * @brief The app's side of a feed
+ */
+typedef struct {
+    char* name;
+    FeedHeader* header;
+    FeedRecord* records;
+    FeedBinding bindings[MAX_FEED_BINDINGS];
+    int binding_count;
+    TimerId timer;
+    uint32_t dropped;          // Drops already reported
+} UiFeed;
+
+static UiFeed* ui_feeds_[MAX_UI_FEEDS];
+static int ui_feeds_count_ = 0;
+
+static inline int drain_ui_feed(UiFeed* feed);
+
+static inline void on_feed_poll_(void* userdata) {
+    drain_ui_feed((UiFeed*)userdata);
+}
+
+/**
+ * @brief Creates the feed `name` ("/something") or takes over the existing one, and
+ *        starts draining it every FEED_POLL_MS. UI thread only.
+ * @return NULL on error (shared memory unavailable, MAX_UI_FEEDS open)
+ */
+static inline UiFeed* open_ui_feed(const char* name) {
+    if (!name) return NULL;
+    if (ui_feeds_count_ >= MAX_UI_FEEDS) {
+        LOG_ERROR("Feed '%s' not opened: all %d feeds are in use", name, MAX_UI_FEEDS);
+        return NULL;
+    }
+    FeedHeader* header = map_feed_(name, true);
+    if (!header) {
+        LOG_ERROR("Failed to map feed '%s'", name);
+        return NULL;
+    }
+    UiFeed* feed = (UiFeed*)calloc(1, sizeof(UiFeed));
+    if (feed) feed->name = strdup(name);
+    if (!feed || !feed->name) {
+        LOG_ERROR("Failed to allocate feed '%s'", name);
+        free(feed);
+        unmap_feed_(header);
+        return NULL;
+    }
+
+    if (is_feed_header_valid_(header)) {
+        // Taken over from an earlier run: drop its backlog, keep the attached writer
+        unsigned write = atomic_load_explicit(&header->write_index, memory_order_acquire);
+        atomic_store_explicit(&header->read_index, write, memory_order_release);
+        feed->dropped = atomic_load_explicit(&header->dropped, memory_order_relaxed);
+    } else {
+        memset(header, 0, sizeof(FeedHeader));
+        header->version = FEED_VERSION;
+        header->capacity = FEED_CAPACITY;
+        header->record_size = sizeof(FeedRecord);
+        atomic_thread_fence(memory_order_release);
+        memcpy(header->magic, FEED_MAGIC, 4);  // Writers attach from here on
+    }
+    atomic_store_explicit(&header->reader_open, 1, memory_order_release);
+
+    feed->header = header;
+    feed->records = (FeedRecord*)(header + 1);
+    feed->timer = add_timer(FEED_POLL_MS, FEED_POLL_MS, on_feed_poll_, feed);
+    if (!feed->timer) {
+        LOG_WARN("Feed '%s' has no poll timer; call drain_ui_feed yourself", name);
+    }
+    ui_feeds_[ui_feeds_count_++] = feed;
+    LOG_DEBUG("Opened feed '%s'", name);
+    return feed;
+}
+
+static inline FeedBinding* add_feed_binding_(UiFeed* feed, FeedKind kind, const char* key) {
+    if (!feed || !key) return NULL;
+    if (feed->binding_count >= MAX_FEED_BINDINGS) {
+        LOG_ERROR("Feed key '%s' not bound: all %d bindings are in use", key, MAX_FEED_BINDINGS);
+        return NULL;
+    }
+    if (strlen(key) >= FEED_KEY_MAX) {
+        LOG_ERROR("Feed key '%s' is longer than %d bytes", key, FEED_KEY_MAX - 1);
+        return NULL;
+    }
+    FeedBinding* binding = &feed->bindings[feed->binding_count++];
+    memset(binding, 0, sizeof(FeedBinding));
+    binding->kind = kind;
+    binding->key_hash = feed_key_hash_(key);
+    strcpy(binding->key, key);
+    return binding;
+}
+
+/**
+ * @brief Sets `cell` (an int observable) to every int posted under `key`
+ */
+static inline bool bind_feed_int(UiFeed* feed, const char* key, Observable* cell) {
+    if (!cell || cell->kind != OBSERVABLE_INT) return false;
+    FeedBinding* binding = add_feed_binding_(feed, FEED_INT, key);
+    if (!binding) return false;
+    binding->cell = cell;
+    return true;
+}
+
+/**
+ * @brief Sets `cell` (a text observable) to every text posted under `key`
+ */
+static inline bool bind_feed_text(UiFeed* feed, const char* key, Observable* cell) {
+    if (!cell || cell->kind != OBSERVABLE_TEXT) return false;
+    FeedBinding* binding = add_feed_binding_(feed, FEED_TEXT, key);
+    if (!binding) return false;
+    binding->cell = cell;
+    return true;
+}
+
+/**
+ * @brief Calls fn(userdata, x, y) for every point posted under `key`
+ */
+static inline bool on_feed_points(UiFeed* feed, const char* key, FeedPointFn fn, void* userdata) {
+    if (!fn) return false;
+    FeedBinding* binding = add_feed_binding_(feed, FEED_POINT, key);
+    if (!binding) return false;
+    binding->on_point = fn;
+    binding->userdata = userdata;
+    return true;
+}
+
+// Hands one record to every binding of its key and kind
+static inline void route_feed_record_(UiFeed* feed, const FeedRecord* record) {
+    for (int i = 0; i < feed->binding_count; i++) {
+        FeedBinding* binding = &feed->bindings[i];
+        if (binding->key_hash != record->key_hash || (uint32_t)binding->kind != record->kind ||
+            strncmp(binding->key, record->key, FEED_KEY_MAX) != 0) {
+            continue;
+        }
+        switch (binding->kind) {
+            case FEED_INT:
+                binding->pending_int = record->value.i;
+                break;
+            case FEED_TEXT:
+                memcpy(binding->pending_text, record->value.text, FEED_TEXT_MAX);
+                binding->pending_text[FEED_TEXT_MAX - 1] = '\0';  // The writer is not trusted
+                break;
+            case FEED_POINT:
+                binding->on_point(binding->userdata, record->value.point[0], record->value.point[1]);
+                break;
+        }
+        binding->pending = true;
+    }
+}
+
+/**
+ * @brief Applies everything posted since the last drain. Runs from the feed's timer;
+ *        call it directly only if open_ui_feed reported no timer. UI thread only.
+ * @return Number of records read
+ */
+static inline int drain_ui_feed(UiFeed* feed) {
+    if (!feed) return 0;
+    FeedHeader* header = feed->header;
+    unsigned read = atomic_load_explicit(&header->read_index, memory_order_relaxed);
+    unsigned write = atomic_load_explicit(&header->write_index, memory_order_acquire);
+    if (write - read > FEED_CAPACITY) {
+        LOG_WARN("Feed '%s' indices are inconsistent; skipping to the newest records", feed->name);
+        read = write - FEED_CAPACITY;
+    }
+    int count = (int)(write - read);
+    for (; read != write; read++) {
+        route_feed_record_(feed, &feed->records[read & (FEED_CAPACITY - 1)]);
+    }
+    atomic_store_explicit(&header->read_index, read, memory_order_release);  // The records are free again
+
+    // Newest int or text per key; bound widgets mark themselves dirty
+    for (int i = 0; i < feed->binding_count; i++) {
+        FeedBinding* binding = &feed->bindings[i];
+        if (!binding->pending) continue;
+        binding->pending = false;
+        if (binding->kind == FEED_INT) set_observable_int(binding->cell, binding->pending_int);
+        else if (binding->kind == FEED_TEXT) set_observable_text(binding->cell, binding->pending_text);
+    }
+
+    unsigned dropped = atomic_load_explicit(&header->dropped, memory_order_relaxed);
+    if (dropped != feed->dropped) {
+        LOG_WARN("Feed '%s' was full; %u records dropped", feed->name, dropped - feed->dropped);
+        feed->dropped = dropped;
+    }
+    return count;
+}
+
+/**
+ * @brief Stops draining, tells writers the app is gone and removes the feed.
+ */
+static inline void close_ui_feed(UiFeed* feed) {
+    if (!feed) return;
+    for (int i = 0; i < ui_feeds_count_; i++) {
+        if (ui_feeds_[i] == feed) {
+            ui_feeds_[i] = ui_feeds_[--ui_feeds_count_];
+            break;
+        }
+    }
+    cancel_timer(feed->timer);
+    atomic_store_explicit(&feed->header->reader_open, 0, memory_order_release);
+    unmap_feed_(feed->header);
+#ifndef _WIN32
+    shm_unlink(feed->name);  // Attached writers see reader_open cleared and reattach later
+#endif
+    free(feed->name);
+    free(feed);
+}
+
+// At shutdown, before the timers and the observables bound to feeds are freed
+static inline void close_all_ui_feeds_(void) {
+    while (ui_feeds_count_ > 0) close_ui_feed(ui_feeds_[ui_feeds_count_ - 1]);
+}
+
+#endif /* FEED_H */
@@ -0,0 +1,246 @@
+/**
+ * @file feed_writer.h
+ * @brief Shared-memory feed: ring layout and the writer side, for producer processes.
+ *
+ * A feed carries keyed updates from another process (a monitoring backend, say)
+ * into a forms app: int values for progress bars and sliders, short texts, and
+ * series points. The app creates a POSIX shared-memory object with open_ui_feed
+ * (feed.h); a producer maps the same name with open_feed_writer and posts fixed-size
+ * records into a single-producer, single-consumer ring. Posting is a copy into the
+ * mapping plus one atomic store of the write index, and the app drains with one
+ * atomic store of the read index, so neither side makes a system call per update.
+ *
+ * This header needs only libc and POSIX (no SDL), so producers include it on its
+ * own. One writer per feed: a multi-threaded producer serializes its posts.
+ *
+ * Layout (native byte order; both sides run on one machine):
+ *   FeedHeader   magic "FFED", version, capacity, record size, reader flag; then the
+ *                write index and drop count, and the read index, on cache lines of
+ *                their own
+ *   records      capacity x FeedRecord, record i at (i & (capacity - 1))
+ * Indices count records and wrap at 2^32: the ring is empty when they are equal and
+ * full when they are `capacity` apart. Posting to a full ring drops the new record
+ * and counts it in `dropped`; the app reports drops when it drains.
+ */
+
+#ifndef FEED_WRITER_H
+#define FEED_WRITER_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define FEED_MAGIC "FFED"
+#define FEED_VERSION 1
+#define FEED_CAPACITY 4096      // Records (a power of two); seconds of backlog at hundreds per second
+#define FEED_KEY_MAX 32         // Key bytes including the '\0'
+#define FEED_TEXT_MAX 88        // Text bytes including the '\0'; longer texts are cut
+#define FEED_CACHE_LINE 64
+
+typedef enum {
+    FEED_INT = 1,
+    FEED_TEXT = 2,
+    FEED_POINT = 3
+} FeedKind;
+
+/**
+ * @brief One keyed update (128 bytes)
+ */
+typedef struct {
+    uint32_t kind;              // FeedKind
+    uint32_t key_hash;          // feed_key_hash_(key); compared before the key
+    char key[FEED_KEY_MAX];
+    union {
+        int32_t i;              // FEED_INT
+        double point[2];        // FEED_POINT: x, y
+        char text[FEED_TEXT_MAX];  // FEED_TEXT
+    } value;
+} FeedRecord;
+
+/**
+ * @brief Start of the shared object; the records follow it
+ */
+typedef struct {
+    char magic[4];              // Written last when the app creates the feed
+    uint32_t version;
+    uint32_t capacity;
+    uint32_t record_size;
+    atomic_uint reader_open;    // Cleared when the app closes the feed
+    char pad0_[FEED_CACHE_LINE - 20];
+    atomic_uint write_index;    // Writer's line
+    atomic_uint dropped;
+    char pad1_[FEED_CACHE_LINE - 8];
+    atomic_uint read_index;     // Reader's line
+    char pad2_[FEED_CACHE_LINE - 4];
+} FeedHeader;
+
+_Static_assert(sizeof(FeedRecord) == 128, "FeedRecord is part of the shared layout");
+_Static_assert(sizeof(FeedHeader) == 3 * FEED_CACHE_LINE, "FeedHeader is part of the shared layout");
+
+#define FEED_SIZE (sizeof(FeedHeader) + (size_t)FEED_CAPACITY * sizeof(FeedRecord))
+
+/**
+ * @brief A producer's handle on a feed
+ */
+typedef struct {
+    FeedHeader* header;
+    FeedRecord* records;
+    uint32_t write_index;       // Only this writer stores it; kept here to skip a load
+    uint32_t read_index;        // Last read index seen; reloaded only when the ring looks full
+} FeedWriter;
+
+// FNV-1a of the key, so the app compares keys only when the hashes match
+static inline uint32_t feed_key_hash_(const char* key) {
+    uint32_t hash = 2166136261u;
+    for (; *key; key++) hash = (hash ^ (unsigned char)*key) * 16777619u;
+    return hash;
+}
+
+static inline bool is_feed_header_valid_(const FeedHeader* header) {
+    return memcmp(header->magic, FEED_MAGIC, 4) == 0 && header->version == FEED_VERSION &&
+           header->capacity == FEED_CAPACITY && header->record_size == sizeof(FeedRecord);
+}
+
+// Maps the shared object `name` ("/something"); creates and sizes it if `create`.
+// NULL if it does not exist (yet) or cannot be mapped.
+static inline FeedHeader* map_feed_(const char* name, bool create) {
+#ifndef _WIN32
+    int fd = shm_open(name, create ? O_RDWR | O_CREAT : O_RDWR, 0600);
+    if (fd < 0) return NULL;
+    struct stat st;
+    bool sized = fstat(fd, &st) == 0 && (size_t)st.st_size == FEED_SIZE;
+    if (!sized && (!create || ftruncate(fd, (off_t)FEED_SIZE) != 0)) {
+        close(fd);
+        return NULL;
+    }
+    void* map = mmap(NULL, FEED_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);  // The mapping stays valid
+    return map == MAP_FAILED ? NULL : (FeedHeader*)map;
+#else
+    (void)name;
+    (void)create;
+    return NULL;  // No shared-memory feed on Windows yet
+#endif
+}
+
+static inline void unmap_feed_(FeedHeader* header) {
+#ifndef _WIN32
+    if (header) munmap(header, FEED_SIZE);
+#else
+    (void)header;
+#endif
+}
+
+/**
+ * @brief Attaches to the feed the app created under `name`.
+ * @return NULL until the app has opened the feed (producers retry), or on error
+ */
+static inline FeedWriter* open_feed_writer(const char* name) {
+    if (!name) return NULL;
+    FeedHeader* header = map_feed_(name, false);
+    if (!header) return NULL;
+    if (!is_feed_header_valid_(header)) {
+        unmap_feed_(header);
+        return NULL;
+    }
+    FeedWriter* writer = (FeedWriter*)malloc(sizeof(FeedWriter));
+    if (!writer) {
+        unmap_feed_(header);
+        return NULL;
+    }
+    writer->header = header;
+    writer->records = (FeedRecord*)(header + 1);
+    writer->write_index = atomic_load_explicit(&header->write_index, memory_order_relaxed);
+    writer->read_index = atomic_load_explicit(&header->read_index, memory_order_acquire);
+    return writer;
+}
+
+/**
+ * @brief false once the app has closed the feed; reattach with open_feed_writer.
+ */
+static inline bool is_feed_reader_open(const FeedWriter* writer) {
+    return writer && atomic_load_explicit(&writer->header->reader_open, memory_order_relaxed);
+}
+
+// Next free record, or NULL (counted as dropped) if the ring is full or the app is gone
+static inline FeedRecord* begin_feed_record_(FeedWriter* writer, FeedKind kind, const char* key) {
+    if (!writer || !key || !is_feed_reader_open(writer)) return NULL;
+    FeedHeader* header = writer->header;
+    if (writer->write_index - writer->read_index >= FEED_CAPACITY) {
+        writer->read_index = atomic_load_explicit(&header->read_index, memory_order_acquire);
+        if (writer->write_index - writer->read_index >= FEED_CAPACITY) {
+            atomic_fetch_add_explicit(&header->dropped, 1, memory_order_relaxed);
+            return NULL;
+        }
+    }
+    FeedRecord* record = &writer->records[writer->write_index & (FEED_CAPACITY - 1)];
+    record->kind = (uint32_t)kind;
+    record->key_hash = feed_key_hash_(key);
+    strncpy(record->key, key, FEED_KEY_MAX - 1);
+    record->key[FEED_KEY_MAX - 1] = '\0';
+    return record;
+}
+
+// Makes the record visible to the app
+static inline void commit_feed_record_(FeedWriter* writer) {
+    writer->write_index++;
+    atomic_store_explicit(&writer->header->write_index, writer->write_index, memory_order_release);
+}
+
+/**
+ * @brief Posts an int for `key` (progress values, slider positions). The app keeps
+ *        the newest per key and frame.
+ * @return false if the record was dropped (ring full or app gone)
+ */
+static inline bool post_feed_int(FeedWriter* writer, const char* key, int value) {
+    FeedRecord* record = begin_feed_record_(writer, FEED_INT, key);
+    if (!record) return false;
+    record->value.i = value;
+    commit_feed_record_(writer);
+    return true;
+}
+
+/**
+ * @brief Posts a text for `key`, cut to FEED_TEXT_MAX - 1 bytes. Newest per key and frame.
+ */
+static inline bool post_feed_text(FeedWriter* writer, const char* key, const char* text) {
+    FeedRecord* record = begin_feed_record_(writer, FEED_TEXT, key);
+    if (!record) return false;
+    strncpy(record->value.text, text ? text : "", FEED_TEXT_MAX - 1);
+    record->value.text[FEED_TEXT_MAX - 1] = '\0';
+    commit_feed_record_(writer);
+    return true;
+}
+
+/**
+ * @brief Posts a series point for `key`. Points are all delivered, in order.
+ */
+static inline bool post_feed_point(FeedWriter* writer, const char* key, double x, double y) {
+    FeedRecord* record = begin_feed_record_(writer, FEED_POINT, key);
+    if (!record) return false;
+    record->value.point[0] = x;
+    record->value.point[1] = y;
+    commit_feed_record_(writer);
+    return true;
+}
+
+/**
+ * @brief Detaches from the feed; the app keeps it open.
+ */
+static inline void close_feed_writer(FeedWriter* writer) {
+    if (!writer) return;
+    unmap_feed_(writer->header);
+    free(writer);
+}
+
+#endif /* FEED_WRITER_H */
@@ -0,0 +1,267 @@
+/**
+ * @file frame.h
+ * @brief Per-container draw lists, recorded in parallel and submitted in order.
+ *
+ * Each frame gets one slot per registered container plus a shared slot 0 for
+ * widgets placed straight on a window. A slot holds one DrawList per pass; a pass
+ * is one widget kind in app_run_'s draw order. Recording a slot (culling,
+ * geometry, colors; see drawlist.h) reads only that container and its widgets,
+ * so the slots are recorded as one job group on the job system. Entries and
+ * textboxes measure their text with SDL_ttf, and the image widgets may load and
+ * upload textures, neither of which is thread safe, so the calling thread records
+ * those passes itself while the workers run. Submission then walks slot by slot in
+ * container order and draws all passes of a slot before the next one, so every
+ * container, with its widgets, is drawn over the ones before it. Slot 0 goes last:
+ * widgets placed on the window stay on top of every container, as they always were.
+ */
+
+#ifndef FRAME_H
+#define FRAME_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "drawlist.h"
+#include "jobs.h"
+
+#define FRAME_PARALLEL_MIN_SLOTS 3  // Below this, recording inline is cheaper than a job group
+
+// In draw order within a slot
+typedef enum {
+    DRAW_PASS_CONTAINERS,
+    DRAW_PASS_DROPS,
+    DRAW_PASS_RADIOS,
+    DRAW_PASS_ENTRIES,    // Recorded by the calling thread (SDL_ttf)
+    DRAW_PASS_TEXTBOXES,  // Recorded by the calling thread (SDL_ttf)
+    DRAW_PASS_SLIDERS,
+    DRAW_PASS_BUTTONS,
+    DRAW_PASS_TEXTS,
+    DRAW_PASS_PROGRESS_BARS,
+    DRAW_PASS_IMAGES,     // Recorded by the calling thread (texture loads); images, tiled, animated
+    DRAW_PASS_SCROLLBARS,
+    DRAW_PASS_COUNT
+} DrawPass;
+
+/**
+ * @brief Draw lists of one container (or, for slot 0, of everything else)
+ */
+typedef struct {
+    Parent* owner;                       // NULL for slot 0
+    DrawList passes[DRAW_PASS_COUNT];
+} FrameSlot;
+
+static FrameSlot frame_slots_[MAX_CONTAINERS + 1];
+static int frame_slot_count_ = 0;
+
+// Slot that records a widget of `parent`; unregistered parents and windows share slot 0
+static inline int frame_slot_of_(Parent* parent) {
+    if (!parent) return 0;
+    int slot = parent->draw_slot;
+    if (slot <= 0 || slot >= frame_slot_count_ || frame_slots_[slot].owner != parent) return 0;
+    return slot;
+}
+
+// Passes that use SDL_ttf or the renderer while recording
+static inline bool is_calling_thread_pass_(int pass) {
+    return pass == DRAW_PASS_ENTRIES || pass == DRAW_PASS_TEXTBOXES || pass == DRAW_PASS_IMAGES;
+}
+
+// Job: records every pass of one slot except the calling thread's
+static void record_frame_slot_(void* data) {
+    int slot = (int)(intptr_t)data;
+    FrameSlot* fs = &frame_slots_[slot];
+    for (int p = 0; p < DRAW_PASS_COUNT; p++) {
+        if (!is_calling_thread_pass_(p)) clear_draw_list_(&fs->passes[p]);
+    }
+
+    // Containers fully hidden behind a later opaque container are not drawn
+    if (fs->owner && !is_container_occluded_(fs->owner)) {
+        record_container_(&fs->passes[DRAW_PASS_CONTAINERS], fs->owner);
+        record_container_scrollbars_(&fs->passes[DRAW_PASS_SCROLLBARS], fs->owner);
+    }
+    for (int i = 0; i < drops_count; i++) {
+        if (drop_widgets[i] && frame_slot_of_(drop_widgets[i]->parent) == slot) {
+            record_drop_down_(&fs->passes[DRAW_PASS_DROPS], drop_widgets[i]);
+        }
+    }
+    for (int i = 0; i < radios_count; i++) {
+        if (radio_widgets[i] && frame_slot_of_(radio_widgets[i]->parent) == slot) {
+            record_radio_(&fs->passes[DRAW_PASS_RADIOS], radio_widgets[i]);
+        }
+    }
+    for (int i = 0; i < sliders_count; i++) {
+        if (sliders[i] && frame_slot_of_(sliders[i]->parent) == slot) {
+            record_slider_(&fs->passes[DRAW_PASS_SLIDERS], sliders[i]);
+        }
+    }
+    for (int i = 0; i < buttons_count; i++) {
+        if (button_widgets[i] && frame_slot_of_(button_widgets[i]->parent) == slot) {
+            record_button_(&fs->passes[DRAW_PASS_BUTTONS], button_widgets[i]);
+        }
+    }
+    for (int i = 0; i < texts_count; i++) {
+        if (text_widgets[i] && frame_slot_of_(text_widgets[i]->parent) == slot) {
+            record_text_widget_(&fs->passes[DRAW_PASS_TEXTS], text_widgets[i]);
+        }
+    }
+    for (int i = 0; i < progress_bars_count; i++) {
+        if (progress_bar_widgets[i] && frame_slot_of_(progress_bar_widgets[i]->parent) == slot) {
+            record_progress_bar_(&fs->passes[DRAW_PASS_PROGRESS_BARS], progress_bar_widgets[i]);
+        }
+    }
+}
+
+// Records the font and image passes of every slot; only the calling thread opens fonts
+// and creates textures
+static inline void record_frame_calling_thread_passes_(void) {
+    for (int slot = 0; slot < frame_slot_count_; slot++) {
+        clear_draw_list_(&frame_slots_[slot].passes[DRAW_PASS_ENTRIES]);
+        clear_draw_list_(&frame_slots_[slot].passes[DRAW_PASS_TEXTBOXES]);
+        clear_draw_list_(&frame_slots_[slot].passes[DRAW_PASS_IMAGES]);
+    }
+    for (int i = 0; i < entrys_count; i++) {
+        if (entry_widgets[i]) {
+            record_entry_(&frame_slots_[frame_slot_of_(entry_widgets[i]->parent)].passes[DRAW_PASS_ENTRIES], entry_widgets[i]);
+        }
+    }
+    for (int i = 0; i < textboxs_count; i++) {
+        if (textbox_widgets[i]) {
+            record_textbox_(&frame_slots_[frame_slot_of_(textbox_widgets[i]->parent)].passes[DRAW_PASS_TEXTBOXES],
+                            textbox_widgets[i]);
+        }
+    }
+    for (int i = 0; i < images_count; i++) {
+        if (image_widgets[i]) {
+            sync_image_load_state_(image_widgets[i]);  // Even when hidden, so on_load fires promptly
+            record_image_(&frame_slots_[frame_slot_of_(image_widgets[i]->parent)].passes[DRAW_PASS_IMAGES], image_widgets[i]);
+        }
+    }
+    for (int i = 0; i < tiled_images_count; i++) {
+        if (tiled_image_widgets[i]) {
+            record_tiled_image_(&frame_slots_[frame_slot_of_(tiled_image_widgets[i]->parent)].passes[DRAW_PASS_IMAGES],
+                                tiled_image_widgets[i]);
+        }
+    }
+    for (int i = 0; i < animated_images_count; i++) {
+        if (animated_image_widgets[i]) {
+            record_animated_image_(&frame_slots_[frame_slot_of_(animated_image_widgets[i]->parent)].passes[DRAW_PASS_IMAGES],
+                                   animated_image_widgets[i]);
+        }
+    }
+}
+
+// Grows every parent's scrollable extent over its widgets, at the sizes they are drawn
+// at. Runs before the record jobs, which only read the extents (scrollbars).
+static inline void update_content_extents_(void) {
+    for (int i = 0; i < drops_count; i++) {
+        Drop* d = drop_widgets[i];
+        if (d) grow_parent_content_(d->parent, d->x, d->y, d->w, d->h);
+    }
+    for (int i = 0; i < radios_count; i++) {
+        Radio* r = radio_widgets[i];
+        if (r) grow_parent_content_(r->parent, r->x, r->y, r->w, r->h);
+    }
+    for (int i = 0; i < entrys_count; i++) {
+        Entry* e = entry_widgets[i];
+        if (e) grow_parent_content_(e->parent, e->x, e->y, e->w, e->h);
+    }
+    for (int i = 0; i < textboxs_count; i++) {
+        TextBox* t = textbox_widgets[i];
+        if (t) grow_parent_content_(t->parent, t->x, t->y, t->w, t->h);
+    }
+    for (int i = 0; i < sliders_count; i++) {
+        Slider* s = sliders[i];
+        if (s) grow_parent_content_(s->parent, s->x, s->y, s->w, s->h);
+    }
+    for (int i = 0; i < buttons_count; i++) {
+        Button* b = button_widgets[i];
+        if (b) grow_parent_content_(b->parent, b->x, b->y, b->w, b->h);
+    }
+    for (int i = 0; i < texts_count; i++) {
+        Text* t = text_widgets[i];
+        if (t) grow_parent_content_(t->parent, t->x, t->y, 0, 0);  // Position only, as text_box_ anchors it
+    }
+    for (int i = 0; i < progress_bars_count; i++) {
+        ProgressBar* p = progress_bar_widgets[i];
+        if (p) grow_parent_content_(p->parent, p->x, p->y, p->w, p->h);
+    }
+    for (int i = 0; i < images_count; i++) {
+        Image* im = image_widgets[i];
+        if (im) grow_parent_content_(im->parent, im->x, im->y, im->w, im->h);
+    }
+    for (int i = 0; i < tiled_images_count; i++) {
+        TiledImage* t = tiled_image_widgets[i];
+        if (t) grow_parent_content_(t->parent, t->x, t->y, t->w, t->h);
+    }
+    for (int i = 0; i < animated_images_count; i++) {
+        AnimatedImage* a = animated_image_widgets[i];
+        if (a) grow_parent_content_(a->parent, a->x, a->y, a->w > 0 ? a->w : a->frame_w, a->h > 0 ? a->h : a->frame_h);
+    }
+}
+
+/**
+ * @brief Records this frame's draw lists. UI thread, after begin_damage_frame_ and
+ *        update_container_occluders (recording culls against both).
+ */
+static inline void record_frame_draw_lists_(void) {
+    update_content_extents_();  // Before the jobs: get_child_rect no longer writes the parent
+    frame_slots_[0].owner = NULL;
+    frame_slot_count_ = 1;
+    for (int i = 0; i < containers_count; i++) {
+        Parent* container = container_widgets[i];
+        frame_slots_[frame_slot_count_].owner = container;
+        if (container) container->draw_slot = frame_slot_count_;
+        frame_slot_count_++;
+    }
+
+    JobGroup* group = NULL;
+    if (frame_slot_count_ >= FRAME_PARALLEL_MIN_SLOTS && start_jobs_()) group = new_job_group();
+    for (int slot = 0; slot < frame_slot_count_; slot++) {
+        if (!group || !add_job(group, record_frame_slot_, (void*)(intptr_t)slot)) {
+            record_frame_slot_((void*)(intptr_t)slot);
+        }
+    }
+    if (group) submit_job_group(group, NULL, NULL);
+    record_frame_calling_thread_passes_();  // Overlaps the workers
+    if (group) wait_job_group(group);
+}
+
+// The i-th slot to draw: the containers in order, then slot 0 (window widgets) on top
+static inline int frame_draw_slot_(int i) {
+    return i + 1 < frame_slot_count_ ? i + 1 : 0;
+}
+
+/**
+ * @brief Draws the recorded slots in container order, each with all its passes, then the
+ *        window's widgets. Main thread only.
+ */
+static inline void submit_frame_slots_(void) {
+    for (int i = 0; i < frame_slot_count_; i++) {
+        FrameSlot* fs = &frame_slots_[frame_draw_slot_(i)];
+        for (int p = 0; p < DRAW_PASS_COUNT; p++) submit_draw_list_(&fs->passes[p]);
+    }
+}
+
+/**
+ * @brief Appends the recorded slots to `dst` in the order submit_frame_slots_ draws them.
+ */
+static inline void append_frame_slots_(DrawList* dst) {
+    for (int i = 0; i < frame_slot_count_; i++) {
+        FrameSlot* fs = &frame_slots_[frame_draw_slot_(i)];
+        for (int p = 0; p < DRAW_PASS_COUNT; p++) append_draw_list_(dst, &fs->passes[p]);
+    }
+}
+
+/**
+ * @brief Frees the recorded lists (at shutdown).
+ */
+static inline void free_frame_draw_lists_(void) {
+    for (int slot = 0; slot <= MAX_CONTAINERS; slot++) {
+        for (int p = 0; p < DRAW_PASS_COUNT; p++) free_draw_list_(&frame_slots_[slot].passes[p]);
+    }
+    frame_slot_count_ = 0;
+    free_draw_list_(&immediate_draw_list_);
+}
+
+#endif /* FRAME_H */
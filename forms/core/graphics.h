@@ -10,8 +10,111 @@
 #include <SDL2/SDL_ttf.h>
 #include <SDL2/SDL_image.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
 #include <math.h>
 #include "color.h"   // Access Color struct
+#include "log.h"     // Leveled logging
+#include "startup.h" // Font/image load timings
+#include "atlas.h"   // Shared pages for small images
+#include "pack.h"    // Memory-mapped asset pack
+
+// ______________LAZY SUBSYSTEMS_____________
+// new_window only brings up video and events; SDL_ttf and each SDL_image codec
+// are initialized the first time something needs them.
+
+/**
+ * @brief Initializes SDL_ttf on first use.
+ * @return true if TTF is ready
+ */
+static inline bool ensure_ttf_init_(void) {
+    if (TTF_WasInit()) return true;
+    if (TTF_Init() == -1) {
+        LOG_ERROR("TTF initialization failed: %s", TTF_GetError());
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Opens a font from the asset pack (or the filesystem), initializing SDL_ttf first
+ *        if needed. Use instead of TTF_OpenFont.
+ */
+static inline TTF_Font* open_font_(const char* file, int size) {
+    Uint64 load_start = startup_mark_();
+    TTF_Font* font = NULL;
+    if (ensure_ttf_init_()) {
+        ensure_asset_pack_();
+        SDL_RWops* packed = open_asset_(file);  // Read in place; the pack outlives the font
+        font = packed ? TTF_OpenFontRW(packed, 1, size) : TTF_OpenFont(file, size);
+    }
+    startup_add_(STARTUP_FONT_LOAD, load_start);
+    return font;
+}
+
+/**
+ * @brief Maps a file extension to the SDL_image codec that decodes it.
+ * @return IMG_INIT_* flag, or 0 for formats that need no IMG_Init (BMP, GIF, ...)
+ */
+static inline int image_codec_for_file_(const char* file) {
+    const char* ext = file ? strrchr(file, '.') : NULL;
+    if (!ext) return 0;
+    if (SDL_strcasecmp(ext, ".jpg") == 0 || SDL_strcasecmp(ext, ".jpeg") == 0) return IMG_INIT_JPG;
+    if (SDL_strcasecmp(ext, ".png") == 0) return IMG_INIT_PNG;
+    if (SDL_strcasecmp(ext, ".webp") == 0) return IMG_INIT_WEBP;
+    if (SDL_strcasecmp(ext, ".tif") == 0 || SDL_strcasecmp(ext, ".tiff") == 0) return IMG_INIT_TIF;
+    return 0;
+}
+
+static int img_initialized_codecs_ = 0;  // IMG_INIT_* flags brought up so far
+
+/**
+ * @brief Initializes only the SDL_image codec needed for this file, once.
+ */
+static inline void ensure_image_codec_(const char* file) {
+    int codec = image_codec_for_file_(file);
+    if (!codec || (img_initialized_codecs_ & codec)) return;
+    int initted = IMG_Init(codec);
+    if (!(initted & codec)) {
+        LOG_WARN("Image codec for %s could not be initialized: %s", file, IMG_GetError());
+    }
+    img_initialized_codecs_ |= initted;
+}
+
+/**
+ * @brief Decodes an image from the asset pack, or from the filesystem if it is not packed.
+ *        Safe on loader threads once ensure_asset_pack_ and ensure_image_codec_ have run.
+ */
+static inline SDL_Surface* decode_image_(const char* file) {
+    SDL_RWops* packed = open_asset_(file);
+    return packed ? IMG_Load_RW(packed, 1) : IMG_Load(file);
+}
+
+/**
+ * @brief Loads a texture, initializing its codec first. Use instead of IMG_LoadTexture.
+ */
+static inline SDL_Texture* load_texture_(SDL_Renderer* renderer, const char* file) {
+    Uint64 load_start = startup_mark_();
+    ensure_asset_pack_();
+    ensure_image_codec_(file);
+    SDL_RWops* packed = open_asset_(file);
+    SDL_Texture* texture = packed ? IMG_LoadTexture_RW(renderer, packed, 1) : IMG_LoadTexture(renderer, file);
+    startup_add_(STARTUP_IMAGE_DECODE, load_start);
+    return texture;
+}
+
+/**
+ * @brief Decodes an image to a surface, initializing its codec first. Use instead of IMG_Load.
+ */
+static inline SDL_Surface* load_surface_(const char* file) {
+    Uint64 load_start = startup_mark_();
+    ensure_asset_pack_();
+    ensure_image_codec_(file);
+    SDL_Surface* surface = decode_image_(file);
+    startup_add_(STARTUP_IMAGE_DECODE, load_start);
+    return surface;
+}
 
 /**
  * @brief Clears the screen to the specified color
@@ -19,8 +122,7 @@
  * @param color The background color to set
  */
 static inline void clear_screen_(Base* base, Color color) {
-    SDL_SetRenderDrawColor(base->sdl_renderer, color.r, color.g, color.b, color.a);
-    SDL_RenderClear(base->sdl_renderer);
+    clear_damage_(base->sdl_renderer, color.r, color.g, color.b, color.a);  // Only the dirty part on partial frames
 }
 
 /**
@@ -245,6 +347,16 @@ typedef enum {
     ALIGN_RIGHT
 } TextAlign;
 
+/**
+ * @brief Cheap upper bound on a string's rendered width, without opening a font.
+ *        Used to cull labels before paying for TTF_OpenFont.
+ * @param text The text string (NULL gives 0)
+ * @param font_size Font size in the same units as the result
+ */
+static inline int estimate_text_width_(const char* text, int font_size) {
+    return text ? (int)strlen(text) * font_size : 0;
+}
+
 /**
  * @brief Draws text at the specified position using a provided TTF font
  * @param base Pointer to the Base struct containing the renderer
@@ -257,20 +369,20 @@ typedef enum {
  */
 static inline void draw_text_from_font_(Base* base, TTF_Font* font, const char* text, int x, int y, Color color, TextAlign align) {
     if (!font) {
-        printf("No font provided for text rendering\n");
+        LOG_ERROR("No font provided for text rendering");
         return;
     }
 
     SDL_Color sdl_color = {color.r, color.g, color.b, color.a};
     SDL_Surface* surface = TTF_RenderText_Solid(font, text, sdl_color);
     if (!surface) {
-        printf("Failed to render text: %s\n", TTF_GetError());
+        LOG_ERROR("Failed to render text: %s", TTF_GetError());
         return;
     }
 
     SDL_Texture* texture = SDL_CreateTextureFromSurface(base->sdl_renderer, surface);
     if (!texture) {
-        printf("Failed to create texture from text surface: %s\n", SDL_GetError());
+        LOG_ERROR("Failed to create texture from text surface: %s", SDL_GetError());
         SDL_FreeSurface(surface);
         return;
     }
@@ -313,9 +425,9 @@ static inline void draw_text_from_font_(Base* base, TTF_Font* font, const char*
 static char *FONT_FILE = "forms/core/FreeMono.ttf";
 
 static inline void draw_text_(Base* base, const char* text, int font_size, int x, int y, Color color) {
-    TTF_Font* font = TTF_OpenFont(FONT_FILE, font_size);
+    TTF_Font* font = open_font_(FONT_FILE, font_size);
     if (!font) {
-        printf("Failed to load font '%s': %s\n", FONT_FILE, TTF_GetError());
+        LOG_ERROR("Failed to load font '%s': %s", FONT_FILE, TTF_GetError());
         return;
     }
 
@@ -323,8 +435,495 @@ static inline void draw_text_(Base* base, const char* text, int font_size, int x
     TTF_CloseFont(font);
 }
 
+// ______________IMAGE SCALING_____________
+
+/**
+ * @brief Downscales a surface with an area-averaging (box) filter, weighting colors by alpha.
+ *        Pure CPU work on the surfaces passed in, so it is safe on loader threads.
+ * @return New ARGB8888 surface of w x h, or NULL on failure (src is left untouched)
+ */
+static inline SDL_Surface* scale_surface_(SDL_Surface* src, int w, int h) {
+    if (!src || w <= 0 || h <= 0) return NULL;
+
+    SDL_Surface* in = SDL_ConvertSurfaceFormat(src, SDL_PIXELFORMAT_ARGB8888, 0);
+    if (!in) return NULL;
+    SDL_Surface* out = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, SDL_PIXELFORMAT_ARGB8888);
+    if (!out) {
+        SDL_FreeSurface(in);
+        return NULL;
+    }
+    SDL_LockSurface(in);
+    SDL_LockSurface(out);
+
+    for (int dy = 0; dy < h; dy++) {
+        int y0 = (int)((Sint64)dy * in->h / h);
+        int y1 = (int)((Sint64)(dy + 1) * in->h / h);
+        if (y1 <= y0) y1 = y0 + 1;
+        Uint32* dst_row = (Uint32*)((Uint8*)out->pixels + dy * out->pitch);
+
+        for (int dx = 0; dx < w; dx++) {
+            int x0 = (int)((Sint64)dx * in->w / w);
+            int x1 = (int)((Sint64)(dx + 1) * in->w / w);
+            if (x1 <= x0) x1 = x0 + 1;
+
+            Uint64 sum_a = 0, sum_r = 0, sum_g = 0, sum_b = 0;
+            for (int sy = y0; sy < y1; sy++) {
+                const Uint32* src_row = (const Uint32*)((const Uint8*)in->pixels + sy * in->pitch);
+                for (int sx = x0; sx < x1; sx++) {
+                    Uint32 p = src_row[sx];
+                    Uint32 a = p >> 24;
+                    sum_a += a;
+                    sum_r += ((p >> 16) & 0xFF) * a;
+                    sum_g += ((p >> 8) & 0xFF) * a;
+                    sum_b += (p & 0xFF) * a;
+                }
+            }
+            Uint32 count = (Uint32)((y1 - y0) * (x1 - x0));
+            Uint32 a = (Uint32)(sum_a / count);
+            Uint32 r = sum_a ? (Uint32)(sum_r / sum_a) : 0;
+            Uint32 g = sum_a ? (Uint32)(sum_g / sum_a) : 0;
+            Uint32 b = sum_a ? (Uint32)(sum_b / sum_a) : 0;
+            dst_row[dx] = (a << 24) | (r << 16) | (g << 8) | b;
+        }
+    }
+
+    SDL_UnlockSurface(out);
+    SDL_UnlockSurface(in);
+    SDL_FreeSurface(in);
+    return out;
+}
+
+/**
+ * @brief Shrinks a decoded surface to a physical display size (variant) if it is larger.
+ *        Never upscales. Frees `surface` when it returns a replacement.
+ */
+static inline SDL_Surface* fit_surface_to_variant_(SDL_Surface* surface, int variant_w, int variant_h) {
+    if (!surface || variant_w <= 0 || variant_h <= 0) return surface;
+    if (surface->w <= variant_w && surface->h <= variant_h) return surface;
+
+    SDL_Surface* scaled = scale_surface_(surface, variant_w, variant_h);
+    if (!scaled) return surface;  // Fall back to the full-resolution pixels
+    SDL_FreeSurface(surface);
+    return scaled;
+}
+
+// ______________TEXTURE CACHE_____________
+// Textures are shared by (renderer, path, scale variant). Widgets hold a reference
+// through acquire_texture_/release_texture_; immediate-mode draw_image_ calls look
+// entries up without a reference and keep them until free_texture_cache_.
+// Under a memory budget, textures not drawn for a while are evicted; the entry
+// stays and the texture is reloaded the next time something draws it.
+// Images up to ATLAS_MAX_IMAGE_SIZE are packed into shared atlas pages instead
+// (see atlas.h); their entries point at the page and draw `src_rect` from it.
+// In pipelined mode (app.h) the cache lives on the update thread, which may not use
+// the renderer: decoded pixels wait in the entry until the render thread first draws
+// it, and released entries are handed to the render thread to be freed.
+
+#define TEXTURE_CACHE_BUCKETS 256
+#define TEXTURE_MEMORY_BUDGET_DEFAULT (256u * 1024u * 1024u)  // Bytes of texture memory before eviction starts
+#define TEXTURE_EVICT_IDLE_MS 2000  // Only textures not drawn for this long are evicted
+
+/**
+ * @brief Where a cache entry's texture is in its life
+ */
+typedef enum {
+    TEXTURE_READY,    // texture is uploaded and usable
+    TEXTURE_LOADING,  // Decode queued or running on a loader thread (see loader.h)
+    TEXTURE_FAILED,   // File could not be decoded; texture is NULL
+    TEXTURE_EVICTED   // Dropped under memory pressure; reloaded on next use
+} TextureState;
+
+/**
+ * @brief One decoded, uploaded image shared across widgets
+ */
+typedef struct TextureCacheEntry {
+    SDL_Renderer* renderer;
+    char* path;
+    int variant_w, variant_h;   // Display size the texture was downscaled for, physical pixels (0, 0 = full resolution)
+    SDL_Texture* texture;       // NULL while loading or if the file failed to load (not retried)
+    TextureState state;
+    int tex_w, tex_h;           // Image size in pixels
+    SDL_Rect src_rect;          // Image's pixels within `texture` (the whole texture unless in_atlas)
+    bool in_atlas;              // `texture` is a shared atlas page owned by atlas.h
+    size_t bytes;               // Estimated texture memory (tex_w * tex_h * 4)
+    Uint32 last_used;           // SDL_GetTicks() of the last draw (see touch_texture_)
+    int ref_count;              // Widgets holding this entry
+    bool orphaned;              // Released while loading; the loader frees it when the decode returns
+    SDL_Surface* upload;        // Decoded pixels the render thread has not uploaded yet (deferred uploads)
+    bool has_waiters;           // Widgets showed a placeholder for it (see wait_for_texture_)
+    SDL_Rect waiting_rect;      // Union of their physical rects, redrawn when the load finishes
+    Uint32 hash;
+    struct TextureCacheEntry* next;  // Next entry in the same bucket
+} TextureCacheEntry;
+
+static TextureCacheEntry* texture_cache_buckets_[TEXTURE_CACHE_BUCKETS];
+static size_t texture_cache_bytes_ = 0;  // Sum of `bytes` over entries holding a texture
+static size_t texture_memory_budget_ = TEXTURE_MEMORY_BUDGET_DEFAULT;
+static bool texture_uploads_deferred_ = false;  // The cache's thread may not use the renderer
+static TextureCacheEntry* retired_textures_ = NULL;  // Released while deferred; freed by the render thread
+static SDL_SpinLock retired_textures_lock_ = 0;
+
+/**
+ * @brief Sets how much texture memory the cache may hold before evicting idle textures (0 = no limit).
+ */
+static inline void set_texture_memory_budget(size_t bytes) {
+    texture_memory_budget_ = bytes;
+}
+
+static inline size_t get_texture_memory_usage(void) {
+    return texture_cache_bytes_;
+}
+
+/**
+ * @brief Makes the texture cache leave the renderer to another thread (pipelined mode):
+ *        set_entry_surface_ keeps the pixels for upload_deferred_texture_, and released
+ *        entries wait for free_retired_textures_. Set only while no frame is drawn.
+ */
+static inline void defer_texture_uploads_(bool deferred) {
+    texture_uploads_deferred_ = deferred;
+}
+
+// Puts decoded pixels into an atlas slot or a texture of their own; false if neither worked.
+// Renderer thread.
+static inline bool upload_entry_surface_(TextureCacheEntry* entry, SDL_Surface* surface) {
+    SDL_Texture* page = NULL;
+    SDL_Rect slot;
+    if (atlas_pack_surface_(entry->renderer, surface, &page, &slot)) {
+        entry->texture = page;
+        entry->src_rect = slot;
+        entry->in_atlas = true;
+        return true;
+    }
+    entry->texture = SDL_CreateTextureFromSurface(entry->renderer, surface);
+    entry->src_rect = (SDL_Rect){0, 0, surface->w, surface->h};
+    entry->in_atlas = false;
+    return entry->texture != NULL;
+}
+
+/**
+ * @brief Stores decoded pixels (or NULL on failure) in an entry and frees the surface.
+ *        Small images go into an atlas page; the rest get a texture of their own.
+ *        With deferred uploads the entry keeps the surface and is ready right away.
+ */
+static inline void set_entry_surface_(TextureCacheEntry* entry, SDL_Surface* surface) {
+    entry->last_used = SDL_GetTicks();
+    if (!surface) {
+        entry->state = TEXTURE_FAILED;
+        return;
+    }
+    entry->tex_w = surface->w;
+    entry->tex_h = surface->h;
+    if (texture_uploads_deferred_) {
+        // Counted in full even if it lands in an atlas page; the render thread decides that
+        entry->upload = surface;
+        entry->state = TEXTURE_READY;
+        entry->bytes = (size_t)surface->w * (size_t)surface->h * 4;
+        texture_cache_bytes_ += entry->bytes;
+        return;
+    }
+    if (upload_entry_surface_(entry, surface)) {
+        entry->state = TEXTURE_READY;
+        entry->bytes = entry->in_atlas ? 0 : (size_t)surface->w * (size_t)surface->h * 4;  // Pages count in get_atlas_memory_usage
+        texture_cache_bytes_ += entry->bytes;
+    } else {
+        entry->state = TEXTURE_FAILED;
+    }
+    SDL_FreeSurface(surface);
+}
+
+/**
+ * @brief Render thread, deferred uploads: uploads the entry's pixels before its first draw.
+ */
+static inline void upload_deferred_texture_(TextureCacheEntry* entry) {
+    SDL_Surface* surface = entry->upload;
+    if (!surface) return;
+    entry->upload = NULL;
+    if (!upload_entry_surface_(entry, surface)) {
+        LOG_ERROR("Failed to upload img %s : %s", entry->path, SDL_GetError());
+    }
+    SDL_FreeSurface(surface);
+}
+
+/**
+ * @brief The entry's texture if the calling thread may draw with it; NULL while uploads
+ *        are deferred to the render thread (draw lists then carry the entry instead).
+ */
+static inline SDL_Texture* entry_texture_(const TextureCacheEntry* entry) {
+    return entry && !texture_uploads_deferred_ ? entry->texture : NULL;
+}
+
+// Marks an entry as drawn this frame, so it is not evicted
+static inline void touch_texture_(TextureCacheEntry* entry) {
+    if (entry) entry->last_used = SDL_GetTicks();
+}
+
 /**
- * @brief Draw an image from file (loads and destroys texture each call).
+ * @brief Notes that a widget at `rect` (physical) shows a placeholder while the entry
+ *        loads, so that only that rect is redrawn when the texture arrives.
+ */
+static inline void wait_for_texture_(TextureCacheEntry* entry, SDL_Rect rect) {
+    if (!entry) return;
+    if (entry->has_waiters) SDL_UnionRect(&entry->waiting_rect, &rect, &entry->waiting_rect);
+    else entry->waiting_rect = rect;
+    entry->has_waiters = true;
+}
+
+// Drops an entry's texture but keeps the entry (and its references) for a later reload
+static inline void evict_texture_entry_(TextureCacheEntry* entry) {
+    if (!entry->texture) return;
+    if (entry->in_atlas) release_atlas_slot_(entry->texture);
+    else SDL_DestroyTexture(entry->texture);
+    entry->texture = NULL;
+    texture_cache_bytes_ -= entry->bytes;
+    entry->bytes = 0;
+    entry->state = TEXTURE_EVICTED;
+}
+
+/**
+ * @brief Synchronously (re)loads an entry's texture, e.g. after eviction.
+ */
+static inline void reload_texture_(TextureCacheEntry* entry) {
+    set_entry_surface_(entry, fit_surface_to_variant_(load_surface_(entry->path), entry->variant_w, entry->variant_h));
+    if (entry->state == TEXTURE_FAILED) {
+        LOG_ERROR("Failed to load img %s : %s", entry->path, IMG_GetError());
+    }
+}
+
+static inline Uint32 texture_cache_hash_(SDL_Renderer* renderer, const char* path, int variant_w, int variant_h) {
+    Uint32 hash = 2166136261u;  // FNV-1a over the path, then the rest of the key
+    for (const char* c = path; *c; c++) {
+        hash = (hash ^ (Uint8)*c) * 16777619u;
+    }
+    hash = (hash ^ (Uint32)variant_w) * 16777619u;
+    hash = (hash ^ (Uint32)variant_h) * 16777619u;
+    hash = (hash ^ (Uint32)(uintptr_t)renderer) * 16777619u;
+    return hash;
+}
+
+/**
+ * @brief Looks up an entry without creating it.
+ */
+static inline TextureCacheEntry* find_cached_texture_(SDL_Renderer* renderer, const char* path, int variant_w, int variant_h) {
+    if (!renderer || !path) return NULL;
+    Uint32 hash = texture_cache_hash_(renderer, path, variant_w, variant_h);
+    for (TextureCacheEntry* entry = texture_cache_buckets_[hash % TEXTURE_CACHE_BUCKETS]; entry; entry = entry->next) {
+        if (entry->hash == hash && entry->renderer == renderer &&
+            entry->variant_w == variant_w && entry->variant_h == variant_h &&
+            strcmp(entry->path, path) == 0) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Creates an empty entry (state TEXTURE_LOADING, no texture) and links it into the cache.
+ */
+static inline TextureCacheEntry* insert_texture_entry_(SDL_Renderer* renderer, const char* path, int variant_w, int variant_h) {
+    TextureCacheEntry* entry = (TextureCacheEntry*)calloc(1, sizeof(TextureCacheEntry));
+    if (!entry) {
+        LOG_ERROR("Failed to allocate texture cache entry");
+        return NULL;
+    }
+    entry->path = strdup(path);
+    if (!entry->path) {
+        LOG_ERROR("Failed to allocate texture cache entry");
+        free(entry);
+        return NULL;
+    }
+    entry->renderer = renderer;
+    entry->variant_w = variant_w;
+    entry->variant_h = variant_h;
+    entry->hash = texture_cache_hash_(renderer, path, variant_w, variant_h);
+    entry->state = TEXTURE_LOADING;
+
+    TextureCacheEntry** bucket = &texture_cache_buckets_[entry->hash % TEXTURE_CACHE_BUCKETS];
+    entry->next = *bucket;
+    *bucket = entry;
+    return entry;
+}
+
+/**
+ * @brief Finds or synchronously loads a cached texture without taking a reference.
+ * @return The entry (its texture may be NULL if loading failed or is still in flight), or NULL on bad arguments
+ */
+static inline TextureCacheEntry* get_cached_texture_(SDL_Renderer* renderer, const char* path, int variant_w, int variant_h) {
+    if (!renderer || !path) return NULL;
+
+    TextureCacheEntry* found = find_cached_texture_(renderer, path, variant_w, variant_h);
+    if (found) {
+        if (found->state == TEXTURE_EVICTED) reload_texture_(found);
+        return found;
+    }
+
+    TextureCacheEntry* entry = insert_texture_entry_(renderer, path, variant_w, variant_h);
+    if (!entry) return NULL;
+    reload_texture_(entry);
+    return entry;
+}
+
+/**
+ * @brief Removes an entry from its bucket (it is not freed).
+ */
+static inline void unlink_texture_entry_(TextureCacheEntry* entry) {
+    TextureCacheEntry** link = &texture_cache_buckets_[entry->hash % TEXTURE_CACHE_BUCKETS];
+    while (*link && *link != entry) {
+        link = &(*link)->next;
+    }
+    if (*link) *link = entry->next;
+    entry->next = NULL;
+}
+
+/**
+ * @brief Finds or loads a cached texture and takes a reference to it.
+ *        Pair every call with release_texture_.
+ */
+static inline TextureCacheEntry* acquire_texture_(SDL_Renderer* renderer, const char* path, int variant_w, int variant_h) {
+    TextureCacheEntry* entry = get_cached_texture_(renderer, path, variant_w, variant_h);
+    if (entry) entry->ref_count++;
+    return entry;
+}
+
+// Frees an unlinked entry and whatever it still holds. Renderer thread.
+static inline void free_texture_entry_(TextureCacheEntry* entry) {
+    if (entry->texture && entry->in_atlas) release_atlas_slot_(entry->texture);
+    else if (entry->texture) SDL_DestroyTexture(entry->texture);
+    if (entry->upload) SDL_FreeSurface(entry->upload);
+    free(entry->path);
+    free(entry);
+}
+
+static inline void destroy_texture_entry_(TextureCacheEntry* entry) {
+    if (texture_uploads_deferred_) {
+        // The render thread may have uploaded it, so it frees it. No snapshot refers
+        // to it any more: snapshots hold a reference while the render thread has them.
+        texture_cache_bytes_ -= entry->bytes;
+        entry->bytes = 0;
+        SDL_AtomicLock(&retired_textures_lock_);
+        entry->next = retired_textures_;
+        retired_textures_ = entry;
+        SDL_AtomicUnlock(&retired_textures_lock_);
+        return;
+    }
+    evict_texture_entry_(entry);
+    free_texture_entry_(entry);
+}
+
+/**
+ * @brief Render thread, deferred uploads: frees the entries released since the last call.
+ */
+static inline void free_retired_textures_(void) {
+    SDL_AtomicLock(&retired_textures_lock_);
+    TextureCacheEntry* entry = retired_textures_;
+    retired_textures_ = NULL;
+    SDL_AtomicUnlock(&retired_textures_lock_);
+    while (entry) {
+        TextureCacheEntry* next = entry->next;
+        free_texture_entry_(entry);
+        entry = next;
+    }
+}
+
+/**
+ * @brief Drops a reference; the texture is destroyed when the last holder releases it.
+ */
+static inline void release_texture_(TextureCacheEntry* entry) {
+    if (!entry || entry->ref_count <= 0) return;
+    if (--entry->ref_count > 0) return;
+
+    unlink_texture_entry_(entry);
+    if (entry->state == TEXTURE_LOADING) {
+        entry->orphaned = true;  // A loader thread still points at it
+        return;
+    }
+    destroy_texture_entry_(entry);
+}
+
+/**
+ * @brief Destroys every cached texture. Call before the renderer is destroyed
+ *        and after shutdown_image_loader_ so no decode is in flight.
+ */
+static inline void free_texture_cache_(void) {
+    for (int i = 0; i < TEXTURE_CACHE_BUCKETS; i++) {
+        TextureCacheEntry* entry = texture_cache_buckets_[i];
+        while (entry) {
+            TextureCacheEntry* next = entry->next;
+            if (entry->state == TEXTURE_LOADING) {
+                entry->orphaned = true;  // Freed by the loader (shut it down first)
+                entry->next = NULL;
+            } else {
+                destroy_texture_entry_(entry);
+            }
+            entry = next;
+        }
+        texture_cache_buckets_[i] = NULL;
+    }
+    free_atlas_pages_();
+}
+
+static int compare_entries_by_last_use_(const void* a, const void* b) {
+    Uint32 ta = (*(TextureCacheEntry* const*)a)->last_used;
+    Uint32 tb = (*(TextureCacheEntry* const*)b)->last_used;
+    return (ta > tb) - (ta < tb);
+}
+
+/**
+ * @brief Evicts least recently drawn textures until the cache fits its memory budget.
+ *        Only textures idle for TEXTURE_EVICT_IDLE_MS are candidates, so anything on
+ *        screen stays resident even if the budget is too small. Call once per frame.
+ */
+static inline void enforce_texture_budget_(void) {
+    if (texture_memory_budget_ == 0 || texture_cache_bytes_ <= texture_memory_budget_) return;
+
+    Uint32 now = SDL_GetTicks();
+    int capacity = 0;
+    for (int i = 0; i < TEXTURE_CACHE_BUCKETS; i++) {
+        for (TextureCacheEntry* entry = texture_cache_buckets_[i]; entry; entry = entry->next) {
+            capacity++;
+        }
+    }
+    TextureCacheEntry** idle = (TextureCacheEntry**)malloc(sizeof(TextureCacheEntry*) * (capacity ? capacity : 1));
+    if (!idle) return;
+
+    int idle_count = 0;
+    for (int i = 0; i < TEXTURE_CACHE_BUCKETS; i++) {
+        for (TextureCacheEntry* entry = texture_cache_buckets_[i]; entry; entry = entry->next) {
+            // Atlas slots are tiny; evicting one frees memory only with the rest of its page
+            if (entry->state == TEXTURE_READY && !entry->in_atlas && now - entry->last_used >= TEXTURE_EVICT_IDLE_MS) {
+                idle[idle_count++] = entry;
+            }
+        }
+    }
+    qsort(idle, idle_count, sizeof(TextureCacheEntry*), compare_entries_by_last_use_);
+    for (int i = 0; i < idle_count && texture_cache_bytes_ > texture_memory_budget_; i++) {
+        evict_texture_entry_(idle[i]);
+    }
+    free(idle);
+}
+
+/**
+ * @brief Draws part of a texture, e.g. an image packed into an atlas page.
+ * @param src  Source rect within the texture (NULL for all of it).
+ * @param w    Width (0 to use the source width).
+ * @param h    Height (0 to use the source height).
+ */
+static inline void draw_image_region_(Base* base, SDL_Texture* texture, const SDL_Rect* src, int x, int y, int w, int h) {
+    if (!texture) return;
+    flush_atlas_batch_();  // Keep queued atlas draws beneath this one
+    if (w <= 0 || h <= 0) {
+        if (src) {
+            w = src->w;
+            h = src->h;
+        } else {
+            SDL_QueryTexture(texture, NULL, NULL, &w, &h);
+        }
+    }
+    SDL_Rect img_rect = {x, y, w, h};
+    SDL_RenderCopy(base->sdl_renderer, texture, src, &img_rect);
+}
+
+/**
+ * @brief Draw an image from file through the texture cache (decoded once per path).
  * @param base Base struct with valid SDL_Renderer.
  * @param file Path to image file.
  * @param x    X coordinate.
@@ -333,20 +932,12 @@ static inline void draw_text_(Base* base, const char* text, int font_size, int x
  * @param h    Height (0 to use texture height).
  */
 void draw_image_(Base * base, const char * file, int x, int y, int w, int h){
-	SDL_Texture * texture = IMG_LoadTexture(base->sdl_renderer, file);
-	if(!texture){
-		printf("Failed to load img %s : %s\n",file, IMG_GetError());
-		return;
+	TextureCacheEntry* entry = get_cached_texture_(base->sdl_renderer, file, 0, 0);
+	if(!entry || !entry->texture){
+		return;  // Failure was logged when the entry was created
 	}
-	 // If width/height are 0, use the texture's actual size
-    if (w <= 0 || h <= 0) {
-        SDL_QueryTexture(texture, NULL, NULL, &w, &h);
-    }
-
-    SDL_Rect img_rect = {x, y, w, h}; // x, y, w, h
-    SDL_RenderCopy(base->sdl_renderer, texture, NULL, &img_rect);
-    
-	SDL_DestroyTexture(texture);
+	touch_texture_(entry);
+	draw_image_region_(base, entry->texture, &entry->src_rect, x, y, w, h);
 }
 
 /**
@@ -360,7 +951,7 @@ void draw_image_(Base * base, const char * file, int x, int y, int w, int h){
 */
 void draw_image_from_texture_(Base *base, SDL_Texture * texture, int x, int y, int w, int h){
 	if(!texture){
-		printf("Failed to load img: %s\n", IMG_GetError());
+		LOG_ERROR("Failed to load img: %s", IMG_GetError());
 		return;
 	}
 	 // If width/height are 0, use the texture's actual size
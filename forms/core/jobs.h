@@ -0,0 +1,475 @@
+/**
+ * @file jobs.h
+ * @brief Work-stealing job system for short CPU work (decoding, text layout, scaling).
+ *
+ * Work is submitted as a JobGroup: add_job stages any number of jobs, then
+ * submit_job_group starts them. Each worker thread owns a deque; it runs its own
+ * jobs newest first and, when it runs dry, steals the oldest job of another
+ * worker. A semaphore holds one token per queued job, so idle workers sleep
+ * instead of spinning.
+ *
+ * A group can wait for other groups (job_group_after) and has an optional `done`
+ * callback. `done` runs on the main thread: finished groups go on a completion
+ * list whose hand-off goes through the update queue (updates.h), and its
+ * SDL_PushEvent wake-up gets app_run_ out of its wait. The main thread can also
+ * block on a group with wait_job_group, running that group's queued jobs itself
+ * meanwhile (never another group's, which could be a long decode).
+ *
+ * Workers are sized to the core count (one core is left to the main thread) and
+ * start on the first submit; app_run_ stops them with shutdown_jobs_.
+ */
+
+#ifndef JOBS_H
+#define JOBS_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "log.h"
+#include "updates.h"
+
+#define JOBS_MAX_WORKERS 15
+#define JOB_DEQUE_INITIAL 64
+
+typedef void (*JobFn)(void* data);
+typedef void (*JobGroupDoneFn)(void* userdata);
+
+struct JobGroup;
+
+typedef struct {
+    JobFn fn;
+    void* data;
+    struct JobGroup* group;
+} Job;
+
+/**
+ * @brief A worker's jobs: the owner pushes and pops at the tail, thieves take from the head
+ */
+typedef struct {
+    Job* items;            // Ring buffer; jobs are [head, tail) modulo capacity
+    int capacity;
+    int head, tail;
+    SDL_SpinLock lock;     // Held only for a few loads and stores
+} JobDeque;
+
+typedef struct JobGroup {
+    Job* staged;                    // Jobs added before the group starts
+    int staged_count, staged_capacity;
+    SDL_atomic_t remaining;         // Jobs started but not finished
+    SDL_atomic_t blockers;          // Unfinished dependencies, plus 1 until submitted
+    struct JobGroup** dependents;   // Groups waiting for this one (guarded by jobs_.lock)
+    int dependent_count, dependent_capacity;
+    bool finished;                  // All jobs ran; no more dependents (guarded by jobs_.lock)
+    bool settled;                   // Handed to the main thread (guarded by jobs_.lock)
+    bool waited;                    // wait_job_group owns it; no hand-off (guarded by jobs_.lock)
+    JobGroupDoneFn done;
+    void* userdata;
+    struct JobGroup* next_done;     // In jobs_.completed
+    struct JobGroup* prev_live;     // Every group not yet freed, for shutdown
+    struct JobGroup* next_live;
+} JobGroup;
+
+typedef struct {
+    SDL_Thread* threads[JOBS_MAX_WORKERS];
+    JobDeque deques[JOBS_MAX_WORKERS];
+    int worker_count;
+    SDL_sem* work;             // One token per queued job
+    SDL_mutex* lock;           // Group bookkeeping and the lists below
+    SDL_cond* settled;         // Broadcast whenever a group settles
+    SDL_atomic_t quit;
+    SDL_atomic_t next_deque;   // Round robin for jobs submitted off the workers
+    SDL_TLSID worker_tls;      // 1 + worker index on worker threads
+    JobGroup* completed;       // Settled groups waiting for their `done` (newest first)
+    JobGroup* live;
+    bool started;
+    bool failed;               // Threads could not be started; jobs run inline
+} JobSystem;
+
+static JobSystem jobs_;
+
+// -------- Deques --------
+static inline bool push_job_(JobDeque* d, Job job) {
+    SDL_AtomicLock(&d->lock);
+    int count = d->tail - d->head;
+    if (count == d->capacity) {
+        int capacity = d->capacity ? d->capacity * 2 : JOB_DEQUE_INITIAL;
+        Job* items = (Job*)malloc(sizeof(Job) * capacity);
+        if (!items) {
+            SDL_AtomicUnlock(&d->lock);
+            return false;
+        }
+        for (int i = 0; i < count; i++) items[i] = d->items[(d->head + i) % d->capacity];
+        free(d->items);
+        d->items = items;
+        d->capacity = capacity;
+        d->head = 0;
+        d->tail = count;
+    }
+    d->items[d->tail++ % d->capacity] = job;
+    SDL_AtomicUnlock(&d->lock);
+    return true;
+}
+
+static inline bool pop_job_(JobDeque* d, Job* job) {
+    bool found = false;
+    SDL_AtomicLock(&d->lock);
+    if (d->tail > d->head) {
+        *job = d->items[--d->tail % d->capacity];
+        found = true;
+        if (d->tail == d->head) d->head = d->tail = 0;
+    }
+    SDL_AtomicUnlock(&d->lock);
+    return found;
+}
+
+static inline bool steal_job_(JobDeque* d, Job* job) {
+    bool found = false;
+    SDL_AtomicLock(&d->lock);
+    if (d->tail > d->head) {
+        *job = d->items[d->head++ % d->capacity];
+        found = true;
+        if (d->tail == d->head) d->head = d->tail = 0;
+    }
+    SDL_AtomicUnlock(&d->lock);
+    return found;
+}
+
+// Index of the calling worker, or -1 on any other thread
+static inline int current_worker_(void) {
+    if (!jobs_.started || jobs_.failed) return -1;
+    return (int)(intptr_t)SDL_TLSGet(jobs_.worker_tls) - 1;
+}
+
+// Own deque first, then the others; -1 (main thread) only steals
+static inline bool take_job_(int self, Job* job) {
+    if (self >= 0 && pop_job_(&jobs_.deques[self], job)) return true;
+    for (int k = 1; k <= jobs_.worker_count; k++) {
+        int victim = ((self < 0 ? 0 : self) + k) % jobs_.worker_count;
+        if (steal_job_(&jobs_.deques[victim], job)) return true;
+    }
+    return false;
+}
+
+// Takes the newest queued job of `group` from any deque, wherever it sits in the deque
+static inline bool take_group_job_(JobGroup* group, Job* job) {
+    for (int w = 0; w < jobs_.worker_count; w++) {
+        JobDeque* d = &jobs_.deques[w];
+        SDL_AtomicLock(&d->lock);
+        for (int i = d->tail - 1; i >= d->head; i--) {
+            if (d->items[i % d->capacity].group != group) continue;
+            *job = d->items[i % d->capacity];
+            for (int k = i; k + 1 < d->tail; k++) d->items[k % d->capacity] = d->items[(k + 1) % d->capacity];
+            d->tail--;
+            if (d->tail == d->head) d->head = d->tail = 0;
+            SDL_AtomicUnlock(&d->lock);
+            return true;
+        }
+        SDL_AtomicUnlock(&d->lock);
+    }
+    return false;
+}
+
+// -------- Groups --------
+// No lock when the job system could not start; everything then runs on the main thread
+static inline void lock_jobs_(void) {
+    if (jobs_.lock) SDL_LockMutex(jobs_.lock);
+}
+
+static inline void unlock_jobs_(void) {
+    if (jobs_.lock) SDL_UnlockMutex(jobs_.lock);
+}
+
+static inline void start_job_group_(JobGroup* g);
+static inline void drain_job_completions_(void* target, WidgetUpdateValue* value);
+
+// The group's last job finished: release dependents, then hand it to the main thread
+static inline void complete_job_group_(JobGroup* g) {
+    lock_jobs_();
+    g->finished = true;  // job_group_after no longer adds to `dependents`
+    unlock_jobs_();
+
+    for (int i = 0; i < g->dependent_count; i++) {
+        JobGroup* dep = g->dependents[i];
+        if (SDL_AtomicAdd(&dep->blockers, -1) == 1) start_job_group_(dep);
+    }
+    free(g->dependents);
+    g->dependents = NULL;
+    g->dependent_count = g->dependent_capacity = 0;
+
+    lock_jobs_();
+    g->settled = true;
+    bool hand_off = !g->waited;
+    if (hand_off) {
+        g->next_done = jobs_.completed;
+        jobs_.completed = g;
+    }
+    if (jobs_.settled) SDL_CondBroadcast(jobs_.settled);
+    unlock_jobs_();
+    // Pending hand-offs coalesce; one drain takes every settled group
+    if (hand_off) post_widget_update_(&jobs_, drain_job_completions_, (WidgetUpdateValue){0});
+}
+
+static inline void run_job_(Job job) {
+    job.fn(job.data);
+    if (SDL_AtomicAdd(&job.group->remaining, -1) == 1) complete_job_group_(job.group);
+}
+
+static int job_worker_thread_(void* data) {
+    int self = (int)(intptr_t)data;
+    SDL_TLSSet(jobs_.worker_tls, (void*)(intptr_t)(self + 1), NULL);
+    while (true) {
+        SDL_SemWait(jobs_.work);
+        if (SDL_AtomicGet(&jobs_.quit)) break;
+        // The token guarantees a queued job; another thief may just be faster at a given deque
+        Job job;
+        while (!take_job_(self, &job)) {
+            if (SDL_AtomicGet(&jobs_.quit)) return 0;
+            SDL_Delay(0);
+        }
+        run_job_(job);
+    }
+    return 0;
+}
+
+// Starts the workers on first use; false means jobs run inline on the caller
+static inline bool start_jobs_(void) {
+    if (jobs_.started) return !jobs_.failed;
+    jobs_.started = true;
+    jobs_.failed = true;
+
+    jobs_.lock = SDL_CreateMutex();
+    jobs_.settled = SDL_CreateCond();
+    jobs_.work = SDL_CreateSemaphore(0);
+    jobs_.worker_tls = SDL_TLSCreate();
+    if (!jobs_.lock || !jobs_.settled || !jobs_.work || !jobs_.worker_tls) {
+        LOG_WARN("Job system unavailable, running jobs inline: %s", SDL_GetError());
+        return false;
+    }
+    SDL_AtomicSet(&jobs_.quit, 0);
+
+    int workers = SDL_GetCPUCount() - 1;  // The main thread keeps a core
+    if (workers < 1) workers = 1;
+    if (workers > JOBS_MAX_WORKERS) workers = JOBS_MAX_WORKERS;
+    // Deques exist before any thread can steal from them
+    jobs_.worker_count = workers;
+    for (int i = 0; i < workers; i++) {
+        jobs_.threads[i] = SDL_CreateThread(job_worker_thread_, "job-worker", (void*)(intptr_t)i);
+        if (!jobs_.threads[i]) {
+            LOG_WARN("Failed to start job worker: %s", SDL_GetError());
+            jobs_.worker_count = i;  // Nothing was queued yet, so no job is stranded
+            break;
+        }
+    }
+    jobs_.failed = jobs_.worker_count == 0;
+    if (!jobs_.failed) LOG_DEBUG("Job system started with %d workers", jobs_.worker_count);
+    return !jobs_.failed;
+}
+
+static inline void start_job_group_(JobGroup* g) {
+    int count = g->staged_count;
+    if (count == 0) {
+        complete_job_group_(g);
+        return;
+    }
+    SDL_AtomicSet(&g->remaining, count);
+    Job* staged = g->staged;
+    g->staged = NULL;
+    g->staged_count = g->staged_capacity = 0;
+
+    if (jobs_.failed || jobs_.worker_count == 0) {
+        for (int i = 0; i < count; i++) run_job_(staged[i]);
+        free(staged);
+        return;
+    }
+    // Jobs spawned on a worker stay on its deque (cache-warm); others are spread out
+    int self = current_worker_();
+    for (int i = 0; i < count; i++) {
+        int target = self >= 0 ? self : (int)((unsigned)SDL_AtomicAdd(&jobs_.next_deque, 1) % (unsigned)jobs_.worker_count);
+        if (push_job_(&jobs_.deques[target], staged[i])) {
+            SDL_SemPost(jobs_.work);
+        } else {
+            LOG_ERROR("Failed to grow job queue; running job inline");
+            run_job_(staged[i]);
+        }
+    }
+    free(staged);
+}
+
+/**
+ * @brief Creates an empty group. Add jobs, optionally dependencies, then submit it.
+ * @return NULL if it could not be allocated
+ */
+static inline JobGroup* new_job_group(void) {
+    start_jobs_();
+    JobGroup* g = (JobGroup*)calloc(1, sizeof(JobGroup));
+    if (!g) {
+        LOG_ERROR("Failed to allocate job group");
+        return NULL;
+    }
+    SDL_AtomicSet(&g->blockers, 1);  // Released by submit_job_group
+    lock_jobs_();
+    g->next_live = jobs_.live;
+    if (jobs_.live) jobs_.live->prev_live = g;
+    jobs_.live = g;
+    unlock_jobs_();
+    return g;
+}
+
+/**
+ * @brief Stages fn(data) in a group that has not been submitted yet.
+ */
+static inline bool add_job(JobGroup* g, JobFn fn, void* data) {
+    if (!g || !fn) return false;
+    if (g->staged_count == g->staged_capacity) {
+        int capacity = g->staged_capacity ? g->staged_capacity * 2 : 8;
+        Job* staged = (Job*)realloc(g->staged, sizeof(Job) * capacity);
+        if (!staged) {
+            LOG_ERROR("Failed to add job");
+            return false;
+        }
+        g->staged = staged;
+        g->staged_capacity = capacity;
+    }
+    g->staged[g->staged_count++] = (Job){fn, data, g};
+    return true;
+}
+
+/**
+ * @brief Holds g's jobs until every job of `dep` has finished. Call before submitting g,
+ *        while `dep` is still alive (its `done` has not run).
+ */
+static inline void job_group_after(JobGroup* g, JobGroup* dep) {
+    if (!g || !dep || g == dep) return;
+    lock_jobs_();
+    if (!dep->finished) {
+        if (dep->dependent_count == dep->dependent_capacity) {
+            int capacity = dep->dependent_capacity ? dep->dependent_capacity * 2 : 4;
+            JobGroup** dependents = (JobGroup**)realloc(dep->dependents, sizeof(JobGroup*) * capacity);
+            if (dependents) {
+                dep->dependents = dependents;
+                dep->dependent_capacity = capacity;
+            }
+        }
+        if (dep->dependent_count < dep->dependent_capacity) {
+            dep->dependents[dep->dependent_count++] = g;
+            SDL_AtomicIncRef(&g->blockers);
+        } else {
+            LOG_ERROR("Failed to add job dependency; group will not wait");
+        }
+    }
+    unlock_jobs_();
+}
+
+/**
+ * @brief Starts the group once its dependencies are done. `done(userdata)` runs on the
+ *        main thread after its last job, and the group is freed after that.
+ */
+static inline void submit_job_group(JobGroup* g, JobGroupDoneFn done, void* userdata) {
+    if (!g) return;
+    g->done = done;
+    g->userdata = userdata;
+    if (SDL_AtomicAdd(&g->blockers, -1) == 1) start_job_group_(g);
+}
+
+static inline void free_job_group_(JobGroup* g) {
+    if (g->prev_live) g->prev_live->next_live = g->next_live;
+    else jobs_.live = g->next_live;
+    if (g->next_live) g->next_live->prev_live = g->prev_live;
+    free(g->staged);
+    free(g->dependents);
+    free(g);
+}
+
+/**
+ * @brief Blocks the main thread until a submitted group is done, running the group's
+ *        own queued jobs meanwhile; then calls its `done` right here and frees it.
+ *        Every group it depends on must have been submitted too.
+ */
+static inline void wait_job_group(JobGroup* g) {
+    if (!g) return;
+    lock_jobs_();
+    g->waited = true;
+    while (!g->settled) {
+        unlock_jobs_();
+        Job job;
+        bool helped = false;
+        // One token per job we take, or a worker would wake for a job that is gone
+        if (jobs_.worker_count > 0 && SDL_SemTryWait(jobs_.work) == 0) {
+            helped = take_group_job_(g, &job);
+            if (helped) run_job_(job);
+            else SDL_SemPost(jobs_.work);  // Only other groups' jobs are queued; leave them to the workers
+        }
+        lock_jobs_();
+        if (!helped && !g->settled) SDL_CondWaitTimeout(jobs_.settled, jobs_.lock, 1);
+    }
+    // Settled before we started waiting: take it back from the completion list
+    for (JobGroup** link = &jobs_.completed; *link; link = &(*link)->next_done) {
+        if (*link == g) {
+            *link = g->next_done;
+            break;
+        }
+    }
+    unlock_jobs_();
+    if (g->done) g->done(g->userdata);
+    lock_jobs_();
+    free_job_group_(g);
+    unlock_jobs_();
+}
+
+// Update-queue callback on the main thread: `done` for every settled group, oldest first.
+// Taken one at a time, so a `done` that waits on another settled group cannot free it under us.
+static inline void drain_job_completions_(void* target, WidgetUpdateValue* value) {
+    (void)target;
+    (void)value;
+    while (true) {
+        lock_jobs_();
+        JobGroup** link = &jobs_.completed;
+        while (*link && (*link)->next_done) link = &(*link)->next_done;
+        JobGroup* g = *link;
+        if (g) *link = NULL;
+        unlock_jobs_();
+        if (!g) break;
+        if (g->done) g->done(g->userdata);
+        lock_jobs_();
+        free_job_group_(g);
+        unlock_jobs_();
+    }
+}
+
+/**
+ * @brief Number of worker threads (0 before the first group or if jobs run inline).
+ */
+static inline int get_job_worker_count(void) {
+    return jobs_.failed ? 0 : jobs_.worker_count;
+}
+
+/**
+ * @brief Stops the workers. Jobs still queued never run and pending `done`s are dropped;
+ *        clients that must settle their work wait on their groups first.
+ */
+static inline void shutdown_jobs_(void) {
+    if (!jobs_.started) return;
+    SDL_AtomicSet(&jobs_.quit, 1);
+    for (int i = 0; i < jobs_.worker_count; i++) SDL_SemPost(jobs_.work);
+    for (int i = 0; i < jobs_.worker_count; i++) SDL_WaitThread(jobs_.threads[i], NULL);
+
+    while (jobs_.live) free_job_group_(jobs_.live);
+    jobs_.completed = NULL;
+    for (int i = 0; i < JOBS_MAX_WORKERS; i++) {
+        free(jobs_.deques[i].items);
+        jobs_.deques[i] = (JobDeque){0};
+    }
+    if (jobs_.work) SDL_DestroySemaphore(jobs_.work);
+    if (jobs_.settled) SDL_DestroyCond(jobs_.settled);
+    if (jobs_.lock) SDL_DestroyMutex(jobs_.lock);
+    jobs_.work = NULL;
+    jobs_.settled = NULL;
+    jobs_.lock = NULL;
+    jobs_.worker_count = 0;
+    jobs_.started = false;
+    jobs_.failed = false;
+}
+
+#endif /* JOBS_H */
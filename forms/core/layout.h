@@ -0,0 +1,422 @@
+/**
+ * @file layout.h
+ * @brief Stack, grid and anchor layouts that compute child rects from constraints.
+ *
+ * A Layout is attached to a window or container and arranges items that point at
+ * a widget's logical x/y/w/h fields. Layouts only rerun when they were marked dirty
+ * or their parent's content size changed (window resize, container resize, or a
+ * parent layout resizing a nested container), so a resize relays out just the
+ * affected subtrees.
+ */
+
+#ifndef LAYOUT_H
+#define LAYOUT_H
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "log.h"
+
+/**
+ * @brief How a layout arranges its items
+ */
+typedef enum {
+    LAYOUT_STACK,   // Items one after another along a direction
+    LAYOUT_GRID,    // Items fill fixed columns, row by row
+    LAYOUT_ANCHOR   // Items keep their distance to the anchored edges
+} LayoutType;
+
+/**
+ * @brief Main axis of a stack layout
+ */
+typedef enum {
+    STACK_VERTICAL,
+    STACK_HORIZONTAL
+} StackDirection;
+
+// Anchor flags for LAYOUT_ANCHOR items (combine with |)
+#define ANCHOR_LEFT   1
+#define ANCHOR_RIGHT  2
+#define ANCHOR_TOP    4
+#define ANCHOR_BOTTOM 8
+
+/**
+ * @brief One arranged child. Geometry pointers refer into the widget struct.
+ */
+typedef struct {
+    int *x, *y;             // Logical position fields of the widget
+    int *w, *h;             // Logical size fields (NULL when the widget has no size, e.g. Text)
+    int pref_w, pref_h;     // Preferred size (defaults to the widget's size when added)
+    int min_w, min_h;       // Minimum size when space is short
+    int weight;             // Stack: share of leftover main-axis space (0 = fixed size)
+    int anchors;            // Anchor: ANCHOR_* flags
+    int margin_left, margin_top, margin_right, margin_bottom; // Anchor: distances to the parent edges
+} LayoutItem;
+
+/**
+ * @brief Layout attached to a window or container
+ */
+typedef struct Layout {
+    Parent* parent;         // Window or container whose children are arranged
+    LayoutType type;
+    StackDirection direction; // Stack only
+    int columns;            // Grid only (>= 1)
+    int row_height;         // Grid only (0 = tallest preferred height in the row)
+    int spacing;            // Gap between items (logical)
+    int padding;            // Inset from the parent's content edges (logical)
+    LayoutItem* items;
+    int item_count;
+    int item_capacity;
+    bool dirty;             // Items or settings changed since the last pass
+    int last_w, last_h;     // Parent content size used by the last pass
+} Layout;
+
+/**
+ * @brief Logical size of the area a parent offers to its children
+ */
+static inline void get_parent_content_size(Parent* parent, int* w, int* h) {
+    *w = parent->w;
+    *h = parent->h - parent->title_height;
+}
+
+/**
+ * @brief Creates a layout for a window or container. Register it to attach it.
+ * @param parent The window or container whose children will be arranged.
+ * @param type LAYOUT_STACK, LAYOUT_GRID or LAYOUT_ANCHOR.
+ */
+static inline Layout new_layout(Parent* parent, LayoutType type) {
+    if (!parent) {
+        LOG_ERROR("Invalid parent for layout");
+    }
+
+    Layout layout;
+    layout.parent = parent;
+    layout.type = type;
+    layout.direction = STACK_VERTICAL;
+    layout.columns = 1;
+    layout.row_height = 0;
+    layout.spacing = 5;
+    layout.padding = 10;
+    layout.items = NULL;
+    layout.item_count = 0;
+    layout.item_capacity = 0;
+    layout.dirty = true;
+    layout.last_w = -1;
+    layout.last_h = -1;
+
+    return layout;
+}
+
+// Setters (each marks the layout dirty)
+static inline void set_layout_direction(Layout* layout, StackDirection direction) {
+    if (layout) {
+        layout->direction = direction;
+        layout->dirty = true;
+    }
+}
+
+static inline void set_layout_columns(Layout* layout, int columns, int row_height) {
+    if (layout) {
+        layout->columns = columns > 0 ? columns : 1;
+        layout->row_height = row_height;
+        layout->dirty = true;
+    }
+}
+
+static inline void set_layout_spacing(Layout* layout, int spacing, int padding) {
+    if (layout) {
+        layout->spacing = spacing;
+        layout->padding = padding;
+        layout->dirty = true;
+    }
+}
+
+/**
+ * @brief Adds an item from raw geometry pointers.
+ * @return The item's index, or -1 on failure.
+ */
+static inline int layout_add_item(Layout* layout, int* x, int* y, int* w, int* h) {
+    if (!layout || !layout->parent || !x || !y) return -1;
+
+    if (layout->item_count == layout->item_capacity) {
+        int capacity = layout->item_capacity ? layout->item_capacity * 2 : 16;
+        LayoutItem* items = (LayoutItem*)realloc(layout->items, sizeof(LayoutItem) * capacity);
+        if (!items) {
+            LOG_ERROR("Failed to allocate memory for layout items");
+            return -1;
+        }
+        layout->items = items;
+        layout->item_capacity = capacity;
+    }
+
+    int cw, ch;
+    get_parent_content_size(layout->parent, &cw, &ch);
+
+    LayoutItem* item = &layout->items[layout->item_count];
+    item->x = x;
+    item->y = y;
+    item->w = w;
+    item->h = h;
+    item->pref_w = w ? *w : 0;
+    item->pref_h = h ? *h : 0;
+    item->min_w = 0;
+    item->min_h = 0;
+    item->weight = 0;
+    item->anchors = ANCHOR_LEFT | ANCHOR_TOP;
+    // Anchor margins are taken from the current placement
+    item->margin_left = *x;
+    item->margin_top = *y;
+    item->margin_right = cw - (*x + item->pref_w);
+    item->margin_bottom = ch - (*y + item->pref_h);
+
+    layout->dirty = true;
+    return layout->item_count++;
+}
+
+// Adds any widget struct with x, y, w, h fields (Button, Entry, Slider, ...)
+#define layout_add_widget(layout, widget) \
+    layout_add_item((layout), &(widget)->x, &(widget)->y, &(widget)->w, &(widget)->h)
+
+// Adds a position-only item that still takes up pref_w x pref_h in flows and grids
+static inline int layout_add_sized_item_(Layout* layout, int* x, int* y, int pref_w, int pref_h) {
+    int index = layout_add_item(layout, x, y, NULL, NULL);
+    if (index < 0) return -1;
+    LayoutItem* item = &layout->items[index];
+    item->pref_w = pref_w;
+    item->pref_h = pref_h;
+    item->margin_right -= pref_w;
+    item->margin_bottom -= pref_h;
+    return index;
+}
+
+// Adds a widget that only has a position (Text), sized from its font like text_box_:
+// font_size tall and as wide as its content is estimated. Call set_layout_item_size
+// after changing the text if the estimate matters.
+#define layout_add_label(layout, widget) \
+    layout_add_sized_item_((layout), &(widget)->x, &(widget)->y, \
+                           estimate_text_width_((widget)->content, (widget)->font_size), (widget)->font_size)
+
+// Adds a nested container; its own layout reruns when this one resizes it
+static inline int layout_add_container(Layout* layout, Parent* container) {
+    if (!container) return -1;
+    return layout_add_item(layout, &container->x, &container->y, &container->w, &container->h);
+}
+
+static inline void set_layout_item_size(Layout* layout, int index, int pref_w, int pref_h) {
+    if (!layout || index < 0 || index >= layout->item_count) return;
+    layout->items[index].pref_w = pref_w;
+    layout->items[index].pref_h = pref_h;
+    layout->dirty = true;
+}
+
+static inline void set_layout_item_min_size(Layout* layout, int index, int min_w, int min_h) {
+    if (!layout || index < 0 || index >= layout->item_count) return;
+    layout->items[index].min_w = min_w;
+    layout->items[index].min_h = min_h;
+    layout->dirty = true;
+}
+
+static inline void set_layout_item_weight(Layout* layout, int index, int weight) {
+    if (!layout || index < 0 || index >= layout->item_count) return;
+    layout->items[index].weight = weight;
+    layout->dirty = true;
+}
+
+static inline void set_layout_item_anchors(Layout* layout, int index, int anchors) {
+    if (!layout || index < 0 || index >= layout->item_count) return;
+    layout->items[index].anchors = anchors;
+    layout->dirty = true;
+}
+
+static inline void mark_layout_dirty(Layout* layout) {
+    if (layout) layout->dirty = true;
+}
+
+// Writes a computed rect into the widget (size only where the widget has one)
+static inline void place_layout_item_(LayoutItem* item, int x, int y, int w, int h) {
+    *item->x = x;
+    *item->y = y;
+    if (item->w) *item->w = w < item->min_w ? item->min_w : w;
+    if (item->h) *item->h = h < item->min_h ? item->min_h : h;
+}
+
+static inline void arrange_stack_(Layout* layout, int cw, int ch) {
+    bool vertical = layout->direction == STACK_VERTICAL;
+    int main_size = (vertical ? ch : cw) - 2 * layout->padding;
+    int cross_size = (vertical ? cw : ch) - 2 * layout->padding;
+
+    // Fixed space first, then share the rest by weight
+    int used = 0;
+    int total_weight = 0;
+    for (int i = 0; i < layout->item_count; i++) {
+        LayoutItem* item = &layout->items[i];
+        used += vertical ? item->pref_h : item->pref_w;
+        total_weight += item->weight;
+    }
+    if (layout->item_count > 1) used += layout->spacing * (layout->item_count - 1);
+    int leftover = main_size - used;
+    if (leftover < 0) leftover = 0;
+
+    int cursor = layout->padding;
+    int shared = 0;
+    for (int i = 0; i < layout->item_count; i++) {
+        LayoutItem* item = &layout->items[i];
+        int extent = vertical ? item->pref_h : item->pref_w;
+        if (item->weight > 0 && total_weight > 0) {
+            int extra = leftover * item->weight / total_weight;
+            shared += item->weight;
+            if (shared == total_weight) {
+                // Last weighted item absorbs rounding
+                extra = leftover - (leftover * (total_weight - item->weight) / total_weight);
+            }
+            extent += extra;
+        }
+        if (vertical) {
+            place_layout_item_(item, layout->padding, cursor, cross_size, extent);
+        } else {
+            place_layout_item_(item, cursor, layout->padding, extent, cross_size);
+        }
+        cursor += extent + layout->spacing;
+    }
+}
+
+static inline void arrange_grid_(Layout* layout, int cw, int ch) {
+    (void)ch;
+    int columns = layout->columns > 0 ? layout->columns : 1;
+    int cell_w = (cw - 2 * layout->padding - (columns - 1) * layout->spacing) / columns;
+    if (cell_w < 0) cell_w = 0;
+
+    int y = layout->padding;
+    for (int row_start = 0; row_start < layout->item_count; row_start += columns) {
+        int row_end = row_start + columns < layout->item_count ? row_start + columns : layout->item_count;
+
+        int row_h = layout->row_height;
+        if (row_h <= 0) {
+            for (int i = row_start; i < row_end; i++) {
+                if (layout->items[i].pref_h > row_h) row_h = layout->items[i].pref_h;
+            }
+        }
+
+        for (int i = row_start; i < row_end; i++) {
+            int col = i - row_start;
+            int x = layout->padding + col * (cell_w + layout->spacing);
+            place_layout_item_(&layout->items[i], x, y, cell_w, row_h);
+        }
+        y += row_h + layout->spacing;
+    }
+}
+
+static inline void arrange_anchor_(Layout* layout, int cw, int ch) {
+    for (int i = 0; i < layout->item_count; i++) {
+        LayoutItem* item = &layout->items[i];
+        int x = *item->x, y = *item->y;
+        int w = item->pref_w, h = item->pref_h;
+
+        if ((item->anchors & ANCHOR_LEFT) && (item->anchors & ANCHOR_RIGHT)) {
+            x = item->margin_left;
+            w = cw - item->margin_left - item->margin_right;
+        } else if (item->anchors & ANCHOR_RIGHT) {
+            x = cw - item->margin_right - w;
+        } else if (item->anchors & ANCHOR_LEFT) {
+            x = item->margin_left;
+        }
+
+        if ((item->anchors & ANCHOR_TOP) && (item->anchors & ANCHOR_BOTTOM)) {
+            y = item->margin_top;
+            h = ch - item->margin_top - item->margin_bottom;
+        } else if (item->anchors & ANCHOR_BOTTOM) {
+            y = ch - item->margin_bottom - h;
+        } else if (item->anchors & ANCHOR_TOP) {
+            y = item->margin_top;
+        }
+
+        place_layout_item_(item, x, y, w, h);
+    }
+}
+
+/**
+ * @brief Lays out a single layout if it is dirty or its parent changed size.
+ *        Ancestor layouts run first, since they may resize this layout's parent.
+ */
+static inline void apply_layout(Layout* layout) {
+    if (!layout || !layout->parent) return;
+
+    Parent* up = layout->parent->is_window ? NULL : layout->parent->parent;
+    while (up && !up->layout) {
+        up = up->is_window ? NULL : up->parent;
+    }
+    if (up) apply_layout(up->layout);
+
+    int cw, ch;
+    get_parent_content_size(layout->parent, &cw, &ch);
+    if (!layout->dirty && cw == layout->last_w && ch == layout->last_h) return;
+
+    switch (layout->type) {
+        case LAYOUT_STACK:  arrange_stack_(layout, cw, ch);  break;
+        case LAYOUT_GRID:   arrange_grid_(layout, cw, ch);   break;
+        case LAYOUT_ANCHOR: arrange_anchor_(layout, cw, ch); break;
+    }
+
+    // Grow the scrollable extent to cover the arranged items plus the trailing padding
+    int extent_w = 0, extent_h = 0;
+    for (int i = 0; i < layout->item_count; i++) {
+        LayoutItem* item = &layout->items[i];
+        int right = *item->x + (item->w ? *item->w : 0);
+        int bottom = *item->y + (item->h ? *item->h : 0);
+        if (right > extent_w) extent_w = right;
+        if (bottom > extent_h) extent_h = bottom;
+    }
+    if (extent_w + layout->padding > layout->parent->content_w) layout->parent->content_w = extent_w + layout->padding;
+    if (extent_h + layout->padding > layout->parent->content_h) layout->parent->content_h = extent_h + layout->padding;
+
+    layout->dirty = false;
+    layout->last_w = cw;
+    layout->last_h = ch;
+}
+
+static inline void free_layout(Layout* layout) {
+    if (layout) {
+        free(layout->items);
+        layout->items = NULL;
+        layout->item_count = 0;
+        layout->item_capacity = 0;
+        if (layout->parent && layout->parent->layout == layout) {
+            layout->parent->layout = NULL;
+        }
+    }
+}
+
+// Registration
+#define MAX_LAYOUTS 100
+static Layout* layout_widgets[MAX_LAYOUTS];
+static int layouts_count = 0;
+
+// Registers the layout and attaches it to its parent
+static inline void register_layout(Layout* layout) {
+    if (layout && layouts_count < MAX_LAYOUTS) {
+        layout_widgets[layouts_count++] = layout;
+        if (layout->parent) layout->parent->layout = layout;
+    }
+}
+
+// Reruns only the layouts whose parent resized or that were marked dirty
+static inline void update_all_registered_layouts(void) {
+    for (int i = 0; i < layouts_count; i++) {
+        if (layout_widgets[i]) {
+            apply_layout(layout_widgets[i]);
+        }
+    }
+}
+
+static inline void free_all_registered_layouts(void) {
+    for (int i = 0; i < layouts_count; i++) {
+        if (layout_widgets[i]) {
+            free_layout(layout_widgets[i]);
+            layout_widgets[i] = NULL;
+        }
+    }
+    layouts_count = 0;
+}
+
+#endif // LAYOUT_H
@@ -0,0 +1,203 @@
+/**
+ * @file loader.h
+ * @brief Background image decoding for the texture cache.
+ *
+ * acquire_texture_async_ returns a cache entry in the TEXTURE_LOADING state and
+ * submits the file as a job group (jobs.h), whose job decodes it to an SDL_Surface.
+ * Only the main thread touches the renderer: the group's `done` callback runs there,
+ * uploads the surface, marks the entry ready or failed and redraws the rects of
+ * the widgets waiting for it (wait_for_texture_). The job system's wake-up event
+ * means app_run_ no longer polls while decodes are in flight.
+ */
+
+#ifndef LOADER_H
+#define LOADER_H
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "graphics.h"
+#include "jobs.h"
+
+/**
+ * @brief One queued or finished decode
+ */
+typedef struct ImageLoadJob {
+    TextureCacheEntry* entry;   // Entry to fill (may be orphaned while the job runs)
+    char* path;                 // Own copy, so workers never read the entry
+    int variant_w, variant_h;   // Downscale target (copied from the entry for the same reason)
+    SDL_Surface* surface;       // Decoded pixels (NULL if decoding failed)
+    char error[256];            // Why decoding failed; SDL's error string is per thread
+    JobGroup* group;
+    struct ImageLoadJob* prev;  // In the loader's active list
+    struct ImageLoadJob* next;
+} ImageLoadJob;
+
+/**
+ * @brief Decodes submitted to the job system and not yet finished on the main thread
+ */
+typedef struct {
+    ImageLoadJob* active;       // Submitted, not yet uploaded (main thread only)
+    int in_flight;              // Length of `active`
+    SDL_atomic_t quit;          // Set at shutdown; jobs that have not started skip decoding
+} ImageLoader;
+
+static ImageLoader image_loader_;
+
+// Job: runs on a worker (or on the main thread while it waits at shutdown)
+static void decode_image_job_(void* data) {
+    ImageLoadJob* job = (ImageLoadJob*)data;
+    if (SDL_AtomicGet(&image_loader_.quit)) return;
+    // Codecs were initialized on the main thread when the job was queued
+    job->surface = fit_surface_to_variant_(decode_image_(job->path), job->variant_w, job->variant_h);
+    if (!job->surface) snprintf(job->error, sizeof(job->error), "%s", IMG_GetError());
+}
+
+static inline void finish_image_load_(ImageLoadJob* job);
+
+// Group `done` callback on the main thread
+static void finish_image_job_(void* data) {
+    ImageLoadJob* job = (ImageLoadJob*)data;
+    ImageLoader* loader = &image_loader_;
+    if (job->prev) job->prev->next = job->next;
+    else loader->active = job->next;
+    if (job->next) job->next->prev = job->prev;
+    loader->in_flight--;
+    finish_image_load_(job);
+}
+
+/**
+ * @brief Queues an existing entry for background decoding and puts it in TEXTURE_LOADING.
+ * @return false if the job could not be queued (the entry is left as it was)
+ */
+static inline bool queue_texture_load_(TextureCacheEntry* entry) {
+    ImageLoadJob* job = (ImageLoadJob*)calloc(1, sizeof(ImageLoadJob));
+    char* job_path = strdup(entry->path);
+    if (!job || !job_path) {
+        LOG_ERROR("Failed to queue image %s", entry->path);
+        free(job_path);
+        free(job);
+        return false;
+    }
+    job->entry = entry;
+    job->path = job_path;
+    job->variant_w = entry->variant_w;
+    job->variant_h = entry->variant_h;
+
+    job->group = new_job_group();
+    if (!job->group || !add_job(job->group, decode_image_job_, job)) {
+        LOG_ERROR("Failed to queue image %s", entry->path);
+        if (job->group) {
+            submit_job_group(job->group, NULL, NULL);  // Empty; settles and frees itself
+        }
+        free(job_path);
+        free(job);
+        return false;
+    }
+    entry->state = TEXTURE_LOADING;
+
+    ensure_asset_pack_();               // Mounting is main-thread only
+    ensure_image_codec_(entry->path);  // IMG_Init is not thread safe; do it here
+
+    ImageLoader* loader = &image_loader_;
+    job->next = loader->active;
+    if (loader->active) loader->active->prev = job;
+    loader->active = job;
+    loader->in_flight++;
+    submit_job_group(job->group, finish_image_job_, job);
+    return true;
+}
+
+/**
+ * @brief Reloads an evicted entry in the background (synchronously if no job worker runs).
+ */
+static inline void reload_texture_async_(TextureCacheEntry* entry) {
+    if (!entry || entry->state != TEXTURE_EVICTED) return;
+    if (!start_jobs_() || !queue_texture_load_(entry)) {
+        reload_texture_(entry);
+    }
+}
+
+/**
+ * @brief Finds a cached texture or queues it for background decoding, and takes a reference.
+ *        Falls back to a synchronous load if no job worker can be started.
+ * @return Entry in TEXTURE_LOADING, TEXTURE_READY or TEXTURE_FAILED state; pair with release_texture_
+ */
+static inline TextureCacheEntry* acquire_texture_async_(SDL_Renderer* renderer, const char* path, int variant_w, int variant_h) {
+    if (!renderer || !path) return NULL;
+
+    TextureCacheEntry* entry = find_cached_texture_(renderer, path, variant_w, variant_h);
+    if (entry) {
+        entry->ref_count++;
+        reload_texture_async_(entry);  // No-op unless it was evicted
+        return entry;
+    }
+    if (!start_jobs_()) {
+        return acquire_texture_(renderer, path, variant_w, variant_h);
+    }
+
+    entry = insert_texture_entry_(renderer, path, variant_w, variant_h);
+    if (!entry) return NULL;
+    entry->ref_count = 1;
+    if (!queue_texture_load_(entry)) {
+        reload_texture_(entry);  // Could not queue; load it right here
+    }
+    return entry;
+}
+
+// Redraws the widgets that showed a placeholder for the entry
+static inline void redraw_texture_waiters_(TextureCacheEntry* entry) {
+    if (!entry->has_waiters) return;
+    SDL_Rect rect = entry->waiting_rect;
+    // Widgets without a size take the image's once it is loaded
+    if (rect.w <= 0) rect.w = entry->tex_w;
+    if (rect.h <= 0) rect.h = entry->tex_h;
+    // At least a pixel, so a frame runs and their load callbacks fire
+    if (rect.w <= 0) rect.w = 1;
+    if (rect.h <= 0) rect.h = 1;
+    mark_dirty_rect(rect);
+    entry->has_waiters = false;
+}
+
+// Uploads (or fails) one finished job and frees it
+static inline void finish_image_load_(ImageLoadJob* job) {
+    TextureCacheEntry* entry = job->entry;
+    if (entry->orphaned) {
+        // Every holder released it while it was decoding
+        entry->state = TEXTURE_FAILED;
+        destroy_texture_entry_(entry);
+    } else {
+        if (job->surface) {
+            set_entry_surface_(entry, job->surface);
+            job->surface = NULL;  // Consumed
+            if (entry->state == TEXTURE_FAILED) {
+                LOG_ERROR("Failed to upload img %s : %s", job->path, SDL_GetError());
+            }
+        } else {
+            entry->state = TEXTURE_FAILED;
+            // Jobs dropped at shutdown never ran; only report real decode failures
+            if (!SDL_AtomicGet(&image_loader_.quit)) LOG_ERROR("Failed to load img %s : %s", job->path, job->error);
+        }
+        redraw_texture_waiters_(entry);
+    }
+    if (job->surface) SDL_FreeSurface(job->surface);
+    free(job->path);
+    free(job);
+}
+
+/**
+ * @brief Settles every decode still queued or running: finished ones are uploaded,
+ *        unstarted ones fail. Call before free_texture_cache_ and shutdown_jobs_.
+ */
+static inline void shutdown_image_loader_(void) {
+    ImageLoader* loader = &image_loader_;
+    SDL_AtomicSet(&loader->quit, 1);
+    // Each `done` unlinks its job, so this walks the list down to empty
+    while (loader->active) wait_job_group(loader->active->group);
+    loader->in_flight = 0;
+}
+
+#endif /* LOADER_H */
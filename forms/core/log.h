@@ -0,0 +1,243 @@
+/**
+ * @file log.h
+ * @brief Leveled, rate-limited logging with a pluggable sink.
+ *
+ * LOG_ERROR/LOG_WARN/LOG_INFO/LOG_DEBUG compile to nothing above LOG_LEVEL, so
+ * release builds (NDEBUG) strip debug messages from hot paths entirely. Every call
+ * site owns a small static LogSite that limits it to LOG_RATE_BURST messages per
+ * LOG_RATE_WINDOW_MS; further messages are counted and reported once the window
+ * passes. Messages go to the current sink: stderr by default, or a ring buffer,
+ * a file, or any user callback set with set_log_sink().
+ *
+ * Loader and worker threads log too: a spinlock guards the call-site counters, and
+ * a mutex serializes the sink, so sinks are called one message at a time and may
+ * block on I/O without spinning the other threads that log.
+ */
+
+#ifndef LOG_H
+#define LOG_H
+
+#include <SDL2/SDL.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+
+// Message severity, from most to least important. Plain macros (not an enum) so
+// LOG_LEVEL can be compared by the preprocessor.
+#define LOG_LEVEL_NONE  (-1) // Disables all logging when used as LOG_LEVEL
+#define LOG_LEVEL_ERROR 0
+#define LOG_LEVEL_WARN  1
+#define LOG_LEVEL_INFO  2
+#define LOG_LEVEL_DEBUG 3
+typedef int LogLevel;
+
+// Compile-time level: messages above it are stripped (override with -DLOG_LEVEL=...)
+#ifndef LOG_LEVEL
+#ifdef NDEBUG
+#define LOG_LEVEL LOG_LEVEL_WARN
+#else
+#define LOG_LEVEL LOG_LEVEL_DEBUG
+#endif
+#endif
+
+#ifndef LOG_RATE_WINDOW_MS
+#define LOG_RATE_WINDOW_MS 1000  // Length of a rate-limit window per call site
+#endif
+#ifndef LOG_RATE_BURST
+#define LOG_RATE_BURST 5         // Messages a call site may emit per window
+#endif
+#define LOG_MESSAGE_MAX 512      // Longest formatted message (longer ones are truncated)
+
+/**
+ * @brief Per-call-site rate limiting state (one static instance per LOG_* use)
+ */
+typedef struct {
+    Uint32 window_start;  // SDL_GetTicks() when the current window began
+    int count;            // Messages emitted in the current window
+    int suppressed;       // Messages dropped since the last emitted one
+} LogSite;
+
+/**
+ * @brief Receives every message that passes the level and rate checks. Called under
+ *        the sink mutex, from any thread that logs: it must not log itself.
+ * @param message Formatted message without a trailing newline
+ */
+typedef void (*LogSink)(LogLevel level, const char* file, int line, const char* message, void* userdata);
+
+static inline const char* log_level_name(LogLevel level) {
+    switch (level) {
+        case LOG_LEVEL_ERROR: return "ERROR";
+        case LOG_LEVEL_WARN:  return "WARN";
+        case LOG_LEVEL_INFO:  return "INFO";
+        case LOG_LEVEL_DEBUG: return "DEBUG";
+        default:              return "LOG";
+    }
+}
+
+// -------- Built-in sinks --------
+
+// Writes "[LEVEL] message (file:line)" to stderr
+static inline void log_sink_stderr(LogLevel level, const char* file, int line, const char* message, void* userdata) {
+    (void)userdata;
+    fprintf(stderr, "[%s] %s (%s:%d)\n", log_level_name(level), message, file, line);
+}
+
+// Appends to the FILE* passed as userdata (see open_log_file)
+static inline void log_sink_file(LogLevel level, const char* file, int line, const char* message, void* userdata) {
+    FILE* out = (FILE*)userdata;
+    if (!out) return;
+    fprintf(out, "%u [%s] %s (%s:%d)\n", SDL_GetTicks(), log_level_name(level), message, file, line);
+    if (level == LOG_LEVEL_ERROR) fflush(out);
+}
+
+#define LOG_RING_SIZE 256  // Messages kept by a LogRing
+
+/**
+ * @brief Fixed-size in-memory log; the oldest messages are overwritten. No I/O at all.
+ */
+typedef struct {
+    LogLevel levels[LOG_RING_SIZE];
+    char messages[LOG_RING_SIZE][LOG_MESSAGE_MAX];
+    int next;   // Slot the next message is written to
+    int count;  // Valid messages (up to LOG_RING_SIZE)
+} LogRing;
+
+// Stores into the LogRing passed as userdata
+static inline void log_sink_ring(LogLevel level, const char* file, int line, const char* message, void* userdata) {
+    (void)file;
+    (void)line;
+    LogRing* ring = (LogRing*)userdata;
+    if (!ring) return;
+    ring->levels[ring->next] = level;
+    strncpy(ring->messages[ring->next], message, LOG_MESSAGE_MAX - 1);
+    ring->messages[ring->next][LOG_MESSAGE_MAX - 1] = '\0';
+    ring->next = (ring->next + 1) % LOG_RING_SIZE;
+    if (ring->count < LOG_RING_SIZE) ring->count++;
+}
+
+/**
+ * @brief Returns the i-th oldest message still in the ring (NULL if out of range).
+ *        Read it while no other thread logs, or after set_log_sink has replaced the ring.
+ */
+static inline const char* log_ring_get(const LogRing* ring, int i, LogLevel* level) {
+    if (!ring || i < 0 || i >= ring->count) return NULL;
+    int slot = (ring->next - ring->count + i + LOG_RING_SIZE) % LOG_RING_SIZE;
+    if (level) *level = ring->levels[slot];
+    return ring->messages[slot];
+}
+
+// -------- Configuration --------
+
+static LogSink log_sink_ = log_sink_stderr;
+static void* log_sink_userdata_ = NULL;
+static LogLevel log_runtime_level_ = LOG_LEVEL;
+static SDL_SpinLock log_lock_ = 0;          // Guards every LogSite (short counter updates only)
+static SDL_mutex* log_sink_mutex_ = NULL;   // Guards the sink and its userdata; created on first use
+
+// Returns the sink mutex, creating it once. NULL if creation failed: sinks then run
+// unguarded rather than dropping messages.
+static inline SDL_mutex* log_sink_mutex_get_(void) {
+    SDL_AtomicLock(&log_lock_);
+    if (!log_sink_mutex_) log_sink_mutex_ = SDL_CreateMutex();
+    SDL_mutex* mutex = log_sink_mutex_;
+    SDL_AtomicUnlock(&log_lock_);
+    return mutex;
+}
+
+/**
+ * @brief Routes messages to a sink (NULL restores stderr).
+ * @param userdata Passed to every call, e.g. a LogRing* or FILE*
+ */
+static inline void set_log_sink(LogSink sink, void* userdata) {
+    SDL_mutex* mutex = log_sink_mutex_get_();
+    if (mutex) SDL_LockMutex(mutex);
+    log_sink_ = sink ? sink : log_sink_stderr;
+    log_sink_userdata_ = sink ? userdata : NULL;
+    if (mutex) SDL_UnlockMutex(mutex);
+}
+
+/**
+ * @brief Lowers the level at runtime. Levels stripped at compile time stay stripped.
+ */
+static inline void set_log_level(LogLevel level) {
+    log_runtime_level_ = level;
+}
+
+/**
+ * @brief Opens (appends to) a log file and makes it the sink.
+ * @return The opened file (close it with fclose after set_log_sink(NULL, NULL)), or NULL on failure.
+ */
+static inline FILE* open_log_file(const char* path) {
+    FILE* out = fopen(path, "a");
+    if (out) set_log_sink(log_sink_file, out);
+    return out;
+}
+
+// -------- Emission --------
+
+static inline void log_write_(LogSite* site, LogLevel level, const char* file, int line, const char* fmt, ...) {
+    if (level > log_runtime_level_) return;
+
+    SDL_AtomicLock(&log_lock_);
+    Uint32 now = SDL_GetTicks();
+    if (site->count == 0 || now - site->window_start >= LOG_RATE_WINDOW_MS) {
+        site->window_start = now;
+        site->count = 0;
+    }
+    if (site->count >= LOG_RATE_BURST) {
+        site->suppressed++;
+        SDL_AtomicUnlock(&log_lock_);
+        return;
+    }
+    site->count++;
+    int suppressed = site->suppressed;
+    site->suppressed = 0;
+    SDL_AtomicUnlock(&log_lock_);
+
+    // Formatted outside both locks; only the sink call is serialized
+    char message[LOG_MESSAGE_MAX];
+    va_list args;
+    va_start(args, fmt);
+    int len = vsnprintf(message, sizeof(message), fmt, args);
+    va_end(args);
+
+    if (suppressed > 0 && len >= 0 && len < (int)sizeof(message)) {
+        snprintf(message + len, sizeof(message) - len, " (%d similar messages suppressed)", suppressed);
+    }
+
+    SDL_mutex* mutex = log_sink_mutex_get_();
+    if (mutex) SDL_LockMutex(mutex);
+    log_sink_(level, file, line, message, log_sink_userdata_);
+    if (mutex) SDL_UnlockMutex(mutex);
+}
+
+#define LOG_AT_(level, ...) do { \
+        static LogSite log_site_; \
+        log_write_(&log_site_, level, __FILE__, __LINE__, __VA_ARGS__); \
+    } while (0)
+
+#if LOG_LEVEL >= LOG_LEVEL_ERROR
+#define LOG_ERROR(...) LOG_AT_(LOG_LEVEL_ERROR, __VA_ARGS__)
+#else
+#define LOG_ERROR(...) ((void)0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_WARN
+#define LOG_WARN(...) LOG_AT_(LOG_LEVEL_WARN, __VA_ARGS__)
+#else
+#define LOG_WARN(...) ((void)0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+#define LOG_INFO(...) LOG_AT_(LOG_LEVEL_INFO, __VA_ARGS__)
+#else
+#define LOG_INFO(...) ((void)0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(...) LOG_AT_(LOG_LEVEL_DEBUG, __VA_ARGS__)
+#else
+#define LOG_DEBUG(...) ((void)0)
+#endif
+
+#endif /* LOG_H */
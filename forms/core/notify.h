@@ -0,0 +1,189 @@
+/**
+ * @file notify.h
+ * @brief Coalesced value-change callbacks for interactive widgets.
+ *
+ * A ChangeNotifier sits in a widget (Slider, Drop, Radio) and turns the stream
+ * of changes the user makes into on_change calls at a controlled rate:
+ *  - NOTIFY_PER_FRAME: at most once per main-loop iteration, with the newest value
+ *  - NOTIFY_THROTTLE:  at most once per interval; the newest value is sent when it ends
+ *  - NOTIFY_DEBOUNCE:  once the value has been still for the interval
+ * on_commit runs when the interaction ends (mouse-up after a drag, a click on an
+ * option), right after a final on_change if one is still pending, so the last
+ * value is never lost. Only user input notifies; values set by code do not.
+ */
+
+#ifndef NOTIFY_H
+#define NOTIFY_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+#include "log.h"
+#include "timers.h"
+
+#define MAX_PENDING_NOTIFIERS 64
+
+typedef enum {
+    NOTIFY_PER_FRAME,
+    NOTIFY_THROTTLE,
+    NOTIFY_DEBOUNCE
+} NotifyMode;
+
+/**
+ * @brief Receives the widget that changed, its new value and the registered userdata
+ */
+typedef void (*ChangeFn)(void* widget, int value, void* userdata);
+
+typedef struct {
+    void* widget;            // Passed back to the callbacks
+    ChangeFn on_change;
+    void* change_userdata;
+    ChangeFn on_commit;
+    void* commit_userdata;
+    NotifyMode mode;
+    Uint32 interval_ms;      // Throttle/debounce interval
+    bool pending;            // A change has not been delivered yet
+    int from;                // Value before the pending changes (unchanged overall = no call)
+    bool always;             // Deliver the pending change even if unchanged overall (notify_select_)
+    int value;               // Newest value
+    Uint32 last_sent_ticks;
+    TimerId timer;           // Throttle/debounce deadline
+    bool queued;             // In the per-frame queue
+} ChangeNotifier;
+
+static ChangeNotifier* pending_notifiers_[MAX_PENDING_NOTIFIERS];
+static int pending_notifiers_count_ = 0;
+
+static inline ChangeNotifier new_change_notifier_(void) {
+    ChangeNotifier n = {0};
+    n.mode = NOTIFY_PER_FRAME;
+    return n;
+}
+
+// Calls on_change with the newest value unless the changes cancelled out
+static inline void deliver_change_(ChangeNotifier* n) {
+    if (!n->pending) return;
+    n->pending = false;
+    bool always = n->always;
+    n->always = false;
+    if (n->value == n->from && !always) return;
+    n->last_sent_ticks = SDL_GetTicks();
+    if (n->on_change) n->on_change(n->widget, n->value, n->change_userdata);
+}
+
+static inline void dequeue_notifier_(ChangeNotifier* n) {
+    if (!n->queued) return;
+    for (int i = 0; i < pending_notifiers_count_; i++) {
+        if (pending_notifiers_[i] == n) {
+            pending_notifiers_[i] = pending_notifiers_[--pending_notifiers_count_];
+            break;
+        }
+    }
+    n->queued = false;
+}
+
+static inline void queue_notifier_(ChangeNotifier* n) {
+    if (n->queued) return;
+    if (pending_notifiers_count_ == MAX_PENDING_NOTIFIERS) {
+        deliver_change_(n);  // Queue full: deliver now rather than drop the change
+        return;
+    }
+    pending_notifiers_[pending_notifiers_count_++] = n;
+    n->queued = true;
+}
+
+static inline void on_notifier_timer_(void* userdata) {
+    ChangeNotifier* n = (ChangeNotifier*)userdata;
+    n->timer = 0;
+    deliver_change_(n);
+}
+
+/**
+ * @brief Sets how often on_change may run (interval_ms is ignored for NOTIFY_PER_FRAME).
+ */
+static inline void set_change_rate_(ChangeNotifier* n, NotifyMode mode, Uint32 interval_ms) {
+    n->mode = mode;
+    n->interval_ms = interval_ms;
+}
+
+/**
+ * @brief Records a value changed by the user; on_change follows according to the mode.
+ */
+static inline void notify_change_(ChangeNotifier* n, int old_value, int value) {
+    if (!n->on_change && !n->on_commit) return;
+    if (!n->pending) n->from = old_value;
+    n->value = value;
+    n->pending = true;
+    switch (n->mode) {
+        case NOTIFY_THROTTLE: {
+            if (n->timer) break;  // The newest value goes out when the interval ends
+            Uint32 since = SDL_GetTicks() - n->last_sent_ticks;
+            if (since >= n->interval_ms) {
+                queue_notifier_(n);
+            } else {
+                n->timer = add_timer(n->interval_ms - since, 0, on_notifier_timer_, n);
+                if (!n->timer) queue_notifier_(n);
+            }
+            break;
+        }
+        case NOTIFY_DEBOUNCE:
+            cancel_timer(n->timer);
+            n->timer = add_timer(n->interval_ms, 0, on_notifier_timer_, n);
+            if (!n->timer) queue_notifier_(n);
+            break;
+        case NOTIFY_PER_FRAME:
+        default:
+            queue_notifier_(n);
+            break;
+    }
+}
+
+/**
+ * @brief Records that the user selected the widget (a radio in its group). on_change
+ *        follows like for notify_change_, even if `value` equals the previous one:
+ *        radios of a group often share a value (0 when unbound).
+ */
+static inline void notify_select_(ChangeNotifier* n, int value) {
+    if (!n->on_change && !n->on_commit) return;
+    n->always = true;
+    notify_change_(n, value, value);
+}
+
+/**
+ * @brief Ends an interaction: flushes a pending change, then calls on_commit.
+ */
+static inline void notify_commit_(ChangeNotifier* n, int value) {
+    if (!n->on_change && !n->on_commit) return;
+    cancel_timer(n->timer);
+    n->timer = 0;
+    dequeue_notifier_(n);
+    deliver_change_(n);
+    if (n->on_commit) n->on_commit(n->widget, value, n->commit_userdata);
+}
+
+/**
+ * @brief Delivers the per-frame changes. Called once per iteration by app_run_.
+ */
+static inline void flush_change_notifiers_(void) {
+    // Taken one at a time so a callback freeing another widget also removes it from
+    // the queue; the budget stops callbacks that queue again from looping forever
+    int budget = pending_notifiers_count_;
+    while (budget-- > 0 && pending_notifiers_count_ > 0) {
+        ChangeNotifier* n = pending_notifiers_[0];
+        dequeue_notifier_(n);
+        deliver_change_(n);
+    }
+}
+
+/**
+ * @brief Drops pending notifications; call from the owning widget's free function.
+ */
+static inline void free_change_notifier_(ChangeNotifier* n) {
+    cancel_timer(n->timer);
+    n->timer = 0;
+    dequeue_notifier_(n);
+    n->pending = false;
+    n->always = false;
+}
+
+#endif /* NOTIFY_H */
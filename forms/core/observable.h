@@ -0,0 +1,186 @@
+/**
+ * @file observable.h
+ * @brief Observable values that widgets bind to.
+ *
+ * An Observable holds an int or a string and a list of observers. Setting it to a
+ * different value calls every observer right away; setting the same value does
+ * nothing, which is what stops two-way bindings from echoing. Widgets bound with
+ * bind_slider, bind_entry, bind_drop, bind_radio, bind_progress_bar or bind_text
+ * write user input into the cell and take new values from it, marking only their
+ * own rect dirty, so apps no longer poll widget fields every frame.
+ *
+ * Cells are UI-thread objects; worker threads use post_observable_int/_text,
+ * which go through the update queue (updates.h).
+ */
+
+#ifndef OBSERVABLE_H
+#define OBSERVABLE_H
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "log.h"
+#include "updates.h"
+
+#define OBSERVABLE_MAX_DEPTH 8  // Nested notifications before a feedback loop is assumed
+
+typedef enum {
+    OBSERVABLE_INT,
+    OBSERVABLE_TEXT
+} ObservableKind;
+
+struct Observable;
+
+/**
+ * @brief Called after the cell's value changed
+ */
+typedef void (*ObserverFn)(struct Observable* cell, void* userdata);
+
+typedef struct {
+    ObserverFn fn;       // NULL once removed during a notification (compacted afterwards)
+    void* userdata;
+} ObserverEntry;
+
+typedef struct Observable {
+    ObservableKind kind;
+    int value;                   // OBSERVABLE_INT
+    char* text;                  // OBSERVABLE_TEXT (never NULL once created)
+    ObserverEntry* observers;
+    int observer_count;
+    int observer_capacity;
+    int depth;                   // Notifications in progress (re-entrancy)
+} Observable;
+
+static inline Observable new_observable_int(int value) {
+    Observable cell = {0};
+    cell.kind = OBSERVABLE_INT;
+    cell.value = value;
+    return cell;
+}
+
+static inline Observable new_observable_text(const char* text) {
+    Observable cell = {0};
+    cell.kind = OBSERVABLE_TEXT;
+    cell.text = strdup(text ? text : "");
+    if (!cell.text) {
+        LOG_ERROR("Failed to allocate observable text");
+    }
+    return cell;
+}
+
+static inline int get_observable_int(const Observable* cell) {
+    return cell ? cell->value : 0;
+}
+
+static inline const char* get_observable_text(const Observable* cell) {
+    return cell && cell->text ? cell->text : "";
+}
+
+/**
+ * @brief Registers an observer. It is not called for the current value.
+ */
+static inline bool observe(Observable* cell, ObserverFn fn, void* userdata) {
+    if (!cell || !fn) return false;
+    if (cell->observer_count == cell->observer_capacity) {
+        int capacity = cell->observer_capacity ? cell->observer_capacity * 2 : 4;
+        ObserverEntry* observers = (ObserverEntry*)realloc(cell->observers, sizeof(ObserverEntry) * capacity);
+        if (!observers) {
+            LOG_ERROR("Failed to add observer");
+            return false;
+        }
+        cell->observers = observers;
+        cell->observer_capacity = capacity;
+    }
+    cell->observers[cell->observer_count++] = (ObserverEntry){fn, userdata};
+    return true;
+}
+
+static inline void compact_observers_(Observable* cell) {
+    int kept = 0;
+    for (int i = 0; i < cell->observer_count; i++) {
+        if (cell->observers[i].fn) cell->observers[kept++] = cell->observers[i];
+    }
+    cell->observer_count = kept;
+}
+
+/**
+ * @brief Removes an observer registered with the same function and userdata.
+ *        Safe to call from inside an observer.
+ */
+static inline void unobserve(Observable* cell, ObserverFn fn, void* userdata) {
+    if (!cell) return;
+    for (int i = 0; i < cell->observer_count; i++) {
+        if (cell->observers[i].fn == fn && cell->observers[i].userdata == userdata) {
+            cell->observers[i].fn = NULL;
+            break;
+        }
+    }
+    if (cell->depth == 0) compact_observers_(cell);
+}
+
+static inline void notify_observers_(Observable* cell) {
+    if (cell->depth >= OBSERVABLE_MAX_DEPTH) {
+        LOG_WARN("Observable feedback loop stopped after %d nested changes", OBSERVABLE_MAX_DEPTH);
+        return;
+    }
+    cell->depth++;
+    // Observers added while notifying are not called for this change
+    int count = cell->observer_count;
+    for (int i = 0; i < count; i++) {
+        ObserverEntry entry = cell->observers[i];  // The array may grow (realloc) inside fn
+        if (entry.fn) entry.fn(cell, entry.userdata);
+    }
+    if (--cell->depth == 0) compact_observers_(cell);
+}
+
+static inline void set_observable_int(Observable* cell, int value) {
+    if (!cell || cell->kind != OBSERVABLE_INT || cell->value == value) return;
+    cell->value = value;
+    notify_observers_(cell);
+}
+
+static inline void set_observable_text(Observable* cell, const char* text) {
+    if (!cell || cell->kind != OBSERVABLE_TEXT) return;
+    if (!text) text = "";
+    if (cell->text && strcmp(cell->text, text) == 0) return;
+    char* copy = strdup(text);
+    if (!copy) {
+        LOG_ERROR("Failed to allocate observable text");
+        return;
+    }
+    free(cell->text);
+    cell->text = copy;
+    notify_observers_(cell);
+}
+
+static inline void free_observable(Observable* cell) {
+    if (!cell) return;
+    free(cell->observers);
+    free(cell->text);
+    cell->observers = NULL;
+    cell->text = NULL;
+    cell->observer_count = cell->observer_capacity = 0;
+}
+
+// -------- From other threads --------
+static inline void apply_observable_int_(void* target, WidgetUpdateValue* value) {
+    set_observable_int((Observable*)target, value->i);
+}
+
+static inline void apply_observable_text_(void* target, WidgetUpdateValue* value) {
+    set_observable_text((Observable*)target, value->text);
+}
+
+// Thread-safe set_observable_int; applied on the UI thread, newest value per frame
+static inline void post_observable_int(Observable* cell, int value) {
+    post_widget_update_(cell, apply_observable_int_, (WidgetUpdateValue){.i = value});
+}
+
+static inline void post_observable_text(Observable* cell, const char* text) {
+    char* copy = strdup(text ? text : "");
+    if (!copy) return;
+    post_widget_update_(cell, apply_observable_text_, (WidgetUpdateValue){.text = copy});
+}
+
+#endif /* OBSERVABLE_H */
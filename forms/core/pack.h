@@ -0,0 +1,231 @@
+/**
+ * @file pack.h
+ * @brief Read-only asset pack (fonts, images) mapped into memory.
+ *
+ * A pack is built by tools/pack_assets (see the makefile's `pack` and `embed`
+ * targets) and holds every file under the relative path it was packed with, e.g.
+ * "forms/core/FreeMono.ttf". open_font_ and load_surface_ look names up here first
+ * and read the bytes in place through SDL_RWFromConstMem; names not in the pack
+ * fall back to the filesystem.
+ *
+ * The pack is found, in order: a pack compiled into the binary (FORMS_EMBEDDED_PACK
+ * names the header made by `make embed`), one mounted with mount_asset_pack(), or
+ * ASSET_PACK_FILE next to the executable. Files are mapped with mmap, so only the
+ * pages actually read are loaded.
+ *
+ * Format (little endian):
+ *   header  "FPAK", u32 version, u32 entry count, u32 reserved
+ *   index   entry count x { u32 name offset, u32 name length, u64 data offset, u64 size }
+ *           sorted by name (byte order); offsets are from the start of the pack
+ *   names   concatenated names, each followed by '\0'
+ *   data    file contents, each aligned to ASSET_PACK_ALIGN
+ */
+
+#ifndef PACK_H
+#define PACK_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "log.h"
+
+#define ASSET_PACK_MAGIC "FPAK"
+#define ASSET_PACK_VERSION 1
+#define ASSET_PACK_ALIGN 16
+#define ASSET_PACK_HEADER_SIZE 16
+#define ASSET_PACK_ENTRY_SIZE 24
+#define ASSET_PACK_FILE "assets.pak"  // Looked for next to the executable
+
+#ifdef FORMS_EMBEDDED_PACK
+#include FORMS_EMBEDDED_PACK  // Defines forms_embedded_pack[] and forms_embedded_pack_size
+#endif
+
+/**
+ * @brief A mounted pack: the whole file in memory (mapped, embedded or read)
+ */
+typedef struct {
+    const Uint8* data;
+    size_t size;
+    Uint32 count;     // Index entries
+    bool mapped;      // data came from mmap and must be unmapped
+    bool owned;       // data was malloc'd (no mmap available) and must be freed
+} AssetPack;
+
+static AssetPack asset_pack_;
+static bool asset_pack_searched_ = false;  // Default locations already tried
+
+static inline Uint32 pack_read_u32_(const Uint8* p) {
+    return (Uint32)p[0] | ((Uint32)p[1] << 8) | ((Uint32)p[2] << 16) | ((Uint32)p[3] << 24);
+}
+
+static inline Uint64 pack_read_u64_(const Uint8* p) {
+    return (Uint64)pack_read_u32_(p) | ((Uint64)pack_read_u32_(p + 4) << 32);
+}
+
+// Checks the header and that every index entry stays inside the pack
+static inline bool validate_asset_pack_(const Uint8* data, size_t size, Uint32* count) {
+    if (!data || size < ASSET_PACK_HEADER_SIZE || memcmp(data, ASSET_PACK_MAGIC, 4) != 0) return false;
+    if (pack_read_u32_(data + 4) != ASSET_PACK_VERSION) return false;
+
+    Uint32 n = pack_read_u32_(data + 8);
+    if ((Uint64)n * ASSET_PACK_ENTRY_SIZE > size - ASSET_PACK_HEADER_SIZE) return false;
+    for (Uint32 i = 0; i < n; i++) {
+        const Uint8* e = data + ASSET_PACK_HEADER_SIZE + (size_t)i * ASSET_PACK_ENTRY_SIZE;
+        Uint64 name_off = pack_read_u32_(e), name_len = pack_read_u32_(e + 4);
+        Uint64 data_off = pack_read_u64_(e + 8), data_size = pack_read_u64_(e + 16);
+        if (name_off + name_len + 1 > size || data_off > size || data_size > size - data_off) return false;
+        if (data[name_off + name_len] != '\0') return false;
+    }
+    *count = n;
+    return true;
+}
+
+/**
+ * @brief Unmounts the current pack (fonts opened from it must be closed first).
+ */
+static inline void unmount_asset_pack(void) {
+#ifndef _WIN32
+    if (asset_pack_.mapped) munmap((void*)asset_pack_.data, asset_pack_.size);
+#endif
+    if (asset_pack_.owned) free((void*)asset_pack_.data);
+    memset(&asset_pack_, 0, sizeof(asset_pack_));
+}
+
+/**
+ * @brief Mounts a pack already in memory (e.g. embedded in the binary). Not copied.
+ */
+static inline bool mount_asset_pack_memory(const void* data, size_t size) {
+    Uint32 count;
+    if (!validate_asset_pack_((const Uint8*)data, size, &count)) {
+        LOG_ERROR("Invalid asset pack in memory");
+        return false;
+    }
+    unmount_asset_pack();
+    asset_pack_.data = (const Uint8*)data;
+    asset_pack_.size = size;
+    asset_pack_.count = count;
+    asset_pack_searched_ = true;
+    return true;
+}
+
+/**
+ * @brief Maps a pack file and mounts it, replacing any mounted pack.
+ */
+static inline bool mount_asset_pack(const char* path) {
+    const Uint8* data = NULL;
+    size_t size = 0;
+    bool mapped = false;
+#ifndef _WIN32
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        void* map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map != MAP_FAILED) {
+            data = (const Uint8*)map;
+            size = (size_t)st.st_size;
+            mapped = true;
+        }
+    }
+    close(fd);  // The mapping stays valid
+#else
+    SDL_RWops* rw = SDL_RWFromFile(path, "rb");
+    if (!rw) return false;
+    Sint64 length = SDL_RWsize(rw);
+    Uint8* buffer = length > 0 ? (Uint8*)malloc((size_t)length) : NULL;
+    if (buffer && SDL_RWread(rw, buffer, 1, (size_t)length) == (size_t)length) {
+        data = buffer;
+        size = (size_t)length;
+    } else {
+        free(buffer);
+    }
+    SDL_RWclose(rw);
+#endif
+    Uint32 count;
+    if (!data || !validate_asset_pack_(data, size, &count)) {
+        LOG_ERROR("Invalid asset pack %s", path);
+#ifndef _WIN32
+        if (mapped) munmap((void*)data, size);
+#else
+        free((void*)data);
+#endif
+        return false;
+    }
+    unmount_asset_pack();
+    asset_pack_.data = data;
+    asset_pack_.size = size;
+    asset_pack_.count = count;
+    asset_pack_.mapped = mapped;
+    asset_pack_.owned = !mapped;
+    asset_pack_searched_ = true;
+    LOG_INFO("Mounted asset pack %s (%u files)", path, count);
+    return true;
+}
+
+/**
+ * @brief Mounts the default pack once: the embedded one, else ASSET_PACK_FILE next to the
+ *        executable. Main thread only; loader threads rely on it having run.
+ */
+static inline void ensure_asset_pack_(void) {
+    if (asset_pack_searched_) return;
+    asset_pack_searched_ = true;
+#ifdef FORMS_EMBEDDED_PACK
+    if (mount_asset_pack_memory(forms_embedded_pack, forms_embedded_pack_size)) return;
+#endif
+    char* base = SDL_GetBasePath();
+    if (!base) return;
+    size_t length = strlen(base) + sizeof(ASSET_PACK_FILE);
+    char* path = (char*)malloc(length);
+    if (path) {
+        snprintf(path, length, "%s%s", base, ASSET_PACK_FILE);
+        mount_asset_pack(path);
+        free(path);
+    }
+    SDL_free(base);
+}
+
+/**
+ * @brief Finds a file in the mounted pack (binary search over the sorted index).
+ * @return Pointer into the pack, or NULL if no pack is mounted or the name is not in it
+ */
+static inline const void* find_asset_(const char* name, size_t* size) {
+    if (!asset_pack_.data || !name) return NULL;
+    while (name[0] == '.' && name[1] == '/') name += 2;
+
+    Uint32 lo = 0, hi = asset_pack_.count;
+    while (lo < hi) {
+        Uint32 mid = lo + (hi - lo) / 2;
+        const Uint8* e = asset_pack_.data + ASSET_PACK_HEADER_SIZE + (size_t)mid * ASSET_PACK_ENTRY_SIZE;
+        int cmp = strcmp(name, (const char*)asset_pack_.data + pack_read_u32_(e));
+        if (cmp == 0) {
+            if (size) *size = (size_t)pack_read_u64_(e + 16);
+            return asset_pack_.data + pack_read_u64_(e + 8);
+        }
+        if (cmp < 0) hi = mid;
+        else lo = mid + 1;
+    }
+    return NULL;
+}
+
+/**
+ * @brief Opens a read-only stream over a packed file without copying it.
+ * @return Stream to close (or hand to an *_RW loader with freesrc = 1), or NULL if not packed
+ */
+static inline SDL_RWops* open_asset_(const char* name) {
+    size_t size = 0;
+    const void* data = find_asset_(name, &size);
+    return data ? SDL_RWFromConstMem(data, (int)size) : NULL;
+}
+
+#endif /* PACK_H */
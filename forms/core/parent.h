@@ -13,8 +13,12 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <math.h>
 
 #include "color.h"
+#include "log.h"     // LOG_ERROR/LOG_WARN/LOG_INFO/LOG_DEBUG
+#include "startup.h" // Time-to-first-frame report
+#include "damage.h"  // Dirty regions and partial redraw
 
 // Assume Color is defined elsewhere; if not, define it here.
 // typedef struct { uint8_t r, g, b, a; } Color;
@@ -32,10 +36,12 @@ typedef struct {
  * @brief This struct represents both root windows and containers.
  *        For root windows, is_window is 1 and SDL fields in Base are initialized.
  *        For containers, is_window is 0 and Base fields are NULL.
+ *        Containers may be nested: parent points at the enclosing window or container.
  */
-typedef struct {
+typedef struct Parent {
     Base base;                 // Holds SDL_Window + SDL_Renderer
     int is_window;             // 1 for root window, 0 for container
+    struct Parent* parent;     // Enclosing window or container (NULL for root window)
     int x, y, w, h;            // Position and size (x,y=0 for root window)
     Color color;               // Background color (transparent for root window)
     int moveable;              // Can be moved (0 for root window)
@@ -50,8 +56,208 @@ typedef struct {
     int resize_zone;           // Size of edge zone for resizing
     bool is_open;              // Is open (true for root window)
     int title_height;          // Height of title bar (0 for root window)
+
+    // Scrolling (containers)
+    bool scrollable;           // Content can be scrolled with the wheel and scrollbars
+    int scroll_x, scroll_y;    // Content offset (logical)
+    int content_w, content_h;  // Logical extent of the children (grown before each frame is recorded, set by layouts)
+    int scroll_drag;           // Scrollbar thumb being dragged: 0 = none, 1 = vertical, 2 = horizontal
+    int scroll_drag_offset;    // Mouse offset inside the dragged thumb (physical)
+
+    // Cached world transform, rebuilt by update_parent_transform() only when
+    // this node's geometry, an ancestor's transform or the DPI scale changes.
+    int abs_x, abs_y;          // Absolute logical position (ancestor offsets applied)
+    int content_x, content_y;  // Absolute logical origin of children (below the title bar)
+    SDL_Rect screen_rect;      // Absolute physical rect of the whole node
+    SDL_Rect clip_rect;        // Physical clip for children (body intersected with ancestor clips)
+    Uint32 transform_version;  // Changes every time the cached transform is rebuilt (0 = never built)
+    Uint32 cached_parent_version; // Parent transform version the cache was built against
+    int cached_x, cached_y, cached_w, cached_h, cached_title_height; // Geometry the cache was built from
+    int cached_scroll_x, cached_scroll_y; // Scroll offset the cache was built with
+    float cached_dpi;          // DPI scale the cache was built with
+
+    struct Layout* layout;     // Layout arranging this node's children (NULL = manual placement)
+    int z_index;               // Draw order among containers (-1 = window or unregistered)
+    int draw_slot;             // Its draw lists in the frame being recorded (see frame.h; 0 = shared)
 } Parent;
 
+/**
+ * @brief Cached physical rect of a widget inside a Parent.
+ *        Rebuilt only when the widget's logical geometry or its parent's transform changes.
+ */
+typedef struct {
+    Uint32 parent_version;     // Parent transform version the rect was built against (0 = never)
+    int x, y, w, h;            // Logical geometry the rect was built from
+    SDL_Rect rect;             // Absolute physical rect
+} ChildRect;
+
+static Uint32 transform_version_counter_ = 0;
+
+/**
+ * @brief Refreshes the cached absolute rects of a window or container.
+ *        Ancestors are refreshed first; nothing is recomputed when neither this
+ *        node nor any ancestor moved, resized or changed DPI.
+ * @param p The window or container to refresh.
+ */
+static inline void update_parent_transform(Parent* p) {
+    if (!p) return;
+
+    Parent* up = p->is_window ? NULL : p->parent;
+    if (up) {
+        update_parent_transform(up);
+        p->base.dpi_scale = up->base.dpi_scale;  // Containers follow their ancestors' DPI
+    }
+    Uint32 up_version = up ? up->transform_version : 0;
+    float dpi = p->base.dpi_scale;
+
+    if (p->transform_version != 0 &&
+        p->cached_parent_version == up_version &&
+        p->cached_x == p->x && p->cached_y == p->y &&
+        p->cached_w == p->w && p->cached_h == p->h &&
+        p->cached_title_height == p->title_height &&
+        p->cached_scroll_x == p->scroll_x && p->cached_scroll_y == p->scroll_y &&
+        p->cached_dpi == dpi) {
+        return;  // Cache still valid
+    }
+
+    p->abs_x = up ? up->content_x + p->x : 0;
+    p->abs_y = up ? up->content_y + p->y : 0;
+    p->content_x = p->abs_x - p->scroll_x;
+    p->content_y = p->abs_y + p->title_height - p->scroll_y;
+
+    p->screen_rect.x = (int)roundf(p->abs_x * dpi);
+    p->screen_rect.y = (int)roundf(p->abs_y * dpi);
+    p->screen_rect.w = (int)roundf(p->w * dpi);
+    p->screen_rect.h = (int)roundf(p->h * dpi);
+
+    SDL_Rect body = {p->screen_rect.x,
+                     (int)roundf((p->abs_y + p->title_height) * dpi),
+                     p->screen_rect.w,
+                     (int)roundf((p->h - p->title_height) * dpi)};
+    if (up && !up->is_window) {
+        if (!SDL_IntersectRect(&body, &up->clip_rect, &p->clip_rect)) {
+            p->clip_rect = (SDL_Rect){body.x, body.y, 0, 0};  // Fully clipped away
+        }
+    } else {
+        p->clip_rect = body;
+    }
+
+    p->cached_parent_version = up_version;
+    p->cached_x = p->x;
+    p->cached_y = p->y;
+    p->cached_w = p->w;
+    p->cached_h = p->h;
+    p->cached_title_height = p->title_height;
+    p->cached_scroll_x = p->scroll_x;
+    p->cached_scroll_y = p->scroll_y;
+    p->cached_dpi = dpi;
+
+    // A nested container is part of its parent's scrollable content
+    if (up) {
+        if (p->x + p->w > up->content_w) up->content_w = p->x + p->w;
+        if (p->y + p->h > up->content_h) up->content_h = p->y + p->h;
+    }
+    p->transform_version = ++transform_version_counter_;
+}
+
+/**
+ * @brief Returns the cached absolute physical rect of a child widget.
+ * @param parent The widget's parent (its transform must be up to date).
+ * @param cache  The widget's ChildRect cache.
+ * @param x, y   Logical position relative to the parent's content origin.
+ * @param w, h   Logical size.
+ */
+static inline SDL_Rect get_child_rect(Parent* parent, ChildRect* cache, int x, int y, int w, int h) {
+    if (cache->parent_version != parent->transform_version ||
+        cache->x != x || cache->y != y || cache->w != w || cache->h != h) {
+        float dpi = parent->base.dpi_scale;
+        cache->rect.x = (int)roundf((parent->content_x + x) * dpi);
+        cache->rect.y = (int)roundf((parent->content_y + y) * dpi);
+        cache->rect.w = (int)roundf(w * dpi);
+        cache->rect.h = (int)roundf(h * dpi);
+        cache->parent_version = parent->transform_version;
+        cache->x = x;
+        cache->y = y;
+        cache->w = w;
+        cache->h = h;
+    }
+    return cache->rect;
+}
+
+/**
+ * @brief Grows a parent's scrollable extent to cover a child's logical rect.
+ *        Single-threaded, before recording (update_content_extents_ in frame.h):
+ *        draw-list jobs read the extent while get_child_rect runs on several threads.
+ */
+static inline void grow_parent_content_(Parent* parent, int x, int y, int w, int h) {
+    if (!parent) return;
+    if (x + w > parent->content_w) parent->content_w = x + w;
+    if (y + h > parent->content_h) parent->content_h = y + h;
+}
+
+/**
+ * @brief Checks whether a physical rect intersects its parent's viewport.
+ *        Widgets use it to skip rendering and hit testing while scrolled or clipped away.
+ */
+static inline bool is_child_visible(Parent* parent, SDL_Rect rect) {
+    SDL_Rect box = rect;
+    // Zero-sized boxes (e.g. position-only widgets) still count if their point is inside
+    if (box.w <= 0) box.w = 1;
+    if (box.h <= 0) box.h = 1;
+    return SDL_HasIntersection(&box, &parent->clip_rect);
+}
+
+/**
+ * @brief Schedules a redraw of a child's physical rect, limited to what its parent shows.
+ *        Widgets call it when their own state changes outside of input handling.
+ */
+static inline void mark_child_dirty(Parent* parent, SDL_Rect rect) {
+    if (!parent) return;
+    SDL_Rect visible;
+    if (SDL_IntersectRect(&rect, &parent->clip_rect, &visible)) mark_dirty_rect(visible);
+}
+
+/**
+ * @brief Checks whether a physical point lies inside a parent's viewport.
+ *        Keeps parts of children scrolled under the title bar or edges from being clicked.
+ */
+static inline bool is_point_in_parent_clip(Parent* parent, int x, int y) {
+    SDL_Point point = {x, y};
+    return SDL_PointInRect(&point, &parent->clip_rect);
+}
+
+/**
+ * @brief Logical-coordinate variant of is_point_in_parent_clip, for widgets that hit test in logical units.
+ */
+static inline bool is_logical_point_in_parent_clip(Parent* parent, int x, int y) {
+    float dpi = parent->base.dpi_scale;
+    return is_point_in_parent_clip(parent, (int)roundf(x * dpi), (int)roundf(y * dpi));
+}
+
+/**
+ * @brief Checks that a window/container and all of its ancestors are open.
+ */
+static inline bool is_parent_open(Parent* p) {
+    while (p) {
+        if (!p->is_open) return false;
+        p = p->is_window ? NULL : p->parent;
+    }
+    return true;
+}
+
+/**
+ * @brief Event filter that drops event classes no widget consumes
+ *        (joystick, controller, touch, gesture, drag-and-drop, audio devices, sensors),
+ *        so they never reach the queue. Install your own filter after new_window to receive them.
+ */
+static int drop_unused_events_(void* userdata, SDL_Event* event) {
+    (void)userdata;
+    Uint32 type = event->type;
+    if (type >= SDL_JOYAXISMOTION && type < SDL_CLIPBOARDUPDATE) return 0;   // Joystick, controller, touch, gesture
+    if (type >= SDL_DROPFILE && type < SDL_RENDER_TARGETS_RESET) return 0;   // Drop, audio device, sensor
+    return 1;
+}
+
 /**
  * @brief Creates a new root window as a Parent struct.
  * @param title The title of the window.
@@ -63,42 +269,38 @@ static inline Parent new_window(char* title, int w, int h) {
     // Enable DPI scaling hint for Windows
   SDL_SetHint(SDL_HINT_WINDOWS_DPI_SCALING, "1");
 
-    if (SDL_Init(SDL_INIT_EVERYTHING) < 0) {
-        printf("SDL initialization failed: %s\n", SDL_GetError());
-    }
+    startup_begin_();
 
-    if (TTF_Init() == -1) {
-        printf("TTF initialization failed: %s\n", TTF_GetError());
-        SDL_Quit();
+    // Only video and events; TTF and image codecs start on first use (see graphics.h)
+    Uint64 phase_start = startup_mark_();
+    if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_EVENTS) < 0) {
+        LOG_ERROR("SDL initialization failed: %s", SDL_GetError());
     }
-    
-    // init sdl image
-    int imgFlags = IMG_INIT_JPG | IMG_INIT_PNG | IMG_INIT_WEBP; // we can add more format support in the future
-	int initted = IMG_Init(imgFlags);
-	if ((initted & imgFlags) != imgFlags) {
-    printf("Warning: Not all image formats were initialized! IMG_Error: %s\n", IMG_GetError());
-	}
-//
+    SDL_SetEventFilter(drop_unused_events_, NULL);
+    startup_add_(STARTUP_SDL_INIT, phase_start);
 
+    phase_start = startup_mark_();
     SDL_Window* sdl_win = SDL_CreateWindow(title,
                                            SDL_WINDOWPOS_CENTERED,
                                            SDL_WINDOWPOS_CENTERED,
                                            w, h,
-                                           SDL_WINDOW_SHOWN | SDL_WINDOW_ALLOW_HIGHDPI);  // Enable high DPI
+                                           SDL_WINDOW_SHOWN | SDL_WINDOW_ALLOW_HIGHDPI | SDL_WINDOW_RESIZABLE);  // Enable high DPI
     if (!sdl_win) {
-        printf("Window creation failed: %s\n", SDL_GetError());
+        LOG_ERROR("Window creation failed: %s", SDL_GetError());
         TTF_Quit();
         SDL_Quit();
     }
 
     SDL_Renderer* sdl_ren = SDL_CreateRenderer(sdl_win, -1, SDL_RENDERER_ACCELERATED);
     if (!sdl_ren) {
-        printf("Renderer creation failed: %s\n", SDL_GetError());
+        LOG_ERROR("Renderer creation failed: %s", SDL_GetError());
         SDL_DestroyWindow(sdl_win);
         TTF_Quit();
         SDL_Quit();
     }
 
+    startup_add_(STARTUP_WINDOW, phase_start);
+
     // Compute DPI scale (use width for uniform assumption)
     int pw, ph;
     SDL_GetRendererOutputSize(sdl_ren, &pw, &ph);
@@ -110,15 +312,70 @@ static inline Parent new_window(char* title, int w, int h) {
     parent.base.sdl_renderer = sdl_ren;
     parent.base.dpi_scale = dpi_scale > 1.0f ? dpi_scale : 1.0f;  // Minimum 1.0
     parent.is_window = 1;
+    parent.parent = NULL;
+    parent.x = 0;
+    parent.y = 0;
     parent.w = w;
     parent.h = h;
     parent.color = COLOR_GRAY;
     parent.is_open = true;
     parent.title_height=0;
+    parent.scrollable = false;
+    parent.scroll_x = 0;
+    parent.scroll_y = 0;
+    parent.content_w = 0;
+    parent.content_h = 0;
+    parent.scroll_drag = 0;
+    parent.scroll_drag_offset = 0;
+    parent.layout = NULL;
+    parent.z_index = -1;
+    parent.draw_slot = 0;
+    parent.transform_version = 0;
+    update_parent_transform(&parent);
 
+    startup_widgets_begin_();  // Everything until app_run_ counts as widget construction
     return parent;
 }
 
+/**
+ * @brief Applies a window size measured elsewhere (the render thread in pipelined mode,
+ *        which owns the renderer; see app.h). Same result as update_window_metrics.
+ * @param w, h Logical size (SDL_GetWindowSize)
+ * @param pw Physical width (SDL_GetRendererOutputSize)
+ * @return true if the logical size or the DPI scale changed.
+ */
+static inline bool set_window_metrics_(Parent* window, int w, int h, int pw) {
+    if (!window || !window->is_window) return false;
+    float dpi_scale = w > 0 ? (float)pw / w : 1.0f;
+    if (dpi_scale < 1.0f) dpi_scale = 1.0f;
+
+    if (w == window->w && h == window->h && dpi_scale == window->base.dpi_scale) return false;
+
+    window->w = w;
+    window->h = h;
+    window->base.dpi_scale = dpi_scale;  // Containers inherit it in update_parent_transform()
+    update_parent_transform(window);
+    return true;
+}
+
+/**
+ * @brief Tracks size and DPI changes of a root window.
+ *        Call with every event; only SDL_WINDOWEVENT_SIZE_CHANGED does any work.
+ *        Layouts attached to the window pick up the new size on their next update.
+ * @param window The root window.
+ * @param event The SDL event to inspect.
+ * @return true if the logical size or the DPI scale changed.
+ */
+static inline bool update_window_metrics(Parent* window, SDL_Event event) {
+    if (!window || !window->is_window) return false;
+    if (event.type != SDL_WINDOWEVENT || event.window.event != SDL_WINDOWEVENT_SIZE_CHANGED) return false;
+
+    int w, h, pw, ph;
+    SDL_GetWindowSize(window->base.sdl_window, &w, &h);  // Logical size
+    SDL_GetRendererOutputSize(window->base.sdl_renderer, &pw, &ph);  // Physical size
+    return set_window_metrics_(window, w, h, pw);
+}
+
 /**
  * @brief Destroys the Parent struct, cleaning up SDL resources if it's a root window.
  * @param parent Pointer to the Parent to destroy.
@@ -142,8 +399,8 @@ static inline void destroy_parent(Parent* parent) {
 }
 
 //=============== children helper func ====================
+// Physical clip rect for children of p (its body, intersected with all ancestor clips)
 SDL_Rect  get_parent_rect(Parent *p){
-	SDL_Rect rect ={p->x, p->y,p->w,p->h};
-	return rect;
+	return p->clip_rect;
 }
 #endif /* API_H */
@@ -0,0 +1,278 @@
+/**
+ * @file snapshot.h
+ * @brief Immutable frame snapshots handed from the update thread to the render thread.
+ *
+ * In pipelined mode (set_pipelined_rendering, app.h) events, widgets and timers run
+ * on an update thread that records every frame into a FrameSnapshot: the frame's
+ * draw lists (frame.h) concatenated in draw order, with each text command already
+ * rasterized into a surface, so SDL_ttf never leaves the update thread. The thread
+ * that owns the renderer only uploads those surfaces and replays the list. Image
+ * draws are TEXTURE commands that hold a reference to their texture cache entry
+ * until the snapshot is reused; the render thread uploads an entry's pixels the
+ * first time it draws it (deferred uploads, graphics.h). Nothing else in a snapshot
+ * points into widget memory, so the update thread moves on to the next frame while
+ * the render thread is still presenting this one.
+ *
+ * Three snapshots rotate through a lock-free mailbox: the writer fills the back
+ * one, the reader draws the front one, and the middle one holds the newest
+ * published frame. Publishing swaps back and middle; acquiring swaps front and
+ * middle when a new frame is there. Neither side waits for the other: a slow
+ * present only means that frames in between are skipped, and input keeps being
+ * handled at its own pace.
+ */
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "color.h"
+#include "drawlist.h"
+#include "graphics.h"  // open_font_, FONT_FILE
+#include "log.h"
+
+#define FRAME_SNAPSHOTS 3
+#define SNAPSHOT_FRESH 4  // Flag in FrameMailbox.middle: the middle snapshot was not drawn yet
+
+/**
+ * @brief One recorded frame; owns everything it draws
+ */
+typedef struct {
+    DrawList list;            // Whole frame; text is baked into SURFACE commands
+    SDL_Surface** surfaces;   // Baked text (freed when the writer reuses the snapshot)
+    int surface_count, surface_capacity;
+    Color clear_color;
+    Uint32 sequence;          // 1 for the first published frame
+} FrameSnapshot;
+
+/**
+ * @brief Triple buffer between exactly one writer and one reader thread
+ */
+typedef struct {
+    FrameSnapshot snapshots[FRAME_SNAPSHOTS];
+    SDL_atomic_t middle;      // Index of the middle snapshot, | SNAPSHOT_FRESH once published
+    int back;                 // Writer only
+    int front;                // Reader only
+    Uint32 published;         // Writer only
+    Uint32 wake_event;        // Pushed on publish to wake the reader (0 = none registered)
+} FrameMailbox;
+
+static FrameMailbox frame_mailbox_ = {.middle = {1}, .back = 0, .front = 2};
+
+// Hands our snapshot to the other side and takes the middle one
+static inline int swap_middle_snapshot_(int value) {
+    SDL_MemoryBarrierRelease();  // Our writes to the snapshot we hand over come first
+    int old = SDL_AtomicSet(&frame_mailbox_.middle, value);
+    SDL_MemoryBarrierAcquire();  // And we see the other side's writes to the one we get
+    return old;
+}
+
+/**
+ * @brief Registers the wake-up event. Call on the render thread before the writer starts.
+ */
+static inline void start_frame_mailbox_(void) {
+    if (frame_mailbox_.wake_event) return;
+    Uint32 type = SDL_RegisterEvents(1);
+    if (type == (Uint32)-1) {
+        LOG_WARN("No event left for frame snapshots; the render thread polls instead");
+        return;
+    }
+    frame_mailbox_.wake_event = type;
+}
+
+static inline void free_snapshot_surfaces_(FrameSnapshot* snapshot) {
+    for (int i = 0; i < snapshot->surface_count; i++) SDL_FreeSurface(snapshot->surfaces[i]);
+    snapshot->surface_count = 0;
+}
+
+// Each image command keeps its entry alive (and its texture unfreed) while the render thread may draw it
+static inline void hold_snapshot_textures_(FrameSnapshot* snapshot) {
+    for (int i = 0; i < snapshot->list.cmd_count; i++) {
+        DrawCmd* cmd = &snapshot->list.cmds[i];
+        if (cmd->kind == DRAW_CMD_TEXTURE && cmd->entry) cmd->entry->ref_count++;
+    }
+}
+
+static inline void release_snapshot_textures_(FrameSnapshot* snapshot) {
+    for (int i = 0; i < snapshot->list.cmd_count; i++) {
+        DrawCmd* cmd = &snapshot->list.cmds[i];
+        if (cmd->kind == DRAW_CMD_TEXTURE && cmd->entry) release_texture_(cmd->entry);
+    }
+}
+
+/**
+ * @brief Starts recording the next frame into the back snapshot. Writer only.
+ */
+static inline FrameSnapshot* begin_frame_snapshot_(Color clear_color) {
+    FrameSnapshot* snapshot = &frame_mailbox_.snapshots[frame_mailbox_.back];
+    release_snapshot_textures_(snapshot);  // The reader gave this one back
+    free_snapshot_surfaces_(snapshot);
+    clear_draw_list_(&snapshot->list);
+    snapshot->clear_color = clear_color;
+    return snapshot;
+}
+
+// Keeps a baked surface alive as long as the snapshot; false (surface freed) if out of memory
+static inline bool keep_snapshot_surface_(FrameSnapshot* snapshot, SDL_Surface* surface) {
+    if (snapshot->surface_count == snapshot->surface_capacity) {
+        int capacity = snapshot->surface_capacity ? snapshot->surface_capacity * 2 : 32;
+        SDL_Surface** grown = (SDL_Surface**)realloc(snapshot->surfaces, sizeof(SDL_Surface*) * capacity);
+        if (!grown) {
+            SDL_FreeSurface(surface);
+            return false;
+        }
+        snapshot->surfaces = grown;
+        snapshot->surface_capacity = capacity;
+    }
+    snapshot->surfaces[snapshot->surface_count++] = surface;
+    return true;
+}
+
+/**
+ * @brief Rasterizes every TEXT command into a SURFACE command placed the way
+ *        submit_draw_list_ would draw it. Writer only (it owns SDL_ttf).
+ */
+static inline void bake_snapshot_text_(FrameSnapshot* snapshot) {
+    DrawList* list = &snapshot->list;
+    TTF_Font* font = NULL;  // Kept open while consecutive texts share file and size
+    const char* open_file = NULL;
+    int open_size = 0;
+    for (int i = 0; i < list->cmd_count; i++) {
+        DrawCmd* cmd = &list->cmds[i];
+        if (cmd->kind != DRAW_CMD_TEXT) continue;
+        const char* text = list->chars + cmd->first;
+        if (!text[0]) continue;  // Nothing to draw
+
+        const char* font_file = cmd->font_file ? cmd->font_file : FONT_FILE;
+        if (!font || font_file != open_file || cmd->font_size != open_size) {
+            if (font) TTF_CloseFont(font);
+            font = open_font_(font_file, cmd->font_size);
+            open_file = font_file;
+            open_size = cmd->font_size;
+            if (!font) {
+                LOG_ERROR("Failed to load font '%s': %s", font_file, TTF_GetError());
+                continue;
+            }
+        }
+
+        SDL_Color color = {cmd->color.r, cmd->color.g, cmd->color.b, cmd->color.a};
+        SDL_Surface* surface = TTF_RenderText_Solid(font, text, color);
+        if (!surface) {
+            LOG_ERROR("Failed to render text: %s", TTF_GetError());
+            continue;
+        }
+        if (!keep_snapshot_surface_(snapshot, surface)) {
+            list->failed = true;
+            continue;
+        }
+
+        int x = cmd->rect.x;
+        int y = cmd->rect.y;
+        if (cmd->center) {
+            x += (cmd->rect.w - surface->w) / 2;
+            y += (cmd->rect.h - surface->h) / 2;
+        } else if (cmd->align == ALIGN_CENTER) {
+            x -= surface->w / 2;
+        } else if (cmd->align == ALIGN_RIGHT) {
+            x -= surface->w;
+        }
+        cmd->kind = DRAW_CMD_SURFACE;
+        cmd->surface = surface;
+        cmd->rect = (SDL_Rect){x, y, surface->w, surface->h};
+    }
+    if (font) TTF_CloseFont(font);
+}
+
+/**
+ * @brief Makes the back snapshot the newest frame and wakes the reader. Writer only.
+ */
+static inline void publish_frame_snapshot_(void) {
+    FrameMailbox* mailbox = &frame_mailbox_;
+    mailbox->snapshots[mailbox->back].sequence = ++mailbox->published;
+    mailbox->back = swap_middle_snapshot_(mailbox->back | SNAPSHOT_FRESH) & ~SNAPSHOT_FRESH;
+
+    if (mailbox->wake_event) {
+        SDL_Event wake;
+        SDL_zero(wake);
+        wake.type = mailbox->wake_event;
+        SDL_PushEvent(&wake);
+    }
+}
+
+/**
+ * @brief Takes the newest published frame. Reader only.
+ * @return NULL if nothing was published since the last call
+ */
+static inline FrameSnapshot* acquire_frame_snapshot_(void) {
+    FrameMailbox* mailbox = &frame_mailbox_;
+    if (!(SDL_AtomicGet(&mailbox->middle) & SNAPSHOT_FRESH)) return NULL;
+    mailbox->front = swap_middle_snapshot_(mailbox->front) & ~SNAPSHOT_FRESH;
+    return &mailbox->snapshots[mailbox->front];
+}
+
+/**
+ * @brief Draws a snapshot on its own, unclipped by damage, and presents it. Reader only.
+ */
+static inline void present_frame_snapshot_(SDL_Renderer* renderer, const FrameSnapshot* snapshot) {
+    const DrawList* list = &snapshot->list;
+    Color clear = snapshot->clear_color;
+    SDL_RenderSetClipRect(renderer, NULL);
+    SDL_SetRenderDrawColor(renderer, clear.r, clear.g, clear.b, clear.a);
+    SDL_RenderClear(renderer);
+
+    for (int i = 0; i < list->cmd_count; i++) {
+        const DrawCmd* cmd = &list->cmds[i];
+        switch (cmd->kind) {
+            case DRAW_CMD_CLIP:
+                SDL_RenderSetClipRect(cmd->renderer, cmd->has_clip ? &cmd->rect : NULL);
+                break;
+            case DRAW_CMD_SPANS:
+                SDL_SetRenderDrawColor(cmd->renderer, cmd->color.r, cmd->color.g, cmd->color.b, cmd->color.a);
+                SDL_RenderFillRects(cmd->renderer, &list->spans[cmd->first], cmd->count);
+                break;
+            case DRAW_CMD_SURFACE: {
+                SDL_Texture* texture = SDL_CreateTextureFromSurface(cmd->renderer, cmd->surface);
+                if (!texture) {
+                    LOG_ERROR("Failed to create texture from text surface: %s", SDL_GetError());
+                    break;
+                }
+                SDL_RenderCopy(cmd->renderer, texture, NULL, &cmd->rect);
+                SDL_DestroyTexture(texture);
+                break;
+            }
+            case DRAW_CMD_TEXTURE: {
+                if (cmd->entry) upload_deferred_texture_(cmd->entry);  // First draw of a freshly decoded image
+                SDL_Rect src, dst;
+                SDL_Texture* texture = texture_cmd_target_(cmd, &src, &dst);
+                if (texture) SDL_RenderCopy(cmd->renderer, texture, &src, &dst);
+                break;
+            }
+            case DRAW_CMD_TEXT:  // Could not be baked; already reported by the writer
+                break;
+        }
+    }
+    SDL_RenderSetClipRect(renderer, NULL);
+    SDL_RenderPresent(renderer);
+}
+
+/**
+ * @brief Frees all snapshots (at shutdown, once the writer has stopped).
+ */
+static inline void free_frame_snapshots_(void) {
+    for (int i = 0; i < FRAME_SNAPSHOTS; i++) {
+        release_snapshot_textures_(&frame_mailbox_.snapshots[i]);
+        free_snapshot_surfaces_(&frame_mailbox_.snapshots[i]);
+        free(frame_mailbox_.snapshots[i].surfaces);
+        free_draw_list_(&frame_mailbox_.snapshots[i].list);
+        frame_mailbox_.snapshots[i] = (FrameSnapshot){0};
+    }
+    SDL_AtomicSet(&frame_mailbox_.middle, 1);
+    frame_mailbox_.back = 0;
+    frame_mailbox_.front = 2;
+    frame_mailbox_.published = 0;
+}
+
+#endif /* SNAPSHOT_H */
@@ -0,0 +1,141 @@
+/**
+ * @file startup.h
+ * @brief Time-to-first-frame instrumentation.
+ *
+ * Startup is split into phases measured with SDL_GetPerformanceCounter: SDL init,
+ * window/renderer creation, font loads, image decodes, widget construction (the
+ * time between the window and app_run_ not already spent loading fonts/images),
+ * first layout, first render and first present. Recording stops once the first
+ * frame is presented, so steady-state font opens and decodes cost only a flag check.
+ * Fonts opened while drawing the first frame count in both "Font loads" and "First render".
+ */
+
+#ifndef STARTUP_H
+#define STARTUP_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+/**
+ * @brief Startup phases, in the order they normally happen
+ */
+typedef enum {
+    STARTUP_SDL_INIT,       // SDL_Init (video + events)
+    STARTUP_WINDOW,         // Window and renderer creation
+    STARTUP_FONT_LOAD,      // TTF init and every font opened before the first present
+    STARTUP_IMAGE_DECODE,   // Codec init and every image decoded before the first present
+    STARTUP_WIDGETS,        // Widget construction, excluding fonts/images counted above
+    STARTUP_FIRST_LAYOUT,   // Layouts and transforms of the first frame
+    STARTUP_FIRST_RENDER,   // Drawing the first frame
+    STARTUP_FIRST_PRESENT,  // SDL_RenderPresent of the first frame
+    STARTUP_PHASE_COUNT
+} StartupPhase;
+
+/**
+ * @brief Startup timings (milliseconds) up to the first presented frame
+ */
+typedef struct {
+    double phase_ms[STARTUP_PHASE_COUNT];
+    int phase_count[STARTUP_PHASE_COUNT];  // Occurrences (e.g. number of fonts opened)
+    double total_ms;        // From init_app (or new_window) to the first present
+    bool complete;          // First frame presented; the report no longer changes
+
+    // Internal bookkeeping
+    Uint64 start;           // Counter when recording began (0 = not started)
+    Uint64 widgets_start;   // Counter when the window was ready
+    double loads_at_widgets_start; // Font + image ms already recorded at widgets_start
+} StartupReport;
+
+static StartupReport startup_report_;
+
+static inline Uint64 startup_now_(void) {
+    return SDL_GetPerformanceCounter();
+}
+
+static inline double startup_ms_(Uint64 from, Uint64 to) {
+    return (double)(to - from) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+}
+
+/**
+ * @brief Starts the startup clock (first call wins).
+ */
+static inline void startup_begin_(void) {
+    if (!startup_report_.start) startup_report_.start = startup_now_();
+}
+
+/**
+ * @brief Returns a start timestamp for startup_add_, or 0 once the report is complete.
+ */
+static inline Uint64 startup_mark_(void) {
+    return startup_report_.complete ? 0 : startup_now_();
+}
+
+/**
+ * @brief Adds the time since `since` (from startup_mark_) to a phase.
+ */
+static inline void startup_add_(StartupPhase phase, Uint64 since) {
+    if (!since || startup_report_.complete) return;
+    startup_report_.phase_ms[phase] += startup_ms_(since, startup_now_());
+    startup_report_.phase_count[phase]++;
+}
+
+// Called once the window exists: widget construction starts here
+static inline void startup_widgets_begin_(void) {
+    if (startup_report_.complete) return;
+    startup_report_.widgets_start = startup_now_();
+    startup_report_.loads_at_widgets_start = startup_report_.phase_ms[STARTUP_FONT_LOAD] +
+                                             startup_report_.phase_ms[STARTUP_IMAGE_DECODE];
+}
+
+// Called when app_run_ starts: whatever wasn't font/image loading was widget construction
+static inline void startup_widgets_end_(void) {
+    if (startup_report_.complete || !startup_report_.widgets_start) return;
+    double loads = startup_report_.phase_ms[STARTUP_FONT_LOAD] +
+                   startup_report_.phase_ms[STARTUP_IMAGE_DECODE] -
+                   startup_report_.loads_at_widgets_start;
+    double ms = startup_ms_(startup_report_.widgets_start, startup_now_()) - loads;
+    startup_report_.phase_ms[STARTUP_WIDGETS] = ms > 0 ? ms : 0;
+    startup_report_.phase_count[STARTUP_WIDGETS] = 1;
+}
+
+// Called right after the first present; freezes the report
+static inline void startup_complete_(void) {
+    if (startup_report_.complete) return;
+    if (startup_report_.start) {
+        startup_report_.total_ms = startup_ms_(startup_report_.start, startup_now_());
+    }
+    startup_report_.complete = true;
+}
+
+static inline const char* startup_phase_name(StartupPhase phase) {
+    switch (phase) {
+        case STARTUP_SDL_INIT:      return "SDL init";
+        case STARTUP_WINDOW:        return "Window + renderer";
+        case STARTUP_FONT_LOAD:     return "Font loads";
+        case STARTUP_IMAGE_DECODE:  return "Image decodes";
+        case STARTUP_WIDGETS:       return "Widget construction";
+        case STARTUP_FIRST_LAYOUT:  return "First layout";
+        case STARTUP_FIRST_RENDER:  return "First render";
+        case STARTUP_FIRST_PRESENT: return "First present";
+        default:                    return "?";
+    }
+}
+
+/**
+ * @brief Prints the phase breakdown (one line per phase, then the total).
+ */
+static inline void print_startup_report(const StartupReport* report, FILE* out) {
+    if (!report || !out) return;
+    fprintf(out, "Startup report%s\n", report->complete ? "" : " (first frame not presented yet)");
+    for (int i = 0; i < STARTUP_PHASE_COUNT; i++) {
+        fprintf(out, "  %-20s %8.2f ms", startup_phase_name((StartupPhase)i), report->phase_ms[i]);
+        if (i == STARTUP_FONT_LOAD || i == STARTUP_IMAGE_DECODE) {
+            fprintf(out, "  (%d)", report->phase_count[i]);
+        }
+        fprintf(out, "\n");
+    }
+    fprintf(out, "  %-20s %8.2f ms\n", "Time to first frame", report->total_ms);
+}
+
+#endif /* STARTUP_H */
@@ -7,6 +7,7 @@
 #define THEME_H
 
 #include "color.h"  // For Color struct
+#include "damage.h" // mark_all_dirty
 
 /**
  * @brief Theme structure holding visual properties for the GUI
@@ -42,7 +43,6 @@ typedef struct {
     float roundness;        // Rounding factor for rounded rectangles (0.0 to 1.0)
 } Theme;
 
-const Theme* current_theme = NULL;  // Global definition (initialized to NULL; set in init)
 // Function to set the current theme
 void set_theme(const Theme* theme);
 
@@ -117,10 +117,14 @@ static const Theme THEME_HACKER = {
     .roundness = 0.1f                        // Less rounded for a "techy" feel
 };
 
-// Implementation of set_theme (can be in a .c file or inline here)
+// Global definition. Never NULL, so the draw-list jobs (frame.h) only ever read it.
+const Theme* current_theme = &THEME_LIGHT;
+
+// Implementation of set_theme (can be in a .c file or inline here); NULL restores THEME_LIGHT
 void set_theme(const Theme* theme) {
+    if (!theme) theme = &THEME_LIGHT;
+    if (theme != current_theme) mark_all_dirty();  // Every widget changes color
     current_theme = theme;
-    // Optional: Trigger a redraw if needed (e.g., set a flag for your main loop)
 }
 
 #endif // THEME_H
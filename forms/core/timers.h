@@ -0,0 +1,300 @@
+/**
+ * @file timers.h
+ * @brief Hierarchical timer wheel driven by app_run_.
+ *
+ * Timers are kept in TIMER_WHEEL_LEVELS wheels of TIMER_WHEEL_SLOTS slots with
+ * 1 ms, 64 ms, 4 s and 4.4 min resolution; adding and cancelling are O(1), and a
+ * timer moves down a level each time its coarse slot comes up (a cascade). Every
+ * iteration app_run_ fires what is due (run_timers_) and sleeps until
+ * next_timer_ms_, so an app that only blinks a cursor wakes twice a second instead
+ * of rendering continuously. Callbacks run on the UI thread and should mark only
+ * their own widget dirty.
+ *
+ * The wheel belongs to the app (App.timers); widgets schedule on it through
+ * add_timer/cancel_timer.
+ */
+
+#ifndef TIMERS_H
+#define TIMERS_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+#include "log.h"
+
+#define TIMER_WHEEL_BITS 6
+#define TIMER_WHEEL_SLOTS (1 << TIMER_WHEEL_BITS)
+#define TIMER_WHEEL_LEVELS 4
+#define TIMER_WHEEL_SPAN ((Uint32)1 << (TIMER_WHEEL_BITS * TIMER_WHEEL_LEVELS))  // ~4.6 hours
+#define TIMER_FIRING_LIST_ (TIMER_WHEEL_LEVELS * TIMER_WHEEL_SLOTS)            // Due timers being fired
+#define MAX_TIMERS 256
+
+/**
+ * @brief Timer handle; 0 means "no timer". Stale handles are ignored safely.
+ */
+typedef Uint32 TimerId;
+
+typedef void (*TimerFn)(void* userdata);
+
+typedef struct {
+    Uint32 deadline;       // SDL_GetTicks() value it is due at
+    Uint32 period;         // Repeat interval in ms (0 = one-shot)
+    TimerFn fn;
+    void* userdata;
+    int prev, next;        // Links within its slot list (-1 = none)
+    int list;              // Slot list it is linked into (-1 = unlinked)
+    Uint16 generation;     // Bumped on reuse so old TimerIds stop matching
+    bool in_use;
+    bool cancelled;        // Cancelled from inside its own callback
+} Timer;
+
+typedef struct {
+    Timer timers[MAX_TIMERS];
+    int heads[TIMER_FIRING_LIST_ + 1];  // First timer of each slot list (-1 = empty)
+    int free_head;                      // Unused timers, linked through `next`
+    int count;                          // Timers scheduled
+    int firing;                         // Timer whose callback is running (-1 = none)
+    Uint32 now;                         // Last tick processed; everything due by then has fired
+    bool started;
+} TimerWheel;
+
+static TimerWheel timer_wheel_;
+
+static inline void init_timer_wheel_(TimerWheel* w) {
+    for (int i = 0; i <= TIMER_FIRING_LIST_; i++) w->heads[i] = -1;
+    for (int i = 0; i < MAX_TIMERS; i++) {
+        w->timers[i].next = i + 1 < MAX_TIMERS ? i + 1 : -1;
+        w->timers[i].list = -1;
+    }
+    w->free_head = 0;
+    w->count = 0;
+    w->firing = -1;
+    w->now = SDL_GetTicks();
+    w->started = true;
+}
+
+static inline void link_timer_(TimerWheel* w, int i, int list) {
+    Timer* t = &w->timers[i];
+    t->list = list;
+    t->prev = -1;
+    t->next = w->heads[list];
+    if (t->next >= 0) w->timers[t->next].prev = i;
+    w->heads[list] = i;
+}
+
+static inline void unlink_timer_(TimerWheel* w, int i) {
+    Timer* t = &w->timers[i];
+    if (t->list < 0) return;
+    if (t->prev >= 0) w->timers[t->prev].next = t->next;
+    else w->heads[t->list] = t->next;
+    if (t->next >= 0) w->timers[t->next].prev = t->prev;
+    t->list = t->prev = t->next = -1;
+}
+
+// Files a timer by how far its deadline is from `now`; due timers land in the current slot
+static inline void schedule_timer_(TimerWheel* w, int i) {
+    Timer* t = &w->timers[i];
+    Uint32 delta = t->deadline - w->now;
+    if ((Sint32)delta < 0) delta = 0;
+    Uint32 at = w->now + (delta < TIMER_WHEEL_SPAN ? delta : TIMER_WHEEL_SPAN - 1);  // Far ones re-file on cascade
+    int level = 0;
+    while (level < TIMER_WHEEL_LEVELS - 1 && (at - w->now) >> (TIMER_WHEEL_BITS * (level + 1))) level++;
+    int slot = (int)((at >> (TIMER_WHEEL_BITS * level)) & (TIMER_WHEEL_SLOTS - 1));
+    link_timer_(w, i, level * TIMER_WHEEL_SLOTS + slot);
+}
+
+static inline void release_timer_(TimerWheel* w, int i) {
+    Timer* t = &w->timers[i];
+    t->in_use = false;
+    t->fn = NULL;
+    t->generation++;
+    t->next = w->free_head;
+    w->free_head = i;
+    w->count--;
+}
+
+static inline int find_timer_(TimerWheel* w, TimerId id) {
+    int i = (int)(id & 0xFFFF) - 1;
+    if (i < 0 || i >= MAX_TIMERS) return -1;
+    Timer* t = &w->timers[i];
+    return t->in_use && t->generation == (Uint16)(id >> 16) ? i : -1;
+}
+
+/**
+ * @brief Calls fn(userdata) after delay_ms, then every period_ms if period_ms > 0.
+ * @return Handle for cancel_timer, or 0 if MAX_TIMERS are already scheduled
+ */
+static inline TimerId add_timer(Uint32 delay_ms, Uint32 period_ms, TimerFn fn, void* userdata) {
+    TimerWheel* w = &timer_wheel_;
+    if (!fn) return 0;
+    if (!w->started) init_timer_wheel_(w);
+    if (w->free_head < 0) {
+        LOG_WARN("Timer not added: all %d timers are in use", MAX_TIMERS);
+        return 0;
+    }
+    int i = w->free_head;
+    Timer* t = &w->timers[i];
+    w->free_head = t->next;
+    t->deadline = SDL_GetTicks() + (delay_ms ? delay_ms : 1);
+    if ((Sint32)(t->deadline - w->now) <= 0) t->deadline = w->now + 1;  // `now` is already processed
+    t->period = period_ms;
+    t->fn = fn;
+    t->userdata = userdata;
+    t->in_use = true;
+    t->cancelled = false;
+    w->count++;
+    schedule_timer_(w, i);
+    return ((TimerId)t->generation << 16) | (TimerId)(i + 1);
+}
+
+/**
+ * @brief Stops a timer. Safe from inside any timer callback, including its own.
+ * @return true if the timer was still scheduled
+ */
+static inline bool cancel_timer(TimerId id) {
+    TimerWheel* w = &timer_wheel_;
+    int i = find_timer_(w, id);
+    if (i < 0 || w->timers[i].cancelled) return false;
+    if (i == w->firing) {
+        w->timers[i].cancelled = true;  // Released once its callback returns
+        return true;
+    }
+    unlink_timer_(w, i);
+    release_timer_(w, i);
+    return true;
+}
+
+static inline bool is_timer_active(TimerId id) {
+    int i = find_timer_(&timer_wheel_, id);
+    return i >= 0 && !timer_wheel_.timers[i].cancelled;
+}
+
+// Re-files every timer of a coarse slot at the finer levels
+static inline void cascade_timers_(TimerWheel* w, int level) {
+    int slot = (int)((w->now >> (TIMER_WHEEL_BITS * level)) & (TIMER_WHEEL_SLOTS - 1));
+    int list = level * TIMER_WHEEL_SLOTS + slot;
+    int i;
+    while ((i = w->heads[list]) >= 0) {
+        unlink_timer_(w, i);
+        schedule_timer_(w, i);
+    }
+}
+
+static inline void fire_due_timers_(TimerWheel* w) {
+    // Move the slot aside first: callbacks may add timers that land in this same slot
+    int list = (int)(w->now & (TIMER_WHEEL_SLOTS - 1));
+    int i;
+    while ((i = w->heads[list]) >= 0) {
+        unlink_timer_(w, i);
+        link_timer_(w, i, TIMER_FIRING_LIST_);
+    }
+    while ((i = w->heads[TIMER_FIRING_LIST_]) >= 0) {
+        unlink_timer_(w, i);
+        Timer* t = &w->timers[i];
+        w->firing = i;
+        t->fn(t->userdata);
+        w->firing = -1;
+        if (t->period && !t->cancelled) {
+            t->deadline += t->period;
+            // After a stall, skip missed periods instead of firing them back to back
+            if ((Sint32)(t->deadline - w->now) <= 0) t->deadline = w->now + t->period;
+            schedule_timer_(w, i);
+        } else {
+            release_timer_(w, i);
+        }
+    }
+}
+
+/**
+ * @brief Ticks until the next slot that fires or cascades, or -1 if nothing is scheduled.
+ */
+static inline int next_timer_tick_(TimerWheel* w, Uint32* tick) {
+    if (!w->started || w->count == 0) return -1;
+    bool found = false;
+    Uint32 best = 0;
+    for (int level = 0; level < TIMER_WHEEL_LEVELS; level++) {
+        int shift = TIMER_WHEEL_BITS * level;
+        for (int k = 1; k <= TIMER_WHEEL_SLOTS; k++) {
+            Uint32 at = ((w->now >> shift) + (Uint32)k) << shift;
+            if (w->heads[level * TIMER_WHEEL_SLOTS + (int)((at >> shift) & (TIMER_WHEEL_SLOTS - 1))] < 0) continue;
+            if (!found || (Sint32)(at - best) < 0) best = at;
+            found = true;
+            break;  // Later slots of this level come after it
+        }
+    }
+    if (found) *tick = best;
+    return found ? 0 : -1;
+}
+
+/**
+ * @brief Fires every timer due by now. UI thread only; called by app_run_.
+ */
+static inline void run_timers_(void) {
+    TimerWheel* w = &timer_wheel_;
+    if (!w->started) return;
+    Uint32 target = SDL_GetTicks();
+    while ((Sint32)(target - w->now) > 0) {
+        // Jump over ticks where no slot fires or cascades
+        Uint32 next;
+        if (next_timer_tick_(w, &next) < 0 || (Sint32)(next - target) > 0) {
+            w->now = target;
+            break;
+        }
+        w->now = next;
+        int levels = 0;
+        while (levels < TIMER_WHEEL_LEVELS - 1 && !(w->now & ((1u << (TIMER_WHEEL_BITS * (levels + 1))) - 1))) levels++;
+        for (int level = levels; level >= 1; level--) cascade_timers_(w, level);
+        fire_due_timers_(w);
+    }
+}
+
+/**
+ * @brief Milliseconds app_run_ may sleep before run_timers_ has work, or -1 for no timers.
+ *        Can be early (a cascade with nothing due yet), never late.
+ */
+static inline int next_timer_ms_(void) {
+    Uint32 next;
+    if (next_timer_tick_(&timer_wheel_, &next) < 0) return -1;
+    Sint32 ms = (Sint32)(next - SDL_GetTicks());
+    return ms > 0 ? (int)ms : 0;
+}
+
+/**
+ * @brief Drops every timer (at shutdown; widgets they point at are being freed).
+ */
+static inline void free_timers_(void) {
+    timer_wheel_.started = false;
+    for (int i = 0; i < MAX_TIMERS; i++) {
+        timer_wheel_.timers[i].in_use = false;
+        timer_wheel_.timers[i].generation++;
+    }
+}
+
+// -------- Text cursor blink --------
+#define CURSOR_BLINK_MS 530
+
+/**
+ * @brief Blink state for a text widget's cursor
+ */
+typedef struct {
+    bool visible;
+    TimerId timer;
+} CursorBlink;
+
+/**
+ * @brief Shows the cursor and restarts its blink (on focus and on every keystroke).
+ * @param on_blink Toggles blink->visible and marks the widget dirty
+ */
+static inline void restart_cursor_blink_(CursorBlink* blink, TimerFn on_blink, void* widget) {
+    cancel_timer(blink->timer);
+    blink->visible = true;
+    blink->timer = add_timer(CURSOR_BLINK_MS, CURSOR_BLINK_MS, on_blink, widget);
+}
+
+static inline void stop_cursor_blink_(CursorBlink* blink) {
+    cancel_timer(blink->timer);
+    blink->timer = 0;
+    blink->visible = false;
+}
+
+#endif /* TIMERS_H */
@@ -0,0 +1,204 @@
+/**
+ * @file tween.h
+ * @brief Eased animations of ints, floats and colors, stepped by the timer wheel.
+ *
+ * tween_int/tween_float/tween_color move a value to a target over a duration.
+ * While any tween runs a single TWEEN_FRAME_MS timer steps all of them; after
+ * every step the tween's on_step callback runs, which should mark just the
+ * animated widget dirty. When the last tween finishes the timer is cancelled and
+ * the app goes back to sleeping until input.
+ */
+
+#ifndef TWEEN_H
+#define TWEEN_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+#include "color.h"
+#include "log.h"
+#include "timers.h"
+
+#define MAX_TWEENS 64
+#define TWEEN_FRAME_MS 16  // Step interval (~60 Hz)
+
+typedef enum {
+    TWEEN_INT,
+    TWEEN_FLOAT,
+    TWEEN_COLOR
+} TweenKind;
+
+typedef enum {
+    EASE_LINEAR,
+    EASE_IN_QUAD,
+    EASE_OUT_QUAD,
+    EASE_IN_OUT_QUAD,
+    EASE_OUT_CUBIC
+} Easing;
+
+/**
+ * @brief Called after each step with the tween's userdata (typically the widget)
+ */
+typedef void (*TweenStepFn)(void* userdata);
+
+typedef struct {
+    bool active;
+    TweenKind kind;
+    void* target;          // int*, float* or Color*; also identifies the tween
+    float from[4], to[4];  // One channel for int/float, r, g, b, a for colors
+    Uint32 start;          // SDL_GetTicks() when it started
+    Uint32 duration;       // ms
+    Easing easing;
+    TweenStepFn on_step;
+    void* userdata;
+} Tween;
+
+static Tween tweens_[MAX_TWEENS];
+static int tweens_active_ = 0;
+static TimerId tween_timer_ = 0;
+
+static inline float apply_easing_(Easing easing, float t) {
+    switch (easing) {
+        case EASE_IN_QUAD: return t * t;
+        case EASE_OUT_QUAD: return t * (2.0f - t);
+        case EASE_IN_OUT_QUAD: return t < 0.5f ? 2.0f * t * t : -1.0f + (4.0f - 2.0f * t) * t;
+        case EASE_OUT_CUBIC: {
+            float u = t - 1.0f;
+            return u * u * u + 1.0f;
+        }
+        case EASE_LINEAR:
+        default: return t;
+    }
+}
+
+static inline Uint8 tween_channel_(float v) {
+    return (Uint8)(v < 0.0f ? 0 : v > 255.0f ? 255 : (int)(v + 0.5f));
+}
+
+static inline void write_tween_(Tween* tw, float eased) {
+    float v[4];
+    for (int c = 0; c < 4; c++) v[c] = tw->from[c] + (tw->to[c] - tw->from[c]) * eased;
+    switch (tw->kind) {
+        case TWEEN_INT: *(int*)tw->target = (int)(v[0] < 0 ? v[0] - 0.5f : v[0] + 0.5f); break;
+        case TWEEN_FLOAT: *(float*)tw->target = v[0]; break;
+        case TWEEN_COLOR: {
+            Color* color = (Color*)tw->target;
+            color->r = tween_channel_(v[0]);
+            color->g = tween_channel_(v[1]);
+            color->b = tween_channel_(v[2]);
+            color->a = tween_channel_(v[3]);
+            break;
+        }
+    }
+}
+
+// Timer callback: advances every tween and stops the timer once none are left
+static inline void step_tweens_(void* userdata) {
+    (void)userdata;
+    Uint32 now = SDL_GetTicks();
+    for (int i = 0; i < MAX_TWEENS; i++) {
+        Tween* tw = &tweens_[i];
+        if (!tw->active) continue;
+        Uint32 elapsed = now - tw->start;
+        float t = tw->duration ? (float)elapsed / (float)tw->duration : 1.0f;
+        if (t >= 1.0f) {
+            t = 1.0f;
+            tw->active = false;
+            tweens_active_--;
+        }
+        write_tween_(tw, apply_easing_(tw->easing, t));
+        if (tw->on_step) tw->on_step(tw->userdata);
+    }
+    if (tweens_active_ == 0) {
+        cancel_timer(tween_timer_);
+        tween_timer_ = 0;
+    }
+}
+
+/**
+ * @brief Stops the tween animating `target`, leaving the value where it is.
+ */
+static inline void stop_tween(void* target) {
+    for (int i = 0; i < MAX_TWEENS; i++) {
+        if (tweens_[i].active && tweens_[i].target == target) {
+            tweens_[i].active = false;
+            tweens_active_--;
+        }
+    }
+}
+
+static inline bool is_tweening(void* target) {
+    for (int i = 0; i < MAX_TWEENS; i++) {
+        if (tweens_[i].active && tweens_[i].target == target) return true;
+    }
+    return false;
+}
+
+// Replaces any tween on the same target
+static inline bool start_tween_(TweenKind kind, void* target, const float from[4], const float to[4],
+                                Uint32 duration_ms, Easing easing, TweenStepFn on_step, void* userdata) {
+    if (!target) return false;
+    stop_tween(target);
+    Tween* tw = NULL;
+    for (int i = 0; i < MAX_TWEENS && !tw; i++) {
+        if (!tweens_[i].active) tw = &tweens_[i];
+    }
+    if (!tw) {
+        LOG_WARN("Tween not started: all %d tweens are running", MAX_TWEENS);
+        return false;
+    }
+    tw->kind = kind;
+    tw->target = target;
+    for (int c = 0; c < 4; c++) {
+        tw->from[c] = from[c];
+        tw->to[c] = to[c];
+    }
+    tw->start = SDL_GetTicks();
+    tw->duration = duration_ms;
+    tw->easing = easing;
+    tw->on_step = on_step;
+    tw->userdata = userdata;
+    tw->active = true;
+    tweens_active_++;
+    if (!is_timer_active(tween_timer_)) {
+        tween_timer_ = add_timer(TWEEN_FRAME_MS, TWEEN_FRAME_MS, step_tweens_, NULL);
+    }
+    return true;
+}
+
+/**
+ * @brief Animates *target from its current value to `to`.
+ * @param on_step Called after every step (e.g. marks the widget dirty); may be NULL
+ */
+static inline bool tween_int(int* target, int to, Uint32 duration_ms, Easing easing, TweenStepFn on_step, void* userdata) {
+    if (!target) return false;
+    float from[4] = {(float)*target, 0, 0, 0};
+    float dest[4] = {(float)to, 0, 0, 0};
+    return start_tween_(TWEEN_INT, target, from, dest, duration_ms, easing, on_step, userdata);
+}
+
+static inline bool tween_float(float* target, float to, Uint32 duration_ms, Easing easing, TweenStepFn on_step, void* userdata) {
+    if (!target) return false;
+    float from[4] = {*target, 0, 0, 0};
+    float dest[4] = {to, 0, 0, 0};
+    return start_tween_(TWEEN_FLOAT, target, from, dest, duration_ms, easing, on_step, userdata);
+}
+
+static inline bool tween_color(Color* target, Color to, Uint32 duration_ms, Easing easing, TweenStepFn on_step, void* userdata) {
+    if (!target) return false;
+    float from[4] = {target->r, target->g, target->b, target->a};
+    float dest[4] = {to.r, to.g, to.b, to.a};
+    return start_tween_(TWEEN_COLOR, target, from, dest, duration_ms, easing, on_step, userdata);
+}
+
+/**
+ * @brief Drops every tween (at shutdown, before the animated widgets are freed).
+ */
+static inline void free_tweens_(void) {
+    for (int i = 0; i < MAX_TWEENS; i++) tweens_[i].active = false;
+    tweens_active_ = 0;
+    cancel_timer(tween_timer_);
+    tween_timer_ = 0;
+}
+
+#endif /* TWEEN_H */
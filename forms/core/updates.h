@@ -0,0 +1,172 @@
+/**
+ * @file updates.h
+ * @brief Lock-free queue for widget updates posted from any thread.
+ *
+ * Worker threads must not touch widgets directly; they post an update (a setter
+ * plus its value) with post_widget_update_ or a widget's post_* helper instead.
+ * Posting is a lock-free push (CAS on the list head); the first post after a drain
+ * also pushes a wake-up event so app_run_ leaves SDL_WaitEvent. Once per frame
+ * drain_widget_updates_ takes the whole list in one atomic swap on the UI thread
+ * and applies, in posting order, only the newest update for each (widget, setter)
+ * pair, so a producer posting thousands of values per second costs one apply per frame.
+ */
+
+#ifndef UPDATES_H
+#define UPDATES_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "color.h"
+#include "log.h"
+
+/**
+ * @brief Payload of an update; which field is used depends on the setter
+ */
+typedef struct {
+    int i;
+    Color color;
+    char* text;  // Owned by the update (freed after applying or when superseded)
+} WidgetUpdateValue;
+
+/**
+ * @brief Applies a value to a widget on the UI thread. Also the coalescing key
+ *        together with the target: updates with the same pair supersede each other.
+ */
+typedef void (*WidgetUpdateFn)(void* target, WidgetUpdateValue* value);
+
+typedef struct WidgetUpdate {
+    void* target;
+    WidgetUpdateFn apply;
+    WidgetUpdateValue value;
+    struct WidgetUpdate* next;
+} WidgetUpdate;
+
+static void* widget_updates_head_ = NULL;   // Newest first; accessed only through SDL atomics
+static SDL_atomic_t widget_update_event_;   // Registered wake-up event type (0 = not yet)
+
+/**
+ * @brief Event type pushed to wake the UI thread (registered on first use).
+ * @return The event type, or 0 if no user event could be registered
+ */
+static inline Uint32 widget_update_event_type_(void) {
+    int type = SDL_AtomicGet(&widget_update_event_);
+    if (type) return (Uint32)type;
+    Uint32 registered = SDL_RegisterEvents(1);
+    if (registered == (Uint32)-1) return 0;
+    // Two threads racing here each register one; the first stored wins, the other is unused
+    SDL_AtomicCAS(&widget_update_event_, 0, (int)registered);
+    return (Uint32)SDL_AtomicGet(&widget_update_event_);
+}
+
+/**
+ * @brief Queues `apply(target, value)` to run on the UI thread. Safe from any thread.
+ *        value->text, if set, must be heap-allocated; the queue takes ownership.
+ * @return false if the update could not be allocated (value->text is freed)
+ */
+static inline bool post_widget_update_(void* target, WidgetUpdateFn apply, WidgetUpdateValue value) {
+    WidgetUpdate* update = (WidgetUpdate*)malloc(sizeof(WidgetUpdate));
+    if (!update) {
+        free(value.text);
+        return false;
+    }
+    update->target = target;
+    update->apply = apply;
+    update->value = value;
+
+    void* head;
+    do {
+        head = SDL_AtomicGetPtr(&widget_updates_head_);
+        update->next = (WidgetUpdate*)head;
+    } while (!SDL_AtomicCASPtr(&widget_updates_head_, head, update));
+
+    if (!head) {
+        // First update since the last drain: wake the UI thread once
+        SDL_Event wake;
+        SDL_zero(wake);
+        wake.type = widget_update_event_type_();
+        if (wake.type) SDL_PushEvent(&wake);
+    }
+    return true;
+}
+
+static inline Uint32 widget_update_hash_(void* target, WidgetUpdateFn apply) {
+    uintptr_t key = (uintptr_t)target ^ ((uintptr_t)apply * 31u);
+    key ^= key >> 16;
+    return (Uint32)(key * 2654435761u);
+}
+
+static inline void free_widget_update_(WidgetUpdate* update) {
+    free(update->value.text);
+    free(update);
+}
+
+/**
+ * @brief Applies every pending update (the newest per widget and setter). UI thread only.
+ * @return Number of updates applied
+ */
+static inline int drain_widget_updates_(void) {
+    WidgetUpdate* newest = (WidgetUpdate*)SDL_AtomicSetPtr(&widget_updates_head_, NULL);
+    if (!newest) return 0;
+
+    int count = 0;
+    for (WidgetUpdate* u = newest; u; u = u->next) count++;
+
+    // Open-addressed set of (target, apply) pairs already kept; walking newest to
+    // oldest, later duplicates are superseded. Prepending the kept ones restores posting order.
+    int capacity = 16;
+    while (capacity < count * 2) capacity *= 2;
+    WidgetUpdate** seen = (WidgetUpdate**)calloc((size_t)capacity, sizeof(WidgetUpdate*));
+    WidgetUpdate* ordered = NULL;
+    WidgetUpdate* u = newest;
+    while (u) {
+        WidgetUpdate* next = u->next;
+        bool superseded = false;
+        if (seen) {
+            Uint32 slot = widget_update_hash_(u->target, u->apply) & (Uint32)(capacity - 1);
+            while (seen[slot]) {
+                if (seen[slot]->target == u->target && seen[slot]->apply == u->apply) {
+                    superseded = true;
+                    break;
+                }
+                slot = (slot + 1) & (Uint32)(capacity - 1);
+            }
+            if (!superseded) seen[slot] = u;
+        }
+        if (superseded) {
+            free_widget_update_(u);
+        } else {
+            u->next = ordered;
+            ordered = u;
+        }
+        u = next;
+    }
+    free(seen);  // Without it (out of memory) every update is applied; still correct
+
+    int applied = 0;
+    while (ordered) {
+        WidgetUpdate* next = ordered->next;
+        ordered->apply(ordered->target, &ordered->value);
+        free_widget_update_(ordered);
+        applied++;
+        ordered = next;
+    }
+    return applied;
+}
+
+/**
+ * @brief Drops pending updates without applying them (at shutdown).
+ */
+static inline void free_widget_updates_(void) {
+    WidgetUpdate* u = (WidgetUpdate*)SDL_AtomicSetPtr(&widget_updates_head_, NULL);
+    while (u) {
+        WidgetUpdate* next = u->next;
+        free_widget_update_(u);
+        u = next;
+    }
+}
+
+#endif /* UPDATES_H */
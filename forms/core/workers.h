@@ -0,0 +1,199 @@
+/**
+ * @file workers.h
+ * @brief Worker thread pool for slow callbacks, with completion on the UI thread.
+ *
+ * run_in_background(work, done, userdata) queues `work` for a worker thread and,
+ * once it returns, runs `done` on the UI thread during the next frame. Finished
+ * jobs are handed back through the widget update queue (updates.h), whose wake-up
+ * event gets app_run_ out of its wait right away. Threads start on the first job,
+ * so apps that never use it pay nothing.
+ *
+ * `work` must not touch widgets or the renderer; `done` may.
+ */
+
+#ifndef WORKERS_H
+#define WORKERS_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "log.h"
+#include "updates.h"
+
+#define WORKER_THREADS 2  // Enough to keep one slow job from blocking the next
+
+typedef void (*WorkerFn)(void* userdata);
+
+/**
+ * @brief One queued, running or finished job
+ */
+typedef struct WorkerJob {
+    WorkerFn work;            // Runs on a worker thread
+    WorkerFn done;            // Runs on the UI thread afterwards (may be NULL)
+    void* userdata;
+    struct WorkerJob* next;
+} WorkerJob;
+
+/**
+ * @brief Worker threads plus the pending and finished job queues
+ */
+typedef struct {
+    SDL_Thread* threads[WORKER_THREADS];
+    int thread_count;
+    SDL_mutex* lock;          // Guards both queues and `quit`
+    SDL_cond* wake;           // Signalled when a job is queued or on shutdown
+    WorkerJob* pending_head;  // FIFO of jobs waiting for a thread
+    WorkerJob* pending_tail;
+    WorkerJob* done;          // Finished jobs waiting for their `done` (newest first)
+    int in_flight;            // Jobs queued or running (UI-thread view)
+    bool quit;
+} WorkerPool;
+
+static WorkerPool worker_pool_;
+
+static inline void finish_worker_jobs_(void* target, WidgetUpdateValue* value);
+
+static int worker_thread_(void* data) {
+    WorkerPool* pool = (WorkerPool*)data;
+    SDL_LockMutex(pool->lock);
+    while (!pool->quit) {
+        WorkerJob* job = pool->pending_head;
+        if (!job) {
+            SDL_CondWait(pool->wake, pool->lock);
+            continue;
+        }
+        pool->pending_head = job->next;
+        if (!pool->pending_head) pool->pending_tail = NULL;
+        SDL_UnlockMutex(pool->lock);
+
+        job->work(job->userdata);
+
+        SDL_LockMutex(pool->lock);
+        job->next = pool->done;
+        pool->done = job;
+        // One hand-off per batch: pending ones for the same pool coalesce (see updates.h)
+        post_widget_update_(pool, finish_worker_jobs_, (WidgetUpdateValue){0});
+    }
+    SDL_UnlockMutex(pool->lock);
+    return 0;
+}
+
+// Starts the worker threads on first use
+static inline bool start_workers_(void) {
+    WorkerPool* pool = &worker_pool_;
+    if (pool->thread_count > 0) return true;
+
+    if (!pool->lock) pool->lock = SDL_CreateMutex();
+    if (!pool->wake) pool->wake = SDL_CreateCond();
+    if (!pool->lock || !pool->wake) {
+        LOG_ERROR("Failed to create worker pool lock: %s", SDL_GetError());
+        return false;
+    }
+    pool->quit = false;
+    for (int i = 0; i < WORKER_THREADS; i++) {
+        SDL_Thread* thread = SDL_CreateThread(worker_thread_, "worker", pool);
+        if (!thread) {
+            LOG_WARN("Failed to start worker thread: %s", SDL_GetError());
+            break;
+        }
+        pool->threads[pool->thread_count++] = thread;
+    }
+    return pool->thread_count > 0;
+}
+
+// Update-queue callback on the UI thread: runs `done` for every finished job
+static inline void finish_worker_jobs_(void* target, WidgetUpdateValue* value) {
+    (void)value;
+    WorkerPool* pool = (WorkerPool*)target;
+    SDL_LockMutex(pool->lock);
+    WorkerJob* done = pool->done;
+    pool->done = NULL;
+    SDL_UnlockMutex(pool->lock);
+
+    // Oldest first, in the order the jobs finished
+    WorkerJob* ordered = NULL;
+    while (done) {
+        WorkerJob* next = done->next;
+        done->next = ordered;
+        ordered = done;
+        done = next;
+    }
+    while (ordered) {
+        WorkerJob* next = ordered->next;
+        if (ordered->done) ordered->done(ordered->userdata);
+        free(ordered);
+        pool->in_flight--;
+        ordered = next;
+    }
+}
+
+/**
+ * @brief Runs work(userdata) on a worker thread, then done(userdata) on the UI thread.
+ *        Without worker threads both run right here, in order. UI thread only.
+ * @return false if the job could not be allocated (nothing runs)
+ */
+static inline bool run_in_background(WorkerFn work, WorkerFn done, void* userdata) {
+    if (!work) return false;
+    if (!start_workers_()) {
+        work(userdata);
+        if (done) done(userdata);
+        return true;
+    }
+    WorkerJob* job = (WorkerJob*)malloc(sizeof(WorkerJob));
+    if (!job) {
+        LOG_ERROR("Failed to queue background job");
+        return false;
+    }
+    job->work = work;
+    job->done = done;
+    job->userdata = userdata;
+    job->next = NULL;
+
+    WorkerPool* pool = &worker_pool_;
+    SDL_LockMutex(pool->lock);
+    if (pool->pending_tail) pool->pending_tail->next = job;
+    else pool->pending_head = job;
+    pool->pending_tail = job;
+    SDL_CondSignal(pool->wake);
+    SDL_UnlockMutex(pool->lock);
+    pool->in_flight++;
+    return true;
+}
+
+/**
+ * @brief Waits for running jobs, then drops queued ones and every pending `done`.
+ *        Call at shutdown before widgets are freed (done callbacks would touch them).
+ */
+static inline void shutdown_workers_(void) {
+    WorkerPool* pool = &worker_pool_;
+    if (pool->thread_count == 0) return;
+
+    SDL_LockMutex(pool->lock);
+    pool->quit = true;
+    SDL_CondBroadcast(pool->wake);
+    SDL_UnlockMutex(pool->lock);
+    for (int i = 0; i < pool->thread_count; i++) {
+        SDL_WaitThread(pool->threads[i], NULL);
+    }
+    pool->thread_count = 0;
+
+    WorkerJob* lists[2] = {pool->pending_head, pool->done};
+    for (int l = 0; l < 2; l++) {
+        WorkerJob* job = lists[l];
+        while (job) {
+            WorkerJob* next = job->next;
+            free(job);
+            job = next;
+        }
+    }
+    pool->pending_head = pool->pending_tail = pool->done = NULL;
+    pool->in_flight = 0;
+
+    SDL_DestroyCond(pool->wake);
+    SDL_DestroyMutex(pool->lock);
+    pool->wake = NULL;
+    pool->lock = NULL;
+}
+
+#endif /* WORKERS_H */
@@ -1,7 +1,18 @@
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_ttf.h>
 #include"core/parent.h"
+#include"core/layout.h"
 #include"core/graphics.h"
+#include"core/drawlist.h"
+#include"core/updates.h"
+#include"core/jobs.h"
+#include"core/loader.h"
+#include"core/observable.h"
+#include"core/timers.h"
+#include"core/tween.h"
+#include"core/notify.h"
+#include"core/workers.h"
+#include"core/feed.h"
 #include"core/theme.h"
 #include"widgets/container.h"
 #include"widgets/entry.h"
@@ -13,4 +24,8 @@
 #include"widgets/text.h"
 #include"widgets/progress.h"
 #include"widgets/image.h"
+#include"widgets/tiled.h"
+#include"widgets/animated.h"
+#include"core/frame.h"
+#include"core/snapshot.h"
 #include"core/app.h"
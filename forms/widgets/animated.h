@@ -0,0 +1,396 @@
+#include<SDL2/SDL.h>
+#include<SDL2/SDL_image.h>
+#include<stdlib.h>
+
+// Animated GIF/WebP widget. Frames are decoded once, on the first frame the widget
+// is visible, and (when w/h are set) downscaled to the physical display size.
+// Short animations are packed into a few texture pages and play with no uploads;
+// long ones keep their decoded frames in memory and stream each frame into a single
+// texture instead. In pipelined mode the update thread may not touch the renderer, so
+// frames stay decoded and each one is drawn as a surface by the render thread.
+// tick_animated_images_ advances frames from the clock and marks only the widget's
+// own rect dirty, so a running animation never redraws the window.
+
+#define ANIM_PAGE_SIZE 2048                           // Max page width/height in pixels
+#define ANIM_PRELOAD_MAX_BYTES (32u * 1024u * 1024u)  // Bigger animations stream (ANIM_STREAM_AUTO)
+#define ANIM_MIN_DELAY_MS 20     // Shorter frame delays are treated as ANIM_DEFAULT_DELAY_MS,
+#define ANIM_DEFAULT_DELAY_MS 100 // like browsers do
+
+#if SDL_IMAGE_VERSION_ATLEAST(2, 6, 0)
+#define ANIM_HAVE_IMG_ANIMATION 1
+#else
+#define ANIM_HAVE_IMG_ANIMATION 0  // Older SDL_image: the first frame is shown as a still image
+#endif
+
+typedef enum {
+	ANIM_STREAM_AUTO,    // Stream when all frames would take more than ANIM_PRELOAD_MAX_BYTES
+	ANIM_STREAM_ALWAYS,
+	ANIM_STREAM_NEVER
+} AnimStreamMode;
+
+typedef struct AnimatedImage{
+	Parent *parent;
+	int x, y, w, h;              // w/h of 0 use the animation's own size
+	const char *file_path;
+	AnimStreamMode stream_mode;  // Set before the first frame; default ANIM_STREAM_AUTO
+	bool playing;
+	bool loaded;                 // Decode attempted (frame_count is 0 if it failed)
+	int frame_w, frame_h;        // Frame size after downscaling
+	int frame_count;
+	int *delays;                 // Per frame, milliseconds
+	Uint32 duration;             // Sum of delays
+	int current_frame;
+	Uint32 start_ticks;          // SDL_GetTicks() when frame 0 of the current loop started
+	// Pre-decoded: frames laid out in a grid over one or more pages
+	SDL_Texture **pages;
+	int page_count;
+	int columns;                 // Frames per page row
+	int frames_per_page;
+	// Streaming: decoded frames stay in memory, one texture is updated when the frame changes
+	SDL_Surface **frames;
+	SDL_Texture *stream_texture;
+	int uploaded_frame;
+	ChildRect rect_cache;        // Cached physical rect (see get_child_rect)
+}AnimatedImage;
+
+AnimatedImage new_animated_image(Parent *parent, int x, int y, const char *file_path, int w, int h){
+	if(!parent || !parent->base.sdl_renderer){
+		LOG_ERROR("Invalid parent or renderer for animated image widget");
+	}
+
+	AnimatedImage anim;
+
+	anim.parent = parent;
+	anim.x = x;
+	anim.y = y;
+	anim.w = w;
+	anim.h = h;
+	anim.file_path = file_path;
+	anim.stream_mode = ANIM_STREAM_AUTO;
+	anim.playing = true;
+	// Decoded on the first frame it is visible (see load_animated_image_)
+	anim.loaded = false;
+	anim.frame_w = 0;
+	anim.frame_h = 0;
+	anim.frame_count = 0;
+	anim.delays = NULL;
+	anim.duration = 0;
+	anim.current_frame = 0;
+	anim.start_ticks = 0;
+	anim.pages = NULL;
+	anim.page_count = 0;
+	anim.columns = 0;
+	anim.frames_per_page = 0;
+	anim.frames = NULL;
+	anim.stream_texture = NULL;
+	anim.uploaded_frame = -1;
+	anim.rect_cache = (ChildRect){0};
+
+	return anim;
+}
+
+// Uploads every frame into grid pages; false if a page could not be created
+static inline bool pack_animation_pages_(AnimatedImage *anim, SDL_Surface **frames){
+	SDL_Renderer *renderer = anim->parent->base.sdl_renderer;
+	int columns = ANIM_PAGE_SIZE / anim->frame_w, rows = ANIM_PAGE_SIZE / anim->frame_h;
+	if (columns < 1) columns = 1;
+	if (rows < 1) rows = 1;
+	anim->columns = columns;
+	anim->frames_per_page = columns * rows;
+	anim->page_count = (anim->frame_count + anim->frames_per_page - 1) / anim->frames_per_page;
+	anim->pages = (SDL_Texture**)calloc((size_t)anim->page_count, sizeof(SDL_Texture*));
+	if (!anim->pages) return false;
+
+	for (int p = 0; p < anim->page_count; p++) {
+		int on_page = anim->frame_count - p * anim->frames_per_page;
+		if (on_page > anim->frames_per_page) on_page = anim->frames_per_page;
+		int page_w = (on_page < columns ? on_page : columns) * anim->frame_w;
+		int page_h = ((on_page + columns - 1) / columns) * anim->frame_h;
+		anim->pages[p] = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, page_w, page_h);
+		if (!anim->pages[p]) return false;
+		SDL_SetTextureBlendMode(anim->pages[p], SDL_BLENDMODE_BLEND);
+
+		for (int i = 0; i < on_page; i++) {
+			SDL_Surface *frame = frames[p * anim->frames_per_page + i];
+			SDL_Rect slot = {(i % columns) * anim->frame_w, (i / columns) * anim->frame_h, anim->frame_w, anim->frame_h};
+			SDL_UpdateTexture(anim->pages[p], &slot, frame->pixels, frame->pitch);
+		}
+	}
+	return true;
+}
+
+static inline void free_animation_frames_(AnimatedImage *anim){
+	if (anim->frames) {
+		for (int i = 0; i < anim->frame_count; i++) {
+			if (anim->frames[i]) SDL_FreeSurface(anim->frames[i]);
+		}
+		free(anim->frames);
+		anim->frames = NULL;
+	}
+}
+
+/**
+ * Decodes every frame (through the asset pack when the file is packed), converts them
+ * to ARGB8888 at the display size, then packs them into pages or keeps them for streaming.
+ */
+static inline void load_animated_image_(AnimatedImage *anim, SDL_Rect rect){
+	anim->loaded = true;
+	SDL_Surface **frames = NULL;
+	int count = 0;
+
+	Uint64 load_start = startup_mark_();
+	ensure_asset_pack_();
+	ensure_image_codec_(anim->file_path);
+#if ANIM_HAVE_IMG_ANIMATION
+	SDL_RWops *packed = open_asset_(anim->file_path);
+	IMG_Animation *source = packed ? IMG_LoadAnimation_RW(packed, 1) : IMG_LoadAnimation(anim->file_path);
+	if (source && source->count > 0) {
+		count = source->count;
+		frames = (SDL_Surface**)calloc((size_t)count, sizeof(SDL_Surface*));
+		anim->delays = (int*)calloc((size_t)count, sizeof(int));
+		for (int i = 0; frames && anim->delays && i < count; i++) {
+			frames[i] = SDL_ConvertSurfaceFormat(source->frames[i], SDL_PIXELFORMAT_ARGB8888, 0);
+			anim->delays[i] = source->delays[i] >= ANIM_MIN_DELAY_MS ? source->delays[i] : ANIM_DEFAULT_DELAY_MS;
+		}
+	}
+	if (source) IMG_FreeAnimation(source);
+#else
+	SDL_Surface *still = decode_image_(anim->file_path);
+	if (still) {
+		count = 1;
+		frames = (SDL_Surface**)calloc(1, sizeof(SDL_Surface*));
+		anim->delays = (int*)calloc(1, sizeof(int));
+		if (frames && anim->delays) {
+			frames[0] = SDL_ConvertSurfaceFormat(still, SDL_PIXELFORMAT_ARGB8888, 0);
+			anim->delays[0] = ANIM_DEFAULT_DELAY_MS;
+		}
+		SDL_FreeSurface(still);
+	}
+#endif
+	startup_add_(STARTUP_IMAGE_DECODE, load_start);
+
+	bool ok = frames && anim->delays && count > 0;
+	for (int i = 0; ok && i < count; i++) {
+		// Frames larger than the widget are stored at its physical size
+		if (anim->w > 0 && anim->h > 0) frames[i] = fit_surface_to_variant_(frames[i], rect.w, rect.h);
+		ok = frames[i] != NULL;
+		if (ok && frames[i]->format->format != SDL_PIXELFORMAT_ARGB8888) {
+			SDL_Surface *converted = SDL_ConvertSurfaceFormat(frames[i], SDL_PIXELFORMAT_ARGB8888, 0);
+			SDL_FreeSurface(frames[i]);
+			frames[i] = converted;
+			ok = converted != NULL;
+		}
+	}
+	if (!ok) {
+		LOG_ERROR("Failed to load animation %s : %s", anim->file_path, IMG_GetError());
+		if (frames) {
+			for (int i = 0; i < count; i++) {
+				if (frames[i]) SDL_FreeSurface(frames[i]);
+			}
+			free(frames);
+		}
+		free(anim->delays);
+		anim->delays = NULL;
+		return;
+	}
+
+	anim->frame_count = count;
+	anim->frame_w = frames[0]->w;
+	anim->frame_h = frames[0]->h;
+	anim->duration = 0;
+	for (int i = 0; i < count; i++) anim->duration += (Uint32)anim->delays[i];
+
+	size_t bytes = (size_t)anim->frame_w * anim->frame_h * 4 * (size_t)count;
+	bool stream = anim->stream_mode == ANIM_STREAM_ALWAYS || texture_uploads_deferred_ ||
+	              (anim->stream_mode == ANIM_STREAM_AUTO && bytes > ANIM_PRELOAD_MAX_BYTES);
+	if (!stream && !pack_animation_pages_(anim, frames)) {
+		LOG_WARN("Streaming animation %s, texture pages unavailable: %s", anim->file_path, SDL_GetError());
+		for (int p = 0; p < anim->page_count; p++) {
+			if (anim->pages[p]) SDL_DestroyTexture(anim->pages[p]);
+		}
+		free(anim->pages);
+		anim->pages = NULL;
+		anim->page_count = 0;
+		stream = true;
+	}
+	anim->frames = frames;
+	if (stream && !texture_uploads_deferred_) {
+		anim->stream_texture = SDL_CreateTexture(anim->parent->base.sdl_renderer, SDL_PIXELFORMAT_ARGB8888,
+		                                         SDL_TEXTUREACCESS_STREAMING, anim->frame_w, anim->frame_h);
+		if (anim->stream_texture) SDL_SetTextureBlendMode(anim->stream_texture, SDL_BLENDMODE_BLEND);
+	} else if (!stream) {
+		free_animation_frames_(anim);  // Everything is on the GPU now
+	}
+	anim->current_frame = 0;
+	anim->start_ticks = SDL_GetTicks();
+}
+
+// Restarts from the first frame
+void restart_animated_image(AnimatedImage *anim){
+	if (!anim) return;
+	anim->current_frame = 0;
+	anim->start_ticks = SDL_GetTicks();
+	anim->playing = true;
+	mark_dirty_rect(anim->rect_cache.rect);
+}
+
+// Records the current frame into `list`. Calling thread only: the first visible frame
+// decodes the animation and creates its textures.
+static inline void record_animated_image_(DrawList *list, AnimatedImage *anim){
+	if (!anim || !anim->parent || !anim->parent->base.sdl_renderer) {
+		LOG_ERROR("Invalid animated image widget or renderer");
+		return;
+	}
+	// Children of a closed container are skipped every frame; not worth a message
+	if (!is_parent_open(anim->parent)) return;
+
+	int w = anim->w > 0 ? anim->w : anim->frame_w;
+	int h = anim->h > 0 ? anim->h : anim->frame_h;
+	SDL_Rect rect = get_child_rect(anim->parent, &anim->rect_cache, anim->x, anim->y, w, h);
+	// Skip widgets scrolled out of the parent's viewport or hidden behind an opaque container
+	if (!is_child_visible(anim->parent, rect) || is_child_occluded(anim->parent, rect)) return;
+
+	if (!anim->loaded) {
+		load_animated_image_(anim, rect);
+		if (anim->w <= 0 || anim->h <= 0) {
+			// Unsized: the frame size is known now; draw at it, and redraw just that rect next
+			// frame for the part outside this frame's damage
+			rect = get_child_rect(anim->parent, &anim->rect_cache, anim->x, anim->y, anim->frame_w, anim->frame_h);
+			if (!is_child_visible(anim->parent, rect) || is_child_occluded(anim->parent, rect)) return;
+			mark_child_dirty(anim->parent, rect);
+		}
+	}
+	if (anim->frame_count == 0) return;
+
+	SDL_Texture *texture;
+	SDL_Rect src = {0, 0, anim->frame_w, anim->frame_h};
+	if (anim->stream_texture) {
+		if (anim->uploaded_frame != anim->current_frame) {
+			SDL_Surface *frame = anim->frames[anim->current_frame];
+			SDL_UpdateTexture(anim->stream_texture, NULL, frame->pixels, frame->pitch);
+			anim->uploaded_frame = anim->current_frame;
+		}
+		texture = anim->stream_texture;
+	} else if (anim->pages) {
+		int index = anim->current_frame % anim->frames_per_page;
+		texture = anim->pages[anim->current_frame / anim->frames_per_page];
+		src.x = (index % anim->columns) * anim->frame_w;
+		src.y = (index / anim->columns) * anim->frame_h;
+	} else if (anim->frames) {
+		texture = NULL;  // Pipelined: the render thread uploads the decoded frame itself
+	} else {
+		return;
+	}
+
+	//set container clipping
+	if(anim->parent->is_window == false){
+	SDL_Rect parent_bounds = get_parent_rect(anim->parent);
+	record_clip_(list, &anim->parent->base, &parent_bounds);
+	}
+	if (texture) record_texture_(list, &(anim->parent->base), texture, NULL, &src, rect);
+	else record_surface_(list, &(anim->parent->base), anim->frames[anim->current_frame], rect);
+	// Reset clipping
+	if(anim->parent->is_window == false){
+	record_clip_(list, &anim->parent->base, NULL);
+	}
+}
+
+void render_animated_image(AnimatedImage *anim){
+	record_animated_image_(begin_immediate_draw_(), anim);
+	end_immediate_draw_();
+}
+
+void update_animated_image(AnimatedImage *anim, SDL_Event event){} // playback is driven by tick_animated_images_
+
+void free_animated_image(AnimatedImage *anim){
+	if (!anim) return;
+	for (int p = 0; p < anim->page_count; p++) {
+		if (anim->pages[p]) SDL_DestroyTexture(anim->pages[p]);
+	}
+	free(anim->pages);
+	anim->pages = NULL;
+	anim->page_count = 0;
+	free_animation_frames_(anim);
+	if (anim->stream_texture) SDL_DestroyTexture(anim->stream_texture);
+	anim->stream_texture = NULL;
+	free(anim->delays);
+	anim->delays = NULL;
+	anim->frame_count = 0;
+}
+
+
+// Registration of widgets for rendering
+#define MAX_ANIMATED_IMAGES 100
+AnimatedImage * animated_image_widgets[MAX_ANIMATED_IMAGES];
+
+int animated_images_count = 0;
+
+void register_animated_image(AnimatedImage* anim) {
+    if (animated_images_count < MAX_ANIMATED_IMAGES) {
+        animated_image_widgets[animated_images_count] = anim;
+        animated_images_count++;
+    }
+}
+
+/**
+ * Advances every playing animation to the frame for the current time and marks the
+ * widgets whose frame changed (and that are on screen) dirty.
+ * @return Milliseconds until the next on-screen frame change, or -1 if none is due
+ */
+static inline int tick_animated_images_(void) {
+    Uint32 now = SDL_GetTicks();
+    int wake = -1;
+    for (int i = 0; i < animated_images_count; i++) {
+        AnimatedImage *anim = animated_image_widgets[i];
+        if (!anim || !anim->playing || anim->frame_count < 2 || anim->duration == 0) continue;
+        if (!is_parent_open(anim->parent)) continue;
+
+        // Frame for the current time, plus the time left until it ends
+        Uint32 elapsed = (now - anim->start_ticks) % anim->duration;
+        int frame = 0;
+        Uint32 frame_end = (Uint32)anim->delays[0];
+        while (frame_end <= elapsed && frame + 1 < anim->frame_count) {
+            frame++;
+            frame_end += (Uint32)anim->delays[frame];
+        }
+
+        SDL_Rect rect = get_child_rect(anim->parent, &anim->rect_cache, anim->x, anim->y,
+                                       anim->w > 0 ? anim->w : anim->frame_w, anim->h > 0 ? anim->h : anim->frame_h);
+        SDL_Rect visible;
+        if (!SDL_IntersectRect(&rect, &anim->parent->clip_rect, &visible) || is_child_occluded(anim->parent, rect)) {
+            anim->current_frame = frame;  // Off screen: keep time, but draw nothing
+            continue;
+        }
+        if (frame != anim->current_frame) {
+            anim->current_frame = frame;
+            mark_dirty_rect(visible);
+        }
+        int left = (int)(frame_end - elapsed);
+        if (wake < 0 || left < wake) wake = left;
+    }
+    return wake;
+}
+
+void render_all_registered_animated_images(void) {
+    for (int i = 0; i < animated_images_count; i++) {
+        if (animated_image_widgets[i]) {
+            render_animated_image(animated_image_widgets[i]);
+        }
+    }
+}
+
+void update_all_registered_animated_images(SDL_Event event) {
+    for (int i = 0; i < animated_images_count; i++) {
+        if (animated_image_widgets[i]) {
+            update_animated_image(animated_image_widgets[i], event);
+        }
+    }
+}
+
+void free_all_registered_animated_images(void){
+	for(int i=0; i< animated_images_count; i++){
+		free_animated_image(animated_image_widgets[i]);
+		animated_image_widgets[i]=NULL;
+	}
+	animated_images_count = 0;
+}
@@ -13,26 +13,45 @@
 #include <math.h>   // For roundf in scaling
 
 void OVERRIDE(void) {
-    printf("Button was clicked!\n");
+    LOG_INFO("Button was clicked!");
     // Add custom logic, e.g., open a dialog, submit a form, etc.
 }
 
-typedef struct {
+struct Button;
+typedef void (*ButtonFn)(struct Button* button, void* userdata);
+struct ButtonTask;
+
+typedef struct Button {
     Parent* parent;            // Pointer to the parent window or container
     int x, y;                  // Position of the button (logical)
     int w, h;                  // Width and height of the button (logical)
     char* label;               // Button label text
     void (*callback)(void);    // Callback function on click
+    ButtonFn on_click;         // Click callback with user data (see set_button_on_click)
+    void* click_userdata;      // Passed to on_click
+    void* async_userdata;      // Passed to async_work and async_done
+    WorkerFn async_work;       // Runs on a worker thread on click (see set_button_async)
+    ButtonFn async_done;       // Runs on the UI thread once async_work returns
+    struct ButtonTask* task;   // Running async job; the button is busy while set
     int is_hovered;            // Is the mouse hovering over the button?
     int is_pressed;            // Is the button pressed?
     Color* custom_bg_color;    // Optional override for bg color (NULL = use theme)
     Color* custom_text_color;  // Optional override for text color (NULL = use theme)
+    ChildRect rect_cache;      // Cached physical rect (see get_child_rect)
 } Button;
 
+// An async click in flight; outlives the button if it is freed meanwhile
+typedef struct ButtonTask {
+    Button* button;            // NULL once the button is freed
+    WorkerFn work;
+    ButtonFn done;
+    void* userdata;
+} ButtonTask;
+
 
 Button new_button(Parent* parent, int x, int y, int w, int h, const char* label, void (*callback)(void)) {
     if (!parent || !parent->base.sdl_renderer) {
-        printf("Invalid parent or renderer\n");
+        LOG_ERROR("Invalid parent or renderer");
     }
 
     Button new_button;
@@ -44,13 +63,20 @@ Button new_button(Parent* parent, int x, int y, int w, int h, const char* label,
     new_button.h = h;
     new_button.label = strdup(label);
     if (!new_button.label) {
-        printf("Failed to allocate memory for button label\n");
+        LOG_ERROR("Failed to allocate memory for button label");
     }
     new_button.callback = callback;
+    new_button.on_click = NULL;
+    new_button.click_userdata = NULL;
+    new_button.async_userdata = NULL;
+    new_button.async_work = NULL;
+    new_button.async_done = NULL;
+    new_button.task = NULL;
     new_button.is_hovered = 0;
     new_button.is_pressed = 0;
     new_button.custom_bg_color = NULL;
     new_button.custom_text_color = NULL;
+    new_button.rect_cache = (ChildRect){0};
 
     return new_button;
 }
@@ -75,84 +101,154 @@ void set_button_text_color(Button* button, Color color) {
     }
 }
 
-void render_button(Button* button) {
-    if (!button || !button->parent || !button->parent->base.sdl_renderer || !button->parent->is_open) {
-        printf("Invalid button, renderer, or parent is not open\n");
+// Click callback that receives the button and user data; runs on the UI thread
+void set_button_on_click(Button* button, ButtonFn on_click, void* userdata) {
+    if (button) {
+        button->on_click = on_click;
+        button->click_userdata = userdata;
+    }
+}
+
+// Runs `work` on a worker thread when clicked, so slow work (I/O, exports) does not
+// freeze the UI; `done` then runs on the UI thread. The button is busy (drawn dimmed,
+// clicks ignored) in between. `work` gets userdata only and must not touch widgets.
+void set_button_async(Button* button, WorkerFn work, ButtonFn done, void* userdata) {
+    if (button) {
+        button->async_work = work;
+        button->async_done = done;
+        button->async_userdata = userdata;
+    }
+}
+
+static inline bool is_button_busy(Button* button) {
+    return button && button->task;
+}
+
+static inline void redraw_button_(Button* button) {
+    mark_child_dirty(button->parent, get_child_rect(button->parent, &button->rect_cache, button->x, button->y, button->w, button->h));
+}
+
+static inline void run_button_task_(void* userdata) {
+    ButtonTask* task = (ButtonTask*)userdata;
+    task->work(task->userdata);
+}
+
+static inline void finish_button_task_(void* userdata) {
+    ButtonTask* task = (ButtonTask*)userdata;
+    Button* button = task->button;
+    if (button) {
+        button->task = NULL;
+        redraw_button_(button);
+        if (task->done) task->done(button, task->userdata);
+    }
+    free(task);
+}
+
+static inline void start_button_task_(Button* button) {
+    ButtonTask* task = (ButtonTask*)malloc(sizeof(ButtonTask));
+    if (!task) {
+        LOG_ERROR("Failed to start button task");
+        return;
+    }
+    task->button = button;
+    task->work = button->async_work;
+    task->done = button->async_done;
+    task->userdata = button->async_userdata;
+    button->task = task;
+    redraw_button_(button);
+    if (!run_in_background(run_button_task_, finish_button_task_, task)) {
+        button->task = NULL;
+        free(task);
+    }
+}
+
+// Records the button into `list`; safe on a job worker (fonts are opened at submit)
+static inline void record_button_(DrawList* list, Button* button) {
+    if (!button || !button->parent || !button->parent->base.sdl_renderer) {
+        LOG_ERROR("Invalid button or renderer");
         return;
     }
+    // Children of a closed container are skipped every frame; not worth a message
+    if (!is_parent_open(button->parent)) return;
+    // Absolute physical rect, cached until the button or an ancestor moves
+    SDL_Rect rect = get_child_rect(button->parent, &button->rect_cache, button->x, button->y, button->w, button->h);
+    // Skip widgets scrolled out of the parent's viewport or hidden behind an opaque container
+    if (!is_child_visible(button->parent, rect) || is_child_occluded(button->parent, rect)) return;
+
 	//set container clipping
 	if(button->parent->is_window == false){
 	SDL_Rect parent_bounds = get_parent_rect(button->parent);
-	SDL_RenderSetClipRect(button->parent->base.sdl_renderer, &parent_bounds);
+	record_clip_(list, &button->parent->base, &parent_bounds);
 	}
 
-    // Fallback if no theme set
-    if (!current_theme) {
-        // Use hardcoded defaults (your original colors)
-        current_theme = (Theme*)&THEME_LIGHT;  // Or set a static fallback
-    }
-
     float dpi = button->parent->base.dpi_scale;
-    // Calculate absolute position relative to parent (logical), then scale
-    int abs_x = button->x + button->parent->x;
-    int abs_y = button->y + button->parent->y + button->parent->title_height;  // <-- Key offset here
-    int sx = (int)roundf(abs_x * dpi);
-    int sy = (int)roundf(abs_y * dpi);
-    int sw = (int)roundf(button->w * dpi);
-    int sh = (int)roundf(button->h * dpi);
+    int sx = rect.x;
+    int sy = rect.y;
+    int sw = rect.w;
+    int sh = rect.h;
     float roundness = current_theme->roundness;  // Roundness is a ratio (0-1), no scaling needed
     int font_size = (int)roundf(current_theme->default_font_size * dpi);
 
     // Determine bg color: custom > theme state variants
     Color button_color = button->custom_bg_color ? *button->custom_bg_color : current_theme->button_normal;
-    if (button->is_pressed) {
+    if (button->task) {
+        // Busy: dimmed and unresponsive until the async work is done
+        button_color = darken_color(button->custom_bg_color ? *button->custom_bg_color : current_theme->button_normal, 0.35f);
+    } else if (button->is_pressed) {
         button_color = button->custom_bg_color ? darken_color(*button->custom_bg_color, 0.2f) : current_theme->button_pressed;
     } else if (button->is_hovered) {
         button_color = button->custom_bg_color ? lighten_color(*button->custom_bg_color, 0.1f) : current_theme->button_hovered;
     }
 
     // Draw rounded rectangle (use theme roundness)
-    draw_rounded_rect_(&(button->parent->base), sx, sy, sw, sh, roundness, button_color);
+    record_rounded_rect_(list, &(button->parent->base), sx, sy, sw, sh, roundness, button_color);
 
     // Draw text centered
     if (button->label) {
         char* font_file = current_theme->font_file ? current_theme->font_file : "FreeMono.ttf";
-        TTF_Font* font = TTF_OpenFont(font_file, font_size);
-        if (font) {
-            int text_w, text_h;
-            TTF_SizeText(font, button->label, &text_w, &text_h);
-            int text_x = sx + (sw - text_w) / 2;
-            int text_y = sy + (sh - text_h) / 2;
-            Color text_color = button->custom_text_color ? *button->custom_text_color : current_theme->button_text;
-            draw_text_from_font_(&(button->parent->base), font, button->label, text_x, text_y, text_color, ALIGN_LEFT);
-            TTF_CloseFont(font);
+        Color text_color = button->custom_text_color ? *button->custom_text_color : current_theme->button_text;
+        if (button->task) {
+            // Halfway to the background, like a disabled label
+            text_color.r = (Uint8)((text_color.r + button_color.r) / 2);
+            text_color.g = (Uint8)((text_color.g + button_color.g) / 2);
+            text_color.b = (Uint8)((text_color.b + button_color.b) / 2);
         }
+        record_text_centered_(list, &(button->parent->base), font_file, font_size, button->label, rect, text_color);
     }
     // Reset clipping
-    SDL_RenderSetClipRect(button->parent->base.sdl_renderer, NULL);
+    record_clip_(list, &button->parent->base, NULL);
+}
+
+void render_button(Button* button) {
+    record_button_(begin_immediate_draw_(), button);
+    end_immediate_draw_();
 }
 
 void update_button(Button* button, SDL_Event event) {
-    if (!button || !button->parent || !button->parent->is_open) {
-        printf("Invalid button, parent, or parent is not open\n");
+    if (!button || !button->parent) {
+        LOG_ERROR("Invalid button or parent");
         return;
     }
+    // Children of a closed container are skipped every frame; not worth a message
+    if (!is_parent_open(button->parent)) return;
 
     // Calculate absolute position relative to parent (logical)
-    int abs_x = button->x + button->parent->x;
-    int abs_y = button->y + button->parent->y+ button->parent->title_height;
+    int abs_x = button->x + button->parent->content_x;
+    int abs_y = button->y + button->parent->content_y;
 
     int mouseX, mouseY;
     SDL_GetMouseState(&mouseX, &mouseY);
 
     // Check if mouse is over the button (logical)
     int over = (mouseX >= abs_x && mouseX <= abs_x + button->w &&
-                mouseY >= abs_y && mouseY <= abs_y + button->h);
+                mouseY >= abs_y && mouseY <= abs_y + button->h) &&
+               is_logical_point_in_parent_clip(button->parent, mouseX, mouseY);
 
+    int was_hovered = button->is_hovered, was_pressed = button->is_pressed;
     if (event.type == SDL_MOUSEMOTION) {
         button->is_hovered = over;
     } else if (event.type == SDL_MOUSEBUTTONDOWN && event.button.button == SDL_BUTTON_LEFT) {
-        if (over) {
+        if (over && !button->task) {
             button->is_pressed = 1;
         }
     } else if (event.type == SDL_MOUSEBUTTONUP && event.button.button == SDL_BUTTON_LEFT) {
@@ -160,13 +256,21 @@ void update_button(Button* button, SDL_Event event) {
             if (button->callback) {
                 button->callback();
             }
+            if (button->on_click) {
+                button->on_click(button, button->click_userdata);
+            }
+            if (button->async_work) {
+                start_button_task_(button);
+            }
         }
         button->is_pressed = 0;
     }
+    if (button->is_hovered != was_hovered || button->is_pressed != was_pressed) redraw_button_(button);
 }
 
 void free_button(Button* button) {
     if (button) {
+        if (button->task) button->task->button = NULL;  // Its done callback is skipped
         free(button->label);
         if (button->custom_bg_color) free(button->custom_bg_color);
         if (button->custom_text_color) free(button->custom_text_color);
@@ -3,9 +3,10 @@
 
 #include <math.h>  // For roundf in scaling
 
+// root may be the window or another container; x, y are relative to its content area
 static inline Parent new_container(Parent* root, int x, int y, int w, int h) {
-    if (!root || !root->is_window) {
-        printf("invalid parent passed on container!\n");
+    if (!root || !root->base.sdl_renderer) {
+        LOG_ERROR("invalid parent passed on container!");
     }
 
     Parent parent;
@@ -15,6 +16,7 @@ static inline Parent new_container(Parent* root, int x, int y, int w, int h) {
     parent.base.dpi_scale    = root->base.dpi_scale;  // Propagate DPI scale from root
 
     parent.is_window = 0;
+    parent.parent = root;
     parent.x = x;
     parent.y = y;
     parent.w = w;
@@ -34,6 +36,18 @@ static inline Parent new_container(Parent* root, int x, int y, int w, int h) {
     parent.resize_zone = 5;
     parent.is_open = true;
     parent.title_height = 0;
+    parent.scrollable = false;
+    parent.scroll_x = 0;
+    parent.scroll_y = 0;
+    parent.content_w = 0;
+    parent.content_h = 0;
+    parent.scroll_drag = 0;
+    parent.scroll_drag_offset = 0;
+    parent.layout = NULL;
+    parent.z_index = -1;  // Assigned on registration
+    parent.draw_slot = 0;
+    parent.transform_version = 0;
+    update_parent_transform(&parent);
 
     return parent;
 }
@@ -51,36 +65,179 @@ static inline void set_container_properties(Parent* container,
     container->closeable = closeable;
     container->resizeable = false; // should be assigned to resizeable, but feature is off for now
     container->title_height = has_title_bar ? 30 : 0;
+    update_parent_transform(container);
 }
 
-static inline void draw_title_bar_(Parent* container) {
-    if (!container || !container->has_title_bar) return;
+// -------- Scrolling --------
+#define SCROLLBAR_SIZE 10   // Logical thickness of scrollbars
+#define SCROLL_STEP 40      // Logical distance per mouse wheel notch
+
+// Keeps the scroll offset inside [0, content - viewport]
+static inline void clamp_container_scroll_(Parent* container) {
+    int view_w = container->w;
+    int view_h = container->h - container->title_height;
+    int max_x = container->content_w - view_w;
+    int max_y = container->content_h - view_h;
+    if (container->scroll_x > max_x) container->scroll_x = max_x;
+    if (container->scroll_y > max_y) container->scroll_y = max_y;
+    if (container->scroll_x < 0) container->scroll_x = 0;
+    if (container->scroll_y < 0) container->scroll_y = 0;
+}
 
-    // Fallback if no theme set
-    if (!current_theme) {
-        current_theme = (Theme*)&THEME_LIGHT;  // Or set a static fallback
+static inline void set_container_scrollable(Parent* container, bool scrollable) {
+    if (!container) return;
+    container->scrollable = scrollable;
+    if (!scrollable) {
+        container->scroll_x = 0;
+        container->scroll_y = 0;
     }
+    update_parent_transform(container);
+}
+
+// Overrides the scrollable extent (normally grown automatically by the children)
+static inline void set_container_content_size(Parent* container, int w, int h) {
+    if (!container) return;
+    container->content_w = w;
+    container->content_h = h;
+    clamp_container_scroll_(container);
+    update_parent_transform(container);
+}
+
+static inline void scroll_container_to(Parent* container, int x, int y) {
+    if (!container) return;
+    container->scroll_x = x;
+    container->scroll_y = y;
+    clamp_container_scroll_(container);
+    update_parent_transform(container);
+}
+
+/**
+ * @brief Physical track and thumb rects of a container scrollbar.
+ * @param vertical true for the right-hand bar, false for the bottom bar.
+ * @return false if the content fits and no bar is shown.
+ */
+static inline bool get_scrollbar_rects_(Parent* container, bool vertical, SDL_Rect* track, SDL_Rect* thumb) {
+    if (!container->scrollable) return false;
 
     float dpi = container->base.dpi_scale;
-    int sx = (int)roundf(container->x * dpi);
-    int sy = (int)roundf(container->y * dpi);
-    int sw = (int)roundf(container->w * dpi);
+    int view_w = container->w;
+    int view_h = container->h - container->title_height;
+    int content = vertical ? container->content_h : container->content_w;
+    int view = vertical ? view_h : view_w;
+    if (content <= view || view <= 0) return false;
+
+    int bar = (int)roundf(SCROLLBAR_SIZE * dpi);
+    SDL_Rect body = {container->screen_rect.x,
+                     (int)roundf((container->abs_y + container->title_height) * dpi),
+                     container->screen_rect.w,
+                     (int)roundf(view_h * dpi)};
+    if (vertical) {
+        *track = (SDL_Rect){body.x + body.w - bar, body.y, bar, body.h};
+    } else {
+        *track = (SDL_Rect){body.x, body.y + body.h - bar, body.w, bar};
+    }
+
+    int track_len = vertical ? track->h : track->w;
+    int thumb_len = track_len * view / content;
+    int min_thumb = (int)roundf(20 * dpi);
+    if (thumb_len < min_thumb) thumb_len = min_thumb;
+    int max_scroll = content - view;
+    int scroll = vertical ? container->scroll_y : container->scroll_x;
+    int thumb_pos = (int)((float)scroll / max_scroll * (track_len - thumb_len));
+
+    if (vertical) {
+        *thumb = (SDL_Rect){track->x, track->y + thumb_pos, track->w, thumb_len};
+    } else {
+        *thumb = (SDL_Rect){track->x + thumb_pos, track->y, thumb_len, track->h};
+    }
+    return true;
+}
+
+// Maps a thumb position (physical, along the track) back to a logical scroll offset
+static inline void scroll_from_thumb_(Parent* container, bool vertical, int thumb_pos) {
+    SDL_Rect track, thumb;
+    if (!get_scrollbar_rects_(container, vertical, &track, &thumb)) return;
+
+    int track_len = vertical ? track.h : track.w;
+    int thumb_len = vertical ? thumb.h : thumb.w;
+    int view = vertical ? container->h - container->title_height : container->w;
+    int content = vertical ? container->content_h : container->content_w;
+    int range = track_len - thumb_len;
+    int scroll = range > 0 ? (int)((float)thumb_pos / range * (content - view)) : 0;
+
+    if (vertical) container->scroll_y = scroll;
+    else container->scroll_x = scroll;
+    clamp_container_scroll_(container);
+    update_parent_transform(container);
+}
+
+// Applies a mouse wheel event if the mouse is over this container's viewport
+static inline bool scroll_container_by_wheel_(Parent* container, SDL_Event event) {
+    if (!container || !container->scrollable || !is_parent_open(container)) return false;
+
+    int mouse_x, mouse_y;
+    SDL_GetMouseState(&mouse_x, &mouse_y);
+    if (!is_point_in_parent_clip(container, mouse_x, mouse_y)) return false;
+
+    int old_x = container->scroll_x;
+    int old_y = container->scroll_y;
+    container->scroll_y -= event.wheel.y * SCROLL_STEP;
+    container->scroll_x += event.wheel.x * SCROLL_STEP;
+    clamp_container_scroll_(container);
+    update_parent_transform(container);
+    return old_x != container->scroll_x || old_y != container->scroll_y;
+}
+
+// Records the scrollbars into `list`; safe on a job worker
+static inline void record_container_scrollbars_(DrawList* list, Parent* container) {
+    if (!container || !container->scrollable || !is_parent_open(container)) return;
+
+    SDL_Rect clip = get_parent_rect(container);
+    record_clip_(list, &container->base, &clip);
+
+    SDL_Rect track, thumb;
+    for (int vertical = 1; vertical >= 0; vertical--) {
+        if (get_scrollbar_rects_(container, vertical, &track, &thumb)) {
+            bool dragging = container->scroll_drag == (vertical ? 1 : 2);
+            record_rect_(list, &container->base, track.x, track.y, track.w, track.h, current_theme->bg_secondary);
+            record_rect_(list, &container->base, thumb.x, thumb.y, thumb.w, thumb.h,
+                         dragging ? current_theme->accent_pressed : current_theme->accent);
+        }
+    }
+
+    // Reset clipping
+    record_clip_(list, &container->base, NULL);
+}
+
+static inline void render_container_scrollbars(Parent* container) {
+    record_container_scrollbars_(begin_immediate_draw_(), container);
+    end_immediate_draw_();
+}
+
+static inline void record_title_bar_(DrawList* list, Parent* container) {
+    if (!container || !container->has_title_bar) return;
+
+    float dpi = container->base.dpi_scale;
+    int sx = container->screen_rect.x;
+    int sy = container->screen_rect.y;
+    int sw = container->screen_rect.w;
     int sth = (int)roundf(container->title_height * dpi);
     int pad = (int)roundf(current_theme->padding * dpi);
     int font_size = (int)roundf(current_theme->default_font_size * dpi);
 
-    draw_rect_(&container->base,
-               sx, sy,
-               sw, sth,
-               current_theme->container_title_bg);  // Use theme-specific title bg
+    record_rect_(list, &container->base,
+                 sx, sy,
+                 sw, sth,
+                 current_theme->container_title_bg);  // Use theme-specific title bg
 
     if (container->title_bar) {
-        draw_text_(&container->base,
-                   container->title_bar,
-                   font_size,
-                   sx + pad,
-                   sy + pad / 2,  // Approximate vertical centering
-                   current_theme->text_primary);  // Use theme text color
+        record_text_(list, &container->base, NULL,
+                     font_size,
+                     container->title_bar,
+                     sx + pad,
+                     sy + pad / 2,  // Approximate vertical centering
+                     current_theme->text_primary,  // Use theme text color
+                     ALIGN_LEFT);
     }
 
     if (container->closeable) {
@@ -90,52 +247,71 @@ static inline void draw_title_bar_(Parent* container) {
         int btn_y = sy + pad / 2;
         // Use slightly smaller font for "X" (90% of default for better fit)
         int close_font_size = (int)roundf(current_theme->default_font_size * 0.9f * dpi);
-        draw_text_(&container->base, "X", close_font_size, btn_x + btn_size / 4, btn_y + btn_size / 4,
-                   current_theme->text_primary);  // Use theme text color
+        record_text_(list, &container->base, NULL, close_font_size, "X", btn_x + btn_size / 4, btn_y + btn_size / 4,
+                     current_theme->text_primary, ALIGN_LEFT);  // Use theme text color
     }
 }
 
-static inline void render_container(Parent* container) {
-    if (!container || !container->is_open) return;
-
-    // Fallback if no theme set
-    if (!current_theme) {
-        current_theme = (Theme*)&THEME_LIGHT;  // Or set a static fallback
-    }
+// Records the title bar and body into `list`; safe on a job worker
+static inline void record_container_(DrawList* list, Parent* container) {
+    if (!container || !is_parent_open(container)) return;
 
     float dpi = container->base.dpi_scale;
-    int sx = (int)roundf(container->x * dpi);
-    int body_y = (int)roundf((container->y + container->title_height) * dpi);
-    int sw = (int)roundf(container->w * dpi);
+    int sx = container->screen_rect.x;
+    int body_y = (int)roundf((container->abs_y + container->title_height) * dpi);  // Body does not scroll, only its children
+    int sw = container->screen_rect.w;
     int body_h = (int)roundf((container->h - container->title_height) * dpi);
 
-    draw_title_bar_(container);
+    // Nested containers scrolled or clipped out of view are skipped
+    if (container->parent && !is_child_visible(container->parent, container->screen_rect)) return;
+
+    // Nested containers are clipped to their ancestors
+    if (container->parent && !container->parent->is_window) {
+        SDL_Rect parent_bounds = get_parent_rect(container->parent);
+        record_clip_(list, &container->base, &parent_bounds);
+    }
+
+    record_title_bar_(list, container);
 
     // Draw main container rect using theme container_bg
-    draw_rect_(&container->base,
-               sx,
-               body_y,
-               sw,
-               body_h,
-               current_theme->container_bg);
+    record_rect_(list, &container->base,
+                 sx,
+                 body_y,
+                 sw,
+                 body_h,
+                 current_theme->container_bg);
+
+    // Reset clipping
+    record_clip_(list, &container->base, NULL);
 }
 
-static inline void update_container(Parent* container, SDL_Event event) {
-    if (!container || !container->is_open) return;
+static inline void render_container(Parent* container) {
+    record_container_(begin_immediate_draw_(), container);
+    end_immediate_draw_();
+}
+
+static inline void handle_container_event_(Parent* container, SDL_Event event) {
 
     float dpi = container->base.dpi_scale;
-    // Scale bounds to physical
-    int s_x = (int)roundf(container->x * dpi);
-    int s_y = (int)roundf(container->y * dpi);
-    int s_w = (int)roundf(container->w * dpi);
-    int s_h = (int)roundf(container->h * dpi);
+    // Physical bounds from the cached transform
+    int s_x = container->screen_rect.x;
+    int s_y = container->screen_rect.y;
+    int s_w = container->screen_rect.w;
+    int s_h = container->screen_rect.h;
     int s_title_h = (int)roundf(container->title_height * dpi);
     int s_resize_zone = (int)roundf(container->resize_zone * dpi);
 
     int mouse_x, mouse_y;
     SDL_GetMouseState(&mouse_x, &mouse_y);
 
-    bool in_title_bar = container->has_title_bar &&
+    // Parts of a nested container outside its ancestors' clip are not interactive
+    bool in_parent_clip = true;
+    if (container->parent && !container->parent->is_window) {
+        SDL_Point mouse = {mouse_x, mouse_y};
+        in_parent_clip = SDL_PointInRect(&mouse, &container->parent->clip_rect);
+    }
+
+    bool in_title_bar = in_parent_clip && container->has_title_bar &&
         mouse_x >= s_x &&
         mouse_x <= s_x + s_w &&
         mouse_y >= s_y &&
@@ -147,20 +323,65 @@ static inline void update_container(Parent* container, SDL_Event event) {
         int btn_size = 20;  // Logical
         int s_btn_size = (int)roundf(btn_size * dpi);
         // Logical btn pos relative to container
-        int btn_x = container->x + container->w - btn_size - 5;
-        int btn_y = container->y + 5;
+        int btn_x = container->abs_x + container->w - btn_size - 5;
+        int btn_y = container->abs_y + 5;
         int s_btn_x = (int)roundf(btn_x * dpi);
         int s_btn_y = (int)roundf(btn_y * dpi);
-        in_close_button = mouse_x >= s_btn_x && mouse_x <= s_btn_x + s_btn_size &&
+        in_close_button = in_parent_clip &&
+                          mouse_x >= s_btn_x && mouse_x <= s_btn_x + s_btn_size &&
                           mouse_y >= s_btn_y && mouse_y <= s_btn_y + s_btn_size;
     }
 
-    bool in_resize_area = container->resizeable &&
+    bool in_resize_area = in_parent_clip && container->resizeable &&
         mouse_x >= s_x + s_w - s_resize_zone &&
         mouse_x <= s_x + s_w &&
         mouse_y >= s_y + s_h - s_resize_zone &&
         mouse_y <= s_y + s_h;
 
+    // Scrollbars take the click before the rest of the container
+    SDL_Rect bar_track, bar_thumb;
+    SDL_Point mouse = {mouse_x, mouse_y};
+    switch (event.type) {
+        case SDL_MOUSEBUTTONDOWN:
+            if (event.button.button == SDL_BUTTON_LEFT && in_parent_clip) {
+                for (int vertical = 1; vertical >= 0; vertical--) {
+                    if (get_scrollbar_rects_(container, vertical, &bar_track, &bar_thumb) &&
+                        SDL_PointInRect(&mouse, &bar_track)) {
+                        int along = vertical ? mouse_y : mouse_x;
+                        int thumb_start = vertical ? bar_thumb.y : bar_thumb.x;
+                        int thumb_len = vertical ? bar_thumb.h : bar_thumb.w;
+                        int track_start = vertical ? bar_track.y : bar_track.x;
+                        if (!SDL_PointInRect(&mouse, &bar_thumb)) {
+                            // Clicking the track centers the thumb on the mouse
+                            scroll_from_thumb_(container, vertical, along - track_start - thumb_len / 2);
+                            get_scrollbar_rects_(container, vertical, &bar_track, &bar_thumb);
+                            thumb_start = vertical ? bar_thumb.y : bar_thumb.x;
+                        }
+                        container->scroll_drag = vertical ? 1 : 2;
+                        container->scroll_drag_offset = along - thumb_start;
+                        return;
+                    }
+                }
+            }
+            break;
+        case SDL_MOUSEBUTTONUP:
+            if (event.button.button == SDL_BUTTON_LEFT && container->scroll_drag) {
+                container->scroll_drag = 0;
+                return;
+            }
+            break;
+        case SDL_MOUSEMOTION:
+            if (container->scroll_drag) {
+                bool vertical = container->scroll_drag == 1;
+                if (get_scrollbar_rects_(container, vertical, &bar_track, &bar_thumb)) {
+                    int along = vertical ? mouse_y - bar_track.y : mouse_x - bar_track.x;
+                    scroll_from_thumb_(container, vertical, along - container->scroll_drag_offset);
+                }
+                return;
+            }
+            break;
+    }
+
     switch (event.type) {
         case SDL_MOUSEBUTTONDOWN:
             if (event.button.button == SDL_BUTTON_LEFT) {
@@ -186,19 +407,38 @@ static inline void update_container(Parent* container, SDL_Event event) {
 
         case SDL_MOUSEMOTION:
             if (container->is_dragging) {
+                // x, y stay relative to the parent, which does not move during the drag
                 container->x = (int)roundf(mouse_x / dpi) - container->drag_offset_x;
                 container->y = (int)roundf(mouse_y / dpi) - container->drag_offset_y;
             } else if (container->is_resizing) {
-                container->w = (int)roundf(mouse_x / dpi) - container->x;
-                container->h = (int)roundf(mouse_y / dpi) - container->y;
+                container->w = (int)roundf(mouse_x / dpi) - container->abs_x;
+                container->h = (int)roundf(mouse_y / dpi) - container->abs_y;
                 if (container->h < container->title_height + 50) {
                     container->h = container->title_height + 50;
                 }
             }
+            update_parent_transform(container);
             break;
     }
 }
 
+static inline void update_container(Parent* container, SDL_Event event) {
+    if (!container || !is_parent_open(container)) return;
+
+    update_parent_transform(container);
+    SDL_Rect before = container->screen_rect;
+    int scroll_x = container->scroll_x, scroll_y = container->scroll_y, scroll_drag = container->scroll_drag;
+    handle_container_event_(container, event);
+
+    // Moved, resized, scrolled or closed: redraw where it was and where it is now
+    update_parent_transform(container);
+    if (!SDL_RectEquals(&before, &container->screen_rect) || !is_parent_open(container) ||
+        container->scroll_x != scroll_x || container->scroll_y != scroll_y || container->scroll_drag != scroll_drag) {
+        mark_dirty_rect(before);
+        if (is_parent_open(container)) mark_dirty_rect(container->screen_rect);
+    }
+}
+
 // registering stuffs
 
 #define MAX_CONTAINERS 100
@@ -209,22 +449,131 @@ static int containers_count = 0;
 static inline void register_container(Parent* container) {
     if (containers_count < MAX_CONTAINERS) {
         container_widgets[containers_count] = container;
+        container->z_index = containers_count;  // Later registrations draw on top
         containers_count++;
     }
 }
 
+// -------- Occlusion --------
+// Visible bodies of opaque containers, rebuilt once per frame in draw order
+static SDL_Rect occluder_rects_[MAX_CONTAINERS];
+static Parent* occluder_owners_[MAX_CONTAINERS];
+static int occluders_count = 0;
+
+/**
+ * @brief Collects the opaque container bodies that can hide what is drawn below them.
+ *        Call once per frame after transforms are up to date and before rendering.
+ */
+static inline void update_container_occluders(void) {
+    occluders_count = 0;
+    if (!current_theme) {
+        current_theme = (Theme*)&THEME_LIGHT;
+    }
+    // Translucent bodies let everything below show through
+    if (current_theme->container_bg.a != 255) return;
+
+    for (int i = 0; i < containers_count; i++) {
+        Parent* container = container_widgets[i];
+        if (!container || !is_parent_open(container)) continue;
+        if (container->parent && !is_child_visible(container->parent, container->screen_rect)) continue;
+        if (container->clip_rect.w <= 0 || container->clip_rect.h <= 0) continue;
+        occluder_rects_[occluders_count] = container->clip_rect;
+        occluder_owners_[occluders_count] = container;
+        occluders_count++;
+    }
+}
+
+static inline bool is_ancestor_or_self_(Parent* maybe_ancestor, Parent* node) {
+    while (node) {
+        if (node == maybe_ancestor) return true;
+        node = node->is_window ? NULL : node->parent;
+    }
+    return false;
+}
+
+/**
+ * @brief Checks whether a physical rect belonging to `node` is entirely covered by
+ *        a single opaque container drawn above it (higher z, not one of its ancestors).
+ *        Widgets of a window (or of an unregistered container, z_index -1) are drawn
+ *        after every container (frame.h), so nothing covers them.
+ */
+static inline bool is_rect_occluded_(Parent* node, SDL_Rect box) {
+    if (node->z_index < 0) return false;
+    for (int i = 0; i < occluders_count; i++) {
+        Parent* owner = occluder_owners_[i];
+        if (owner->z_index <= node->z_index || is_ancestor_or_self_(owner, node)) continue;
+        SDL_Rect o = occluder_rects_[i];
+        if (box.x >= o.x && box.y >= o.y &&
+            box.x + box.w <= o.x + o.w && box.y + box.h <= o.y + o.h) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Checks whether the visible part of a child rect is hidden behind an opaque container.
+ *        Widgets call it right after is_child_visible to skip rendering entirely.
+ */
+static inline bool is_child_occluded(Parent* parent, SDL_Rect rect) {
+    SDL_Rect box = rect;
+    if (box.w <= 0) box.w = 1;
+    if (box.h <= 0) box.h = 1;
+    SDL_Rect visible;
+    if (!SDL_IntersectRect(&box, &parent->clip_rect, &visible)) return false;
+    // Outside the region redrawn this frame counts as hidden too (see damage.h)
+    return !is_in_damage_(visible) || is_rect_occluded_(parent, visible);
+}
+
+static inline bool is_container_occluded_(Parent* container) {
+    SDL_Rect visible = container->screen_rect;
+    if (container->parent && !container->parent->is_window &&
+        !SDL_IntersectRect(&container->screen_rect, &container->parent->clip_rect, &visible)) {
+        return false;
+    }
+    return !is_in_damage_(visible) || is_rect_occluded_(container, visible);
+}
+
 static inline void render_all_registered_containers(void) {
     for (int i = 0; i < containers_count; i++) {
+        // Containers fully hidden behind a later opaque container are not drawn
+        if (container_widgets[i] && is_container_occluded_(container_widgets[i])) continue;
         render_container(container_widgets[i]);
     }
 }
 
+// Refreshes cached transforms of all registered containers (and their ancestors).
+// Cheap when nothing moved: each node only compares its cached inputs.
+static inline void update_all_registered_container_transforms(void) {
+    for (int i = 0; i < containers_count; i++) {
+        update_parent_transform(container_widgets[i]);
+    }
+}
+
 static inline void update_all_registered_containers(SDL_Event event) {
+    if (event.type == SDL_MOUSEWHEEL) {
+        // Innermost/topmost containers are registered last and scroll first
+        for (int i = containers_count - 1; i >= 0; i--) {
+            if (scroll_container_by_wheel_(container_widgets[i], event)) {
+                mark_dirty_rect(container_widgets[i]->screen_rect);
+                break;
+            }
+        }
+        return;
+    }
     for (int i = 0; i < containers_count; i++) {
         update_container(container_widgets[i], event);
     }
 }
 
+// Scrollbars are drawn after all widgets so children never cover them
+static inline void render_all_registered_scrollbars(void) {
+    for (int i = 0; i < containers_count; i++) {
+        if (container_widgets[i] && is_container_occluded_(container_widgets[i])) continue;
+        render_container_scrollbars(container_widgets[i]);
+    }
+}
+
 static inline void free_con_(Parent* parent) {
     if (!parent) return;
     if (parent->is_window) {
@@ -28,6 +28,9 @@ typedef struct {
     Color* custom_button_color;   // Background for dropdown button
     Color* custom_text_color;     // Text color
     Color* custom_highlight_color; // Highlight for selected/hovered option
+    ChildRect rect_cache;   // Cached physical rect of the button (see get_child_rect)
+    Observable* binding;    // Optional int cell kept equal to selected_index (see bind_drop)
+    ChangeNotifier notifier; // Selection callbacks (see notify.h)
 } Drop;
 
 #define MAX_DROPS 100
@@ -37,7 +40,7 @@ static int drops_count = 0;
 
 Drop new_drop_down(Parent* parent, int x, int y, int w, int h, char** options, int option_count) {
     if (!parent || !parent->base.sdl_renderer) {
-        printf("Invalid parent or renderer\n");
+        LOG_ERROR("Invalid parent or renderer");
     }
 
     Drop drop;
@@ -57,13 +60,16 @@ Drop new_drop_down(Parent* parent, int x, int y, int w, int h, char** options, i
     drop.font_size = 0; // 0 = use theme default
     drop.place_holder = strdup("select option"); // Copy string to avoid issues
     if (!drop.place_holder) {
-        printf("Failed to allocate memory for placeholder\n");
+        LOG_ERROR("Failed to allocate memory for placeholder");
     }
     // Init overrides to NULL (use theme)
     drop.custom_bg_color = NULL;
     drop.custom_button_color = NULL;
     drop.custom_text_color = NULL;
     drop.custom_highlight_color = NULL;
+    drop.rect_cache = (ChildRect){0};
+    drop.binding = NULL;
+    drop.notifier = new_change_notifier_();
 
     return drop;
 }
@@ -112,38 +118,97 @@ static inline void set_drop_font_size(Drop* drop, int size) {
     }
 }
 
-static inline void draw_upside_down_triangle_(Base* base, int x1, int y1, int x2, int y2, int x3, int y3, Color color) {
+// Physical rect covered by the button, and by the option list while expanded
+static inline SDL_Rect drop_box_(Drop* drop) {
+    SDL_Rect box = get_child_rect(drop->parent, &drop->rect_cache, drop->x, drop->y, drop->w, drop->h);
+    if (drop->is_expanded) box.h += box.h * drop->option_count;
+    return box;
+}
+
+// Selects an option (-1 = none; out-of-range indices also clear the selection)
+static inline void set_drop_selected(Drop* drop, int index) {
+    if (!drop) return;
+    if (index < 0 || index >= drop->option_count) index = -1;
+    if (index != drop->selected_index) {
+        drop->selected_index = index;
+        mark_child_dirty(drop->parent, drop_box_(drop));
+    }
+    set_observable_int(drop->binding, drop->selected_index);
+}
+
+static inline void on_drop_binding_(Observable* cell, void* userdata) {
+    set_drop_selected((Drop*)userdata, get_observable_int(cell));
+}
+
+// Keeps the selected index and an int cell equal both ways; NULL unbinds
+static inline void bind_drop(Drop* drop, Observable* cell) {
+    if (!drop) return;
+    if (drop->binding) unobserve(drop->binding, on_drop_binding_, drop);
+    drop->binding = cell;
+    if (cell && observe(cell, on_drop_binding_, drop)) {
+        set_drop_selected(drop, get_observable_int(cell));
+    }
+}
+
+// Called with the new index when the user picks a different option
+static inline void set_drop_on_change(Drop* drop, ChangeFn on_change, void* userdata) {
+    if (drop) {
+        drop->notifier.widget = drop;
+        drop->notifier.on_change = on_change;
+        drop->notifier.change_userdata = userdata;
+    }
+}
+
+// Called on every pick, after on_change (also when the same option is picked again)
+static inline void set_drop_on_commit(Drop* drop, ChangeFn on_commit, void* userdata) {
+    if (drop) {
+        drop->notifier.widget = drop;
+        drop->notifier.on_commit = on_commit;
+        drop->notifier.commit_userdata = userdata;
+    }
+}
+
+// NOTIFY_PER_FRAME (default), or NOTIFY_THROTTLE / NOTIFY_DEBOUNCE with an interval
+static inline void set_drop_change_rate(Drop* drop, NotifyMode mode, Uint32 interval_ms) {
+    if (drop) set_change_rate_(&drop->notifier, mode, interval_ms);
+}
+
+static inline void record_upside_down_triangle_(DrawList* list, Base* base, int x1, int y1, int x2, int y2, int x3, int y3, Color color) {
     // Draw a downward-pointing triangle by defining vertices directly
     // (x1, y1) and (x2, y2) form the top horizontal line, (x3, y3) is the bottom point
-    draw_triangle_(base, x1, y1, x2, y2, x3, y3, color);
+    record_triangle_(list, base, x1, y1, x2, y2, x3, y3, color);
 }
 
-void render_drop_down_(Drop* drop) {
-    if (!drop || !drop->parent || !drop->parent->base.sdl_renderer || !drop->parent->is_open) {
-        printf("Invalid drop, renderer, or parent is not open\n");
+// Records the drop (and its open list) into `list`; safe on a job worker
+static inline void record_drop_down_(DrawList* list, Drop* drop) {
+    if (!drop || !drop->parent || !drop->parent->base.sdl_renderer) {
+        LOG_ERROR("Invalid drop or renderer");
         return;
     }
+    // Children of a closed container are skipped every frame; not worth a message
+    if (!is_parent_open(drop->parent)) return;
+
+    // An expanded list hangs below the button and counts towards visibility
+    SDL_Rect box = drop_box_(drop);
+    SDL_Rect rect = drop->rect_cache.rect;
+    // Skip widgets scrolled out of the parent's viewport or hidden behind an opaque container
+    if (!is_child_visible(drop->parent, box) || is_child_occluded(drop->parent, box)) return;
 
 	//set container clipping
 	if(drop->parent->is_window == false){
 	SDL_Rect parent_bounds = get_parent_rect(drop->parent);
-	SDL_RenderSetClipRect(drop->parent->base.sdl_renderer, &parent_bounds);
+	record_clip_(list, &drop->parent->base, &parent_bounds);
 	}
 
 	//
-    // Fallback if no theme set
-    if (!current_theme) {
-        current_theme = (Theme*)&THEME_LIGHT;  // Or set a static fallback
-    }
 
     float dpi = drop->parent->base.dpi_scale;
-    // Calculate absolute position relative to parent (logical), then scale
-    int abs_x = drop->x + drop->parent->x;
-    int abs_y = drop->y + drop->parent->y+ drop->parent->title_height;
-    int sx = (int)roundf(abs_x * dpi);
-    int sy = (int)roundf(abs_y * dpi);
-    int sw = (int)roundf(drop->w * dpi);
-    int sh = (int)roundf(drop->h * dpi);
+    // Absolute logical y (for the option list) and cached physical rect of the button
+    int abs_y = drop->y + drop->parent->content_y;
+    int sx = rect.x;
+    int sy = rect.y;
+    int sw = rect.w;
+    int sh = rect.h;
     int pad = (int)roundf(current_theme->padding * dpi);  // Use theme padding, scaled
     int effective_font_size = (int)roundf((drop->font_size > 0 ? drop->font_size : current_theme->default_font_size) * dpi);
 
@@ -159,7 +224,7 @@ void render_drop_down_(Drop* drop) {
     Color highlight_color = drop->custom_highlight_color ? *drop->custom_highlight_color : current_theme->accent;
 
     // Draw the main dropdown button
-    draw_rect_(base, sx, sy, sw, sh, button_color);
+    record_rect_(list, base, sx, sy, sw, sh, button_color);
 
     // Draw placeholder text if no option is selected, otherwise draw selected option
     const char* display_text = (drop->selected_index >= 0 && drop->selected_index < drop->option_count)
@@ -167,7 +232,7 @@ void render_drop_down_(Drop* drop) {
                               : drop->place_holder;
     // Vertical centering: approximate as (sh - font_size) / 2, but since font_size is scaled, it's fine
     int text_y = sy + (sh - effective_font_size) / 2;
-    draw_text_(base, display_text, effective_font_size, sx + pad, text_y, text_color);
+    record_text_(list, base, NULL, effective_font_size, display_text, sx + pad, text_y, text_color, ALIGN_LEFT);
 
     // Draw the dropdown arrow (down when collapsed, up when expanded)
     int arrow_size = (int)roundf((drop->h / 3) * dpi);  // Slightly larger than /4 for visibility
@@ -175,18 +240,18 @@ void render_drop_down_(Drop* drop) {
     int arrow_y = sy + (sh - arrow_size) / 2;
     if (drop->is_expanded) {
         // Upward-pointing triangle
-        draw_triangle_(base,
-                       arrow_x, arrow_y + arrow_size,
-                       arrow_x + arrow_size, arrow_y + arrow_size,
-                       arrow_x + arrow_size / 2, arrow_y,
-                       text_color);
+        record_triangle_(list, base,
+                         arrow_x, arrow_y + arrow_size,
+                         arrow_x + arrow_size, arrow_y + arrow_size,
+                         arrow_x + arrow_size / 2, arrow_y,
+                         text_color);
     } else {
         // Downward-pointing triangle
-        draw_upside_down_triangle_(base,
-                                  arrow_x, arrow_y,
-                                  arrow_x + arrow_size, arrow_y,
-                                  arrow_x + arrow_size / 2, arrow_y + arrow_size,
-                                  text_color);
+        record_upside_down_triangle_(list, base,
+                                     arrow_x, arrow_y,
+                                     arrow_x + arrow_size, arrow_y,
+                                     arrow_x + arrow_size / 2, arrow_y + arrow_size,
+                                     text_color);
     }
 
     // Draw options if expanded (NO bounds check anymore)
@@ -197,34 +262,45 @@ void render_drop_down_(Drop* drop) {
 
             // Draw option background
             Color option_bg = (i == drop->selected_index) ? highlight_color : bg_color;
-            draw_rect_(base, sx, soy, sw, sh, option_bg);
+            record_rect_(list, base, sx, soy, sw, sh, option_bg);
 
             // Draw option text
             int option_text_y = soy + (sh - effective_font_size) / 2;
-            draw_text_(base, drop->options[i],
-                       effective_font_size, sx + pad, option_text_y, text_color);
+            record_text_(list, base, NULL, effective_font_size, drop->options[i],
+                         sx + pad, option_text_y, text_color, ALIGN_LEFT);
         }
     }
     // Reset clipping
-        SDL_RenderSetClipRect(drop->parent->base.sdl_renderer, NULL);
+    record_clip_(list, base, NULL);
+}
+
+void render_drop_down_(Drop* drop) {
+    record_drop_down_(begin_immediate_draw_(), drop);
+    end_immediate_draw_();
 }
 
 void update_drop_down_(Drop* drop, SDL_Event event) {
-    if (!drop || !drop->parent || !drop->parent->is_open) {
-        printf("Invalid drop, parent, or parent is not open\n");
+    if (!drop || !drop->parent) {
+        LOG_ERROR("Invalid drop or parent");
         return;
     }
+    // Children of a closed container are skipped every frame; not worth a message
+    if (!is_parent_open(drop->parent)) return;
 
     // Calculate absolute position relative to parent (logical)
-    int abs_x = drop->x + drop->parent->x;
-    int abs_y = drop->y + drop->parent->y+ drop->parent->title_height;
+    int abs_x = drop->x + drop->parent->content_x;
+    int abs_y = drop->y + drop->parent->content_y;
 
     int mouse_x, mouse_y;
     SDL_GetMouseState(&mouse_x, &mouse_y);
 
     // Check if mouse is over the dropdown button for hover
     bool over_button = (mouse_x >= abs_x && mouse_x <= abs_x + drop->w &&
-                        mouse_y >= abs_y && mouse_y <= abs_y + drop->h);
+                        mouse_y >= abs_y && mouse_y <= abs_y + drop->h) &&
+                       is_logical_point_in_parent_clip(drop->parent, mouse_x, mouse_y);
+    bool was_hovered = drop->is_hovered, was_expanded = drop->is_expanded;
+    int was_selected = drop->selected_index;
+    SDL_Rect box = drop_box_(drop);  // Before it collapses
     drop->is_hovered = over_button;
 
     if (event.type == SDL_MOUSEBUTTONDOWN && event.button.button == SDL_BUTTON_LEFT) {
@@ -233,7 +309,8 @@ void update_drop_down_(Drop* drop, SDL_Event event) {
 
         // Check if click is on the dropdown button
         if (event_mouse_x >= abs_x && event_mouse_x <= abs_x + drop->w &&
-            event_mouse_y >= abs_y && event_mouse_y <= abs_y + drop->h) {
+            event_mouse_y >= abs_y && event_mouse_y <= abs_y + drop->h &&
+            is_logical_point_in_parent_clip(drop->parent, event_mouse_x, event_mouse_y)) {
             drop->is_expanded = !drop->is_expanded; // Toggle dropdown
         }
         // Check if click is on an option
@@ -243,7 +320,10 @@ void update_drop_down_(Drop* drop, SDL_Event event) {
                 int option_y = abs_y + drop->h * (i + 1);
                 if (event_mouse_x >= abs_x && event_mouse_x <= abs_x + drop->w &&
                     event_mouse_y >= option_y && event_mouse_y <= option_y + drop->h) {
+                    if (i != drop->selected_index) notify_change_(&drop->notifier, drop->selected_index, i);
                     drop->selected_index = i;
+                    set_observable_int(drop->binding, i);
+                    notify_commit_(&drop->notifier, i);
                     drop->is_expanded = false; // Close dropdown after selection
                     clicked_option = true;
                     break;
@@ -263,10 +343,17 @@ void update_drop_down_(Drop* drop, SDL_Event event) {
             drop->is_expanded = false;
         }
     }
+    if (drop->is_hovered != was_hovered || drop->is_expanded != was_expanded || drop->selected_index != was_selected) {
+        SDL_Rect now = drop_box_(drop);
+        SDL_UnionRect(&box, &now, &box);
+        mark_child_dirty(drop->parent, box);
+    }
 }
 
 void free_drop_(Drop* drop) {
     if (!drop) return;
+    bind_drop(drop, NULL);
+    free_change_notifier_(&drop->notifier);
     free(drop->place_holder); // Free the duplicated placeholder string
     if (drop->custom_bg_color) free(drop->custom_bg_color);
     if (drop->custom_button_color) free(drop->custom_button_color);
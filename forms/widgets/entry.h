@@ -17,6 +17,9 @@ typedef struct {
     int selection_start;       // Starting index of text selection (-1 if no selection)
     int visible_text_start;    // Index of the first visible character (for scrolling text)
     int is_mouse_selecting;    // Flag to track if mouse is being used to select text
+    ChildRect rect_cache;      // Cached physical rect (see get_child_rect)
+    Observable* binding;       // Optional text cell kept equal to the input (see bind_entry)
+    CursorBlink blink;         // Cursor blink while active (see timers.h)
 } Entry;
 
 
@@ -30,7 +33,7 @@ typedef struct {
 Entry new_entry(Parent* parent, int x, int y, int w, int max_length) {
     // Validate the parent and its renderer to ensure they exist
     if (!parent || !parent->base.sdl_renderer) {
-        printf("Invalid parent or renderer\n");
+        LOG_ERROR("Invalid parent or renderer");
     }
 
     // If no theme is set, default to a light theme to ensure consistent styling
@@ -51,7 +54,7 @@ Entry new_entry(Parent* parent, int x, int y, int w, int max_length) {
     // Allocate and set a default placeholder (single space) to avoid null pointer issues
     new_entry.place_holder = strdup(" ");
     if(!new_entry.place_holder) {
-        printf("Failed to allocate memory for placeholder\n");
+        LOG_ERROR("Failed to allocate memory for placeholder");
     }
 
     // Set position and dimensions (logical coordinates)
@@ -66,7 +69,7 @@ Entry new_entry(Parent* parent, int x, int y, int w, int max_length) {
     // Allocate memory for the text buffer, including space for null terminator
     new_entry.text = (char*)malloc(max_length + 1);
     if (!new_entry.text) {
-        printf("Failed to allocate memory for entry text\n");
+        LOG_ERROR("Failed to allocate memory for entry text");
         free(new_entry.place_holder); // Clean up placeholder
     }
 
@@ -77,6 +80,9 @@ Entry new_entry(Parent* parent, int x, int y, int w, int max_length) {
     new_entry.selection_start = -1; // No selection initially
     new_entry.visible_text_start = 0; // Start displaying text from the beginning
     new_entry.is_mouse_selecting = 0; // Initialize mouse selection flag
+    new_entry.rect_cache = (ChildRect){0}; // Physical rect is computed on first use
+    new_entry.binding = NULL; // Not bound to a cell
+    new_entry.blink = (CursorBlink){0}; // Blink starts when the entry is focused
 
     return new_entry; // Return the created entry
 }
@@ -91,38 +97,37 @@ void set_entry_placeholder(Entry* entry, const char* placeholder) {
 // Renders the text entry widget to the screen
 // Parameters:
 // - entry: The Entry widget to render
-// Renders the text entry widget to the screen
+// Records the text entry widget into `list`
+// Measures text with SDL_ttf, so it runs on the thread that draws (never on a job worker)
 // Parameters:
+// - list: The draw list to append to
 // - entry: The Entry widget to render
-void render_entry(Entry* entry) {
+static inline void record_entry_(DrawList* list, Entry* entry) {
     // Validate inputs to ensure the entry, its parent, and renderer are valid
-    if (!entry || !entry->parent || !entry->parent->base.sdl_renderer || !entry->parent->is_open) {
-        printf("Invalid entry, renderer, or parent is not open\n");
+    if (!entry || !entry->parent || !entry->parent->base.sdl_renderer) {
+        LOG_ERROR("Invalid entry or renderer");
         return;
     }
+    // Children of a closed container are skipped every frame; not worth a message
+    if (!is_parent_open(entry->parent)) return;
+    // Absolute physical rect, cached until the entry or an ancestor moves
+    SDL_Rect rect = get_child_rect(entry->parent, &entry->rect_cache, entry->x, entry->y, entry->w, entry->h);
+    // Skip widgets scrolled out of the parent's viewport or hidden behind an opaque container
+    if (!is_child_visible(entry->parent, rect) || is_child_occluded(entry->parent, rect)) return;
+
 	//set container clipping
 	if(entry->parent->is_window == false){
 	SDL_Rect parent_bounds = get_parent_rect(entry->parent);
-	SDL_RenderSetClipRect(entry->parent->base.sdl_renderer, &parent_bounds);
+	record_clip_(list, &entry->parent->base, &parent_bounds);
 	}
 
-    // Default to light theme if none is set
-    if (!current_theme) {
-        current_theme = (Theme*)&THEME_LIGHT;
-    }
-
     // Get DPI scale for converting logical coordinates to physical pixels
     float dpi = entry->parent->base.dpi_scale;
 
-    // Calculate absolute position in logical coordinates, accounting for parent position and title bar
-    int abs_x = entry->x + entry->parent->x;
-    int abs_y = entry->y + entry->parent->y + entry->parent->title_height;
-
-    // Convert to physical coordinates using DPI scaling
-    int sx = (int)roundf(abs_x * dpi);
-    int sy = (int)roundf(abs_y * dpi);
-    int sw = (int)roundf(entry->w * dpi);
-    int sh = (int)roundf(entry->h * dpi);
+    int sx = rect.x;
+    int sy = rect.y;
+    int sw = rect.w;
+    int sh = rect.h;
     int border_width = (int)roundf(2 * dpi);
     int padding = (int)roundf(current_theme->padding * dpi);
     int cursor_width = (int)roundf(2 * dpi);
@@ -132,9 +137,9 @@ void render_entry(Entry* entry) {
     char* font_file = current_theme->font_file ? current_theme->font_file : "FreeMono.ttf";
 
     // Load the font for rendering text
-    TTF_Font* font = TTF_OpenFont(font_file, font_size);
+    TTF_Font* font = open_font_(font_file, font_size);
     if (!font) {
-        printf("Failed to load font: %s\n", TTF_GetError());
+        LOG_ERROR("Failed to load font: %s", TTF_GetError());
         return;
     }
 
@@ -148,11 +153,11 @@ void render_entry(Entry* entry) {
     Color highlight_color = current_theme->accent_hovered; // Selection highlight color
 
     // Draw the entry's border rectangle
-    draw_rect_(&entry->parent->base, sx, sy, sw, sh, outline_color);
+    record_rect_(list, &entry->parent->base, sx, sy, sw, sh, outline_color);
 
     // Draw the entry's background (slightly inset to account for border)
-    draw_rect_(&entry->parent->base, sx + border_width, sy + border_width, 
-               sw - 2 * border_width, sh - 2 * border_width, bg_color);
+    record_rect_(list, &entry->parent->base, sx + border_width, sy + border_width, 
+                       sw - 2 * border_width, sh - 2 * border_width, bg_color);
 
     // Choose text to display: user text if active or non-empty, otherwise placeholder
     char* display_text = (entry->is_active || entry->text[0] != '\0') 
@@ -169,7 +174,12 @@ void render_entry(Entry* entry) {
     // Set a clipping rectangle to prevent text from drawing outside the entry
     SDL_Rect clip_rect = {sx + border_width, sy + border_width, 
                          sw - 2 * border_width, sh - 2 * border_width};
-    SDL_RenderSetClipRect(entry->parent->base.sdl_renderer, &clip_rect);
+    if (entry->parent->is_window == false) {
+        // Stay inside the container's (possibly nested) clip as well
+        SDL_Rect parent_bounds = get_parent_rect(entry->parent);
+        if (!SDL_IntersectRect(&clip_rect, &parent_bounds, &clip_rect)) clip_rect.w = clip_rect.h = 0;
+    }
+    record_clip_(list, &entry->parent->base, &clip_rect);
 
     // If there's a text selection and the entry is active, draw the highlight
     if (entry->selection_start != -1 && entry->is_active) {
@@ -199,17 +209,17 @@ void render_entry(Entry* entry) {
             TTF_SizeText(font, temp_start, &highlight_w, NULL);
 
             // Draw the selection highlight rectangle
-            draw_rect_(&entry->parent->base, highlight_x, text_y, highlight_w, 
-                      font_height, highlight_color);
+            record_rect_(list, &entry->parent->base, highlight_x, text_y, highlight_w, 
+                              font_height, highlight_color);
         }
     }
 
     // Render the visible text (user input or placeholder)
-    draw_text_from_font_(&entry->parent->base, font, display_text, text_x, text_y, 
-                        text_color, ALIGN_LEFT);
+    record_text_(list, &entry->parent->base, font_file, font_size, display_text, text_x, text_y, 
+                 text_color, ALIGN_LEFT);
 
-    // Render cursor if the entry is active
-    if (entry->is_active) {
+    // Render cursor if the entry is active and in the "on" half of its blink
+    if (entry->is_active && entry->blink.visible) {
         int cursor_offset = 0;
         if (entry->text[0] != '\0') {
             // Calculate pixel offset to the cursor position
@@ -220,16 +230,22 @@ void render_entry(Entry* entry) {
         }
         int cursor_x = text_x + cursor_offset;
         // Draw the cursor as a thin vertical rectangle
-        draw_rect_(&entry->parent->base, cursor_x, text_y, cursor_width, 
-                  font_height, cursor_color);
+        record_rect_(list, &entry->parent->base, cursor_x, text_y, cursor_width, 
+                          font_height, cursor_color);
     }
 
-    // Disable clipping after rendering
-    SDL_RenderSetClipRect(entry->parent->base.sdl_renderer, NULL);
     TTF_CloseFont(font); // Free the font resource
 
     // Reset clipping
-    SDL_RenderSetClipRect(entry->parent->base.sdl_renderer, NULL);
+    record_clip_(list, &entry->parent->base, NULL);
+}
+
+// Renders the text entry widget to the screen
+// Parameters:
+// - entry: The Entry widget to render
+void render_entry(Entry* entry) {
+    record_entry_(begin_immediate_draw_(), entry);
+    end_immediate_draw_();
 }
 // Updates the visible portion of the text when the cursor moves or text changes
 // Parameters:
@@ -237,7 +253,7 @@ void render_entry(Entry* entry) {
 void update_visible_text(Entry* entry) {
     // Validate inputs
     if (!entry || !entry->parent) {
-        printf("Invalid entry or parent\n");
+        LOG_ERROR("Invalid entry or parent");
         return; // Exit if validation fails
     }
 
@@ -252,9 +268,9 @@ void update_visible_text(Entry* entry) {
     int logical_padding = current_theme->padding;
 
     // Load the font for text measurements
-    TTF_Font* font = TTF_OpenFont(font_file, logical_font_size);
+    TTF_Font* font = open_font_(font_file, logical_font_size);
     if (!font) {
-        printf("Failed to load font: %s\n", TTF_GetError());
+        LOG_ERROR("Failed to load font: %s", TTF_GetError());
         return; // Exit if font loading fails
     }
 
@@ -314,16 +330,18 @@ void update_visible_text(Entry* entry) {
     TTF_CloseFont(font); // Free the font resource
 }
 
-// Updates the text entry widget based on SDL events (mouse, keyboard, text input)
+// Handles one SDL event (mouse, keyboard, text input); see update_entry
 // Parameters:
 // - entry: The Entry widget to update
 // - event: The SDL event to process
-void update_entry(Entry* entry, SDL_Event event) {
+static void handle_entry_event_(Entry* entry, SDL_Event event) {
     // Validate inputs to ensure the entry, its parent, and parent state are valid
-    if (!entry || !entry->parent || !entry->parent->is_open) {
-        printf("Invalid entry, parent, or parent is not open\n");
+    if (!entry || !entry->parent) {
+        LOG_ERROR("Invalid entry or parent");
         return;
     }
+    // Children of a closed container are skipped every frame; not worth a message
+    if (!is_parent_open(entry->parent)) return;
 
     // Default to light theme if none is set for consistent styling
     if (!current_theme) {
@@ -334,22 +352,27 @@ void update_entry(Entry* entry, SDL_Event event) {
     float dpi = entry->parent->base.dpi_scale;
     Uint16 mod = SDL_GetModState(); // Get current keyboard modifier state (e.g., Shift, Ctrl)
 
-    // Calculate absolute position in logical coordinates, accounting for parent and title bar
-    int abs_x = entry->x + entry->parent->x;
-    int abs_y = entry->y + entry->parent->y + entry->parent->title_height;
-    // Convert to physical coordinates for hit testing
-    int s_abs_x = (int)roundf(abs_x * dpi);
-    int s_abs_y = (int)roundf(abs_y * dpi);
-    int s_w = (int)roundf(entry->w * dpi);
-    int s_h = (int)roundf(entry->h * dpi);
+    // Calculate absolute x in logical coordinates, accounting for parent offsets
+    int abs_x = entry->x + entry->parent->content_x;
+    // Cached physical rect for hit testing
+    SDL_Rect rect = get_child_rect(entry->parent, &entry->rect_cache, entry->x, entry->y, entry->w, entry->h);
+    int s_abs_x = rect.x;
+    int s_abs_y = rect.y;
+    int s_w = rect.w;
+    int s_h = rect.h;
+
+    // Inactive widgets scrolled out of view can't be clicked; skip the font load below
+    if (!entry->is_active && !is_child_visible(entry->parent, rect)) {
+        return;
+    }
 
     // Load font for cursor position calculations
     int logical_font_size = current_theme->default_font_size;
     char* font_file = current_theme->font_file ? current_theme->font_file : "FreeMono.ttf";
     int logical_padding = current_theme->padding;
-    TTF_Font* font = TTF_OpenFont(font_file, logical_font_size);
+    TTF_Font* font = open_font_(font_file, logical_font_size);
     if (!font) {
-        printf("Failed to load font: %s\n", TTF_GetError());
+        LOG_ERROR("Failed to load font: %s", TTF_GetError());
         return; // Exit if font loading fails
     }
 
@@ -359,9 +382,10 @@ void update_entry(Entry* entry, SDL_Event event) {
         int mouseY = event.button.y;
         // Check if click is within the entry's bounds
         if (mouseX >= s_abs_x && mouseX <= s_abs_x + s_w &&
-            mouseY >= s_abs_y && mouseY <= s_abs_y + s_h) {
+            mouseY >= s_abs_y && mouseY <= s_abs_y + s_h &&
+            is_point_in_parent_clip(entry->parent, mouseX, mouseY)) {
             entry->is_active = 1; // Activate the entry
-            printf("Entry clicked! Active\n");
+            LOG_DEBUG("Entry clicked! Active");
             entry->is_mouse_selecting = 1; // Enable mouse-based selection
             entry->selection_start = -1; // Clear existing selection
 
@@ -384,7 +408,7 @@ void update_entry(Entry* entry, SDL_Event event) {
         } else {
             entry->is_active = 0; // Deactivate if clicked outside
             entry->is_mouse_selecting = 0; // Stop mouse selection
-            printf("Clicked outside entry! Inactive\n");
+            LOG_DEBUG("Clicked outside entry! Inactive");
             entry->selection_start = -1; // Clear selection
         }
     } 
@@ -571,11 +595,77 @@ void update_entry(Entry* entry, SDL_Event event) {
 
     TTF_CloseFont(font); // Free the font resource
 }
+// Replaces the input with a cell's text (cut to max_length) and redraws the entry
+static void on_entry_binding_(Observable* cell, void* userdata) {
+    Entry* entry = (Entry*)userdata;
+    const char* text = get_observable_text(cell);
+    if (!entry->text || strcmp(entry->text, text) == 0) return;
+    strncpy(entry->text, text, entry->max_length);
+    entry->text[entry->max_length] = '\0';
+    entry->cursor_pos = (int)strlen(entry->text);
+    entry->selection_start = -1;
+    entry->visible_text_start = 0;
+    update_visible_text(entry);
+    mark_child_dirty(entry->parent, get_child_rect(entry->parent, &entry->rect_cache, entry->x, entry->y, entry->w, entry->h));
+}
+
+// Keeps the input and a text cell equal both ways; NULL unbinds
+// Parameters:
+// - entry: The Entry widget to bind
+// - cell: An OBSERVABLE_TEXT cell; the entry takes its current text
+void bind_entry(Entry* entry, Observable* cell) {
+    if (!entry) return;
+    if (entry->binding) unobserve(entry->binding, on_entry_binding_, entry);
+    entry->binding = cell;
+    if (cell && observe(cell, on_entry_binding_, entry)) {
+        on_entry_binding_(cell, entry);
+    }
+}
+
+// Blink timer callback: toggles the cursor and redraws only this entry
+static void on_entry_blink_(void* userdata) {
+    Entry* entry = (Entry*)userdata;
+    entry->blink.visible = !entry->blink.visible;
+    mark_child_dirty(entry->parent, get_child_rect(entry->parent, &entry->rect_cache, entry->x, entry->y, entry->w, entry->h));
+}
+
+// Updates the text entry widget based on SDL events, then stores edits in the bound cell
+// Parameters:
+// - entry: The Entry widget to update
+// - event: The SDL event to process
+void update_entry(Entry* entry, SDL_Event event) {
+    if (!entry) {
+        handle_entry_event_(entry, event);  // Reports the invalid entry
+        return;
+    }
+    int was_active = entry->is_active;
+    int cursor_pos = entry->cursor_pos, selection_start = entry->selection_start;
+    int visible_text_start = entry->visible_text_start;
+    handle_entry_event_(entry, event);
+    // Keys and text only edit an active entry; clicks and drags move its cursor or selection
+    bool typed = was_active && (event.type == SDL_KEYDOWN || event.type == SDL_TEXTINPUT);
+    if (typed || entry->is_active != was_active || entry->cursor_pos != cursor_pos ||
+        entry->selection_start != selection_start || entry->visible_text_start != visible_text_start) {
+        mark_child_dirty(entry->parent, get_child_rect(entry->parent, &entry->rect_cache, entry->x, entry->y, entry->w, entry->h));
+    }
+    // The cursor stays solid while focusing and typing, and blinks when idle
+    if (entry->is_active && (!was_active || event.type == SDL_KEYDOWN || event.type == SDL_TEXTINPUT)) {
+        restart_cursor_blink_(&entry->blink, on_entry_blink_, entry);
+    } else if (!entry->is_active && was_active) {
+        stop_cursor_blink_(&entry->blink);
+    }
+    if (entry->binding && entry->text && strcmp(entry->text, get_observable_text(entry->binding)) != 0) {
+        set_observable_text(entry->binding, entry->text);
+    }
+}
+
 // Frees the memory allocated for an Entry widget
 // Parameters:
 // - entry: The Entry widget to free
 void free_entry(Entry* entry) {
     if (entry) {
+        bind_entry(entry, NULL); // Stop following the cell
+        stop_cursor_blink_(&entry->blink); // The timer points at this entry
         free(entry->text); // Free the text buffer
         free(entry->place_holder); // Free the placeholder text
     }
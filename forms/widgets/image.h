@@ -1,17 +1,49 @@
 #include<SDL2/SDL.h>
 #include<SDL2/SDL_image.h>
 #include<stdlib.h>
-typedef struct{
+struct Image;
+// Called once when an async image finishes loading (ok = false if it failed)
+typedef void (*ImageLoadCallback)(struct Image* image, bool ok, void* userdata);
+
+typedef struct Image{
 	Parent *parent;
 	int x, y, w, h;
 	const char * file_path;
-	SDL_Texture *texture;
+	SDL_Texture *texture;      // Shared texture owned by cache_entry (NULL in pipelined mode: only the render thread uses it)
+	TextureCacheEntry *cache_entry; // Reference into the texture cache, taken on first visible frame (released in free_image)
+	TextureCacheEntry *pending_entry; // Rescaled variant still loading; replaces cache_entry when ready
+	bool async;                     // Decode on loader threads (new_image_async)
+	bool rescale_failed;            // A rescaled variant failed to load; keep the current texture
+	ImageLoadCallback on_load;      // Optional, async images only
+	void *on_load_userdata;
+	bool load_notified;             // on_load already fired (or not needed)
+	ChildRect rect_cache; // Cached physical rect (see get_child_rect)
 }Image;
 
+#define IMAGE_RESCALE_THRESHOLD 0.25f  // Relative display size change that triggers a new downscaled texture
+
+// Physical size to pre-scale the texture to; 0, 0 (full resolution) when the widget has no fixed size
+static inline void image_variant_size_(Image *image, int phys_w, int phys_h, int *variant_w, int *variant_h){
+	if (image->w <= 0 || image->h <= 0) {
+		*variant_w = 0;
+		*variant_h = 0;
+	} else {
+		*variant_w = phys_w;
+		*variant_h = phys_h;
+	}
+}
+
+static inline TextureCacheEntry* acquire_image_texture_(Image *image, int variant_w, int variant_h){
+	if (!image->parent) return NULL;
+	SDL_Renderer *renderer = image->parent->base.sdl_renderer;
+	return image->async ? acquire_texture_async_(renderer, image->file_path, variant_w, variant_h)
+	                    : acquire_texture_(renderer, image->file_path, variant_w, variant_h);
+}
+
 
 Image new_image(Parent * parent, int x, int y, const char * file_path, int w, int h  ){
 	if(!parent || !parent->base.sdl_renderer){
-		printf("Invalid parent or renderer for image widget");
+		LOG_ERROR("Invalid parent or renderer for image widget");
 	}
 	
 	Image new_image;
@@ -22,43 +54,175 @@ Image new_image(Parent * parent, int x, int y, const char * file_path, int w, in
 	new_image.file_path=file_path;
 	new_image.w=w;
 	new_image.h=h;
-	new_image.texture= IMG_LoadTexture(parent->base.sdl_renderer, file_path);
-	if(!new_image.texture){
-		printf("Failed to load img %s : %s\n", file_path, IMG_GetError());
-	}
+	new_image.rect_cache=(ChildRect){0};
+	new_image.async = false;
+	new_image.pending_entry = NULL;
+	new_image.rescale_failed = false;
+	// Loaded on the first frame it is visible (see ensure_image_texture_)
+	new_image.cache_entry = NULL;
+	new_image.texture = NULL;
+	new_image.on_load = NULL;
+	new_image.on_load_userdata = NULL;
+	new_image.load_notified = true;
 	
 	return new_image;
 }
 
-void render_image(Image * image){
-	if (!image || !image->parent || !image->parent->base.sdl_renderer || !image->parent->is_open) {
-        printf("Invalid image widget, renderer, or parent is not open\n");
+/**
+ * Like new_image, but the file is decoded on a loader thread and a placeholder is
+ * drawn until the texture is ready. on_load (may be NULL) fires once on the UI thread
+ * after the first load, which starts when the image first becomes visible.
+ * With w/h of 0 the widget takes the image's size once it has loaded.
+ */
+Image new_image_async(Parent * parent, int x, int y, const char * file_path, int w, int h,
+                      ImageLoadCallback on_load, void *userdata){
+	if(!parent || !parent->base.sdl_renderer){
+		LOG_ERROR("Invalid parent or renderer for image widget");
+	}
+
+	Image new_image;
+
+	new_image.parent = parent;
+	new_image.x=x;
+	new_image.y=y;
+	new_image.file_path=file_path;
+	new_image.w=w;
+	new_image.h=h;
+	new_image.rect_cache=(ChildRect){0};
+	new_image.async = true;
+	new_image.pending_entry = NULL;
+	new_image.rescale_failed = false;
+	// Loaded on the first frame it is visible (see ensure_image_texture_)
+	new_image.cache_entry = NULL;
+	new_image.texture = NULL;
+	new_image.on_load = on_load;
+	new_image.on_load_userdata = userdata;
+	new_image.load_notified = false;
+
+	return new_image;
+}
+
+// Picks up a finished background load and fires on_load once
+static inline void sync_image_load_state_(Image *image){
+	// A rescaled variant replaces the current texture only once it is ready
+	if (image->pending_entry && image->pending_entry->state == TEXTURE_FAILED) {
+		release_texture_(image->pending_entry);
+		image->pending_entry = NULL;
+		image->rescale_failed = true;
+	} else if (image->pending_entry && image->pending_entry->state == TEXTURE_READY) {
+		release_texture_(image->cache_entry);
+		image->cache_entry = image->pending_entry;
+		image->pending_entry = NULL;
+		image->texture = entry_texture_(image->cache_entry);
+	}
+
+	if (image->load_notified) return;
+	TextureCacheEntry *entry = image->cache_entry;
+	if (!entry || entry->state == TEXTURE_LOADING) return;
+
+	image->texture = entry_texture_(entry);
+	image->load_notified = true;
+	if (image->on_load) {
+		image->on_load(image, entry->state == TEXTURE_READY, image->on_load_userdata);
+	}
+}
+
+/**
+ * Takes the cache reference on the first visible frame and reloads the texture if the
+ * cache evicted it while the image was hidden. Marks the texture as in use this frame.
+ */
+static inline void ensure_image_texture_(Image *image, SDL_Rect rect){
+	if (!image->cache_entry) {
+		// Widgets showing the same file at the same size share one decoded, downscaled texture
+		int variant_w, variant_h;
+		image_variant_size_(image, rect.w, rect.h, &variant_w, &variant_h);
+		image->cache_entry = acquire_image_texture_(image, variant_w, variant_h);
+		sync_image_load_state_(image);
+	} else if (image->cache_entry->state == TEXTURE_EVICTED) {
+		if (image->async) reload_texture_async_(image->cache_entry);
+		else reload_texture_(image->cache_entry);
+	}
+	if (!image->cache_entry) return;
+
+	image->texture = entry_texture_(image->cache_entry);
+	touch_texture_(image->cache_entry);
+}
+
+/**
+ * Requests a new pre-scaled texture when the physical display size drifted more than
+ * IMAGE_RESCALE_THRESHOLD from the one the current texture was made for (resize, DPI change).
+ */
+static inline void refresh_image_variant_(Image *image, SDL_Rect rect){
+	TextureCacheEntry *entry = image->cache_entry;
+	if (!entry || image->pending_entry || image->rescale_failed || entry->state != TEXTURE_READY) return;
+
+	int variant_w, variant_h;
+	image_variant_size_(image, rect.w, rect.h, &variant_w, &variant_h);
+	if (variant_w <= 0 || entry->variant_w <= 0) return;
+	if (fabsf((float)(variant_w - entry->variant_w)) <= entry->variant_w * IMAGE_RESCALE_THRESHOLD &&
+	    fabsf((float)(variant_h - entry->variant_h)) <= entry->variant_h * IMAGE_RESCALE_THRESHOLD) {
+		return;
+	}
+
+	image->pending_entry = acquire_image_texture_(image, variant_w, variant_h);
+	sync_image_load_state_(image);  // Synchronous loads swap in right away
+}
+
+// Records the image (or its loading placeholder) into `list`. Calling thread only: the
+// first visible frame loads the texture.
+static inline void record_image_(DrawList *list, Image * image){
+	if (!image || !image->parent || !image->parent->base.sdl_renderer) {
+        LOG_ERROR("Invalid image widget or renderer");
         return;
     }
+    // Children of a closed container are skipped every frame; not worth a message
+    if (!is_parent_open(image->parent)) return;
 
+     // Cached physical rect (w/h of 0 keep the texture's own size)
+    SDL_Rect rect = get_child_rect(image->parent, &image->rect_cache, image->x, image->y, image->w, image->h);
+    // Skip widgets scrolled out of the parent's viewport or hidden behind an opaque container
+    if (!is_child_visible(image->parent, rect) || is_child_occluded(image->parent, rect)) return;
+
+    ensure_image_texture_(image, rect);  // Lazy first load, transparent reload after eviction
+    refresh_image_variant_(image, rect);
+
+    TextureCacheEntry *entry = image->cache_entry;
+    // Only this rect is redrawn when a load in flight finishes
+    if (entry && entry->state == TEXTURE_LOADING) wait_for_texture_(entry, rect);
+    if (image->pending_entry && image->pending_entry->state == TEXTURE_LOADING) wait_for_texture_(image->pending_entry, rect);
     //set container clipping
     if(image->parent->is_window == false){
     SDL_Rect parent_bounds = get_parent_rect(image->parent);
-    SDL_RenderSetClipRect(image->parent->base.sdl_renderer, &parent_bounds);
+    record_clip_(list, &image->parent->base, &parent_bounds);
+    }
+
+    if (entry && entry->state == TEXTURE_LOADING) {
+        // Placeholder until the loader thread delivers the pixels
+        record_rect_(list, &(image->parent->base), rect.x, rect.y, rect.w, rect.h, current_theme->bg_secondary);
+    } else if (entry && entry->state == TEXTURE_READY) {
+        // Atlas images are batched at submit: consecutive ones under the same clip are one geometry call
+        record_texture_(list, &(image->parent->base), NULL, entry, NULL, rect);
     }
-        
-     // Calculate absolute position relative to parent
-    int abs_x = image->x + image->parent->x;
-    int abs_y = image->y + image->parent->y + image->parent->title_height;
-    
-	draw_image_from_texture_(&(image->parent->base), image->texture, abs_x, abs_y, image->w, image->h);
 	// Reset clipping
-	SDL_RenderSetClipRect(image->parent->base.sdl_renderer, NULL);
+	if(image->parent->is_window == false){
+	record_clip_(list, &image->parent->base, NULL);
+	}
+}
+
+void render_image(Image * image){
+    record_image_(begin_immediate_draw_(), image);
+    end_immediate_draw_();
 }
 
 void update_image(Image *image, SDL_Event event){} // incase in the future, image needs to be resizeable, movable, ...
 
 void free_image(Image *image) {
     if (image) {
-        if (image->texture) {
-        	SDL_DestroyTexture(image->texture);
-        	image->texture=NULL;
-        }
+        release_texture_(image->cache_entry);
+        release_texture_(image->pending_entry);
+        image->cache_entry = NULL;
+        image->pending_entry = NULL;
+        image->texture = NULL;
     }
 }
 
@@ -77,11 +241,14 @@ void register_image(Image* image) {
 }
 
 void render_all_registered_images(void) {
+    DrawList *list = begin_immediate_draw_();  // One list, so atlas images batch across widgets
     for (int i = 0; i < images_count; i++) {
         if (image_widgets[i]) {
-            render_image(image_widgets[i]);
+            sync_image_load_state_(image_widgets[i]);  // Even when hidden, so on_load fires promptly
+            record_image_(list, image_widgets[i]);
         }
     }
+    end_immediate_draw_();
 }
 
 void update_all_registered_images(SDL_Event event) {
@@ -20,14 +20,21 @@ typedef struct {
     Color* custom_bg_color;    // Optional override for background color (NULL = use theme)
     Color* custom_fill_color;  // Optional override for fill color (NULL = use theme)
     Color* custom_text_color;  // Optional override for text color (NULL = use theme)
+    ChildRect rect_cache;      // Cached physical rect (see get_child_rect)
+    Observable* binding;       // Optional int cell the value follows (see bind_progress_bar)
+    bool indeterminate;        // Sweeping segment instead of a value (see set_progress_bar_indeterminate)
+    TimerId sweep_timer;       // Redraws the sweep while indeterminate
 } ProgressBar;
 
+#define PROGRESS_SWEEP_MS 1200  // One pass of the indeterminate segment
+#define PROGRESS_SWEEP_STEP_MS 33  // Redraw interval of the sweep (~30 Hz)
+
 
 
 // -------- Create --------
 static inline ProgressBar new_progress_bar(Parent* parent, int x, int y, int w, int h, int min, int max, int start_value, bool show_percentage) {
     if (!parent || !parent->base.sdl_renderer) {
-        printf("Invalid parent or renderer\n");
+        LOG_ERROR("Invalid parent or renderer");
     }
 
     ProgressBar progress_bar;
@@ -43,10 +50,21 @@ static inline ProgressBar new_progress_bar(Parent* parent, int x, int y, int w,
     progress_bar.custom_bg_color = NULL;
     progress_bar.custom_fill_color = NULL;
     progress_bar.custom_text_color = NULL;
+    progress_bar.rect_cache = (ChildRect){0};
+    progress_bar.binding = NULL;
+    progress_bar.indeterminate = false;
+    progress_bar.sweep_timer = 0;
 
     return progress_bar;
 }
 
+// Marks only this bar for redraw (setters, tween and timer callbacks)
+static inline void redraw_progress_bar_(void* userdata) {
+    ProgressBar* progress_bar = (ProgressBar*)userdata;
+    mark_child_dirty(progress_bar->parent, get_child_rect(progress_bar->parent, &progress_bar->rect_cache,
+                                                          progress_bar->x, progress_bar->y, progress_bar->w, progress_bar->h));
+}
+
 // Setters for overrides
 static inline void set_progress_bar_bg_color(ProgressBar* progress_bar, Color color) {
     if (progress_bar) {
@@ -54,6 +72,7 @@ static inline void set_progress_bar_bg_color(ProgressBar* progress_bar, Color co
             progress_bar->custom_bg_color = (Color*)malloc(sizeof(Color));
         }
         *progress_bar->custom_bg_color = color;
+        redraw_progress_bar_(progress_bar);
     }
 }
 
@@ -63,6 +82,7 @@ static inline void set_progress_bar_fill_color(ProgressBar* progress_bar, Color
             progress_bar->custom_fill_color = (Color*)malloc(sizeof(Color));
         }
         *progress_bar->custom_fill_color = color;
+        redraw_progress_bar_(progress_bar);
     }
 }
 
@@ -72,43 +92,100 @@ static inline void set_progress_bar_text_color(ProgressBar* progress_bar, Color
             progress_bar->custom_text_color = (Color*)malloc(sizeof(Color));
         }
         *progress_bar->custom_text_color = color;
+        redraw_progress_bar_(progress_bar);
     }
 }
 
 // Setter for value
 static inline void set_progress_bar_value(ProgressBar* progress_bar, int value) {
     if (progress_bar) {
+        stop_tween(&progress_bar->value);  // An explicit value wins over a running animation
         if (value < progress_bar->min) value = progress_bar->min;
         if (value > progress_bar->max) value = progress_bar->max;
-        progress_bar->value = value;
+        if (value != progress_bar->value) {
+            progress_bar->value = value;
+            redraw_progress_bar_(progress_bar);
+        }
+    }
+}
+
+// Slides the fill to a value over duration_ms, redrawing only this bar
+static inline void animate_progress_bar_value(ProgressBar* progress_bar, int value, Uint32 duration_ms) {
+    if (!progress_bar) return;
+    if (value < progress_bar->min) value = progress_bar->min;
+    if (value > progress_bar->max) value = progress_bar->max;
+    tween_int(&progress_bar->value, value, duration_ms, EASE_OUT_CUBIC, redraw_progress_bar_, progress_bar);
+}
+
+// Shows a sweeping segment for work of unknown length; the bar redraws on a timer only while on
+static inline void set_progress_bar_indeterminate(ProgressBar* progress_bar, bool indeterminate) {
+    if (!progress_bar || progress_bar->indeterminate == indeterminate) return;
+    progress_bar->indeterminate = indeterminate;
+    cancel_timer(progress_bar->sweep_timer);
+    progress_bar->sweep_timer = indeterminate
+        ? add_timer(PROGRESS_SWEEP_STEP_MS, PROGRESS_SWEEP_STEP_MS, redraw_progress_bar_, progress_bar)
+        : 0;
+    redraw_progress_bar_(progress_bar);
+}
+
+static inline void on_progress_bar_binding_(Observable* cell, void* userdata) {
+    set_progress_bar_value((ProgressBar*)userdata, get_observable_int(cell));
+}
+
+// Makes the bar show an int cell (one way; the bar has no input); NULL unbinds
+static inline void bind_progress_bar(ProgressBar* progress_bar, Observable* cell) {
+    if (!progress_bar) return;
+    if (progress_bar->binding) unobserve(progress_bar->binding, on_progress_bar_binding_, progress_bar);
+    progress_bar->binding = cell;
+    if (cell && observe(cell, on_progress_bar_binding_, progress_bar)) {
+        set_progress_bar_value(progress_bar, get_observable_int(cell));
     }
 }
 
+// -------- Updates from other threads (applied once per frame, see updates.h) --------
+static inline void apply_progress_bar_value_(void* target, WidgetUpdateValue* value) {
+    set_progress_bar_value((ProgressBar*)target, value->i);
+}
+
+static inline void apply_progress_bar_fill_color_(void* target, WidgetUpdateValue* value) {
+    set_progress_bar_fill_color((ProgressBar*)target, value->color);
+}
+
+// Thread-safe set_progress_bar_value; only the newest value per frame is applied
+static inline void post_progress_bar_value(ProgressBar* progress_bar, int value) {
+    post_widget_update_(progress_bar, apply_progress_bar_value_, (WidgetUpdateValue){.i = value});
+}
+
+static inline void post_progress_bar_fill_color(ProgressBar* progress_bar, Color color) {
+    post_widget_update_(progress_bar, apply_progress_bar_fill_color_, (WidgetUpdateValue){.color = color});
+}
+
 // -------- Render --------
-static inline void render_progress_bar(ProgressBar* progress_bar) {
-    if (!progress_bar || !progress_bar->parent || !progress_bar->parent->base.sdl_renderer || !progress_bar->parent->is_open) {
-        printf("Invalid progress bar, renderer, or parent is not open\n");
+// Records the bar into `list`; safe on a job worker (fonts are opened at submit)
+static inline void record_progress_bar_(DrawList* list, ProgressBar* progress_bar) {
+    if (!progress_bar || !progress_bar->parent || !progress_bar->parent->base.sdl_renderer) {
+        LOG_ERROR("Invalid progress bar or renderer");
         return;
     }
+    // Children of a closed container are skipped every frame; not worth a message
+    if (!is_parent_open(progress_bar->parent)) return;
+    // Absolute physical rect, cached until the bar or an ancestor moves
+    SDL_Rect rect = get_child_rect(progress_bar->parent, &progress_bar->rect_cache,
+                                   progress_bar->x, progress_bar->y, progress_bar->w, progress_bar->h);
+    // Skip widgets scrolled out of the parent's viewport or hidden behind an opaque container
+    if (!is_child_visible(progress_bar->parent, rect) || is_child_occluded(progress_bar->parent, rect)) return;
+
 	//set container clipping
 	if(progress_bar->parent->is_window == false){
 	SDL_Rect parent_bounds = get_parent_rect(progress_bar->parent);
-	SDL_RenderSetClipRect(progress_bar->parent->base.sdl_renderer, &parent_bounds);
+	record_clip_(list, &progress_bar->parent->base, &parent_bounds);
 	}
 
-    // Fallback if no theme set
-    if (!current_theme) {
-        current_theme = (Theme*)&THEME_LIGHT;  // Or set a static fallback
-    }
-
     float dpi = progress_bar->parent->base.dpi_scale;
-    // Calculate absolute position relative to parent (logical), then scale
-    int abs_x = progress_bar->x + progress_bar->parent->x;
-    int abs_y = progress_bar->y + progress_bar->parent->y + progress_bar->parent->title_height;
-    int sx = (int)roundf(abs_x * dpi);
-    int sy = (int)roundf(abs_y * dpi);
-    int sw = (int)roundf(progress_bar->w * dpi);
-    int sh = (int)roundf(progress_bar->h * dpi);
+    int sx = rect.x;
+    int sy = rect.y;
+    int sw = rect.w;
+    int sh = rect.h;
     int font_size = (int)roundf(current_theme->default_font_size * dpi);
     float roundness = current_theme->roundness;  // Roundness is a ratio (0-1), no scaling needed
 
@@ -120,30 +197,39 @@ static inline void render_progress_bar(ProgressBar* progress_bar) {
     Color text_color = progress_bar->custom_text_color ? *progress_bar->custom_text_color : current_theme->text_primary;
 
     // Draw background (full bar)
-    draw_rounded_rect_(base, sx, sy, sw, sh, roundness, bg_color);
+    record_rounded_rect_(list, base, sx, sy, sw, sh, roundness, bg_color);
+
+    if (progress_bar->indeterminate) {
+        // A quarter-width segment crossing the bar, clipped to its ends
+        int seg = sw / 4;
+        float phase = (float)(SDL_GetTicks() % PROGRESS_SWEEP_MS) / PROGRESS_SWEEP_MS;
+        int seg_x = sx - seg + (int)roundf((sw + seg) * phase);
+        int left = seg_x < sx ? sx : seg_x;
+        int right = seg_x + seg > sx + sw ? sx + sw : seg_x + seg;
+        if (right > left) record_rounded_rect_(list, base, left, sy, right - left, sh, roundness, fill_color);
+        record_clip_(list, base, NULL);
+        return;
+    }
 
     // Draw fill (progress portion)
     float progress_ratio = (float)(progress_bar->value - progress_bar->min) / (progress_bar->max - progress_bar->min);
     int fill_width = (int)roundf(sw * progress_ratio);
-    draw_rounded_rect_(base, sx, sy, fill_width, sh, roundness, fill_color);
+    record_rounded_rect_(list, base, sx, sy, fill_width, sh, roundness, fill_color);
 
     // Draw percentage text if enabled (centered)
     if (progress_bar->show_percentage) {
         char percentage_text[16];
         snprintf(percentage_text, sizeof(percentage_text), "%d%%", (int)(progress_ratio * 100));
         char* font_file = current_theme->font_file ? current_theme->font_file : "FreeMono.ttf";
-        TTF_Font* font = TTF_OpenFont(font_file, font_size);
-        if (font) {
-            int text_w, text_h;
-            TTF_SizeText(font, percentage_text, &text_w, &text_h);
-            int text_x = sx + (sw - text_w) / 2;
-            int text_y = sy + (sh - text_h) / 2;
-            draw_text_from_font_(base, font, percentage_text, text_x, text_y, text_color, ALIGN_LEFT);
-            TTF_CloseFont(font);
-        }
+        record_text_centered_(list, base, font_file, font_size, percentage_text, rect, text_color);
     }
     // Reset clipping
-    SDL_RenderSetClipRect(progress_bar->parent->base.sdl_renderer, NULL);
+    record_clip_(list, base, NULL);
+}
+
+static inline void render_progress_bar(ProgressBar* progress_bar) {
+    record_progress_bar_(begin_immediate_draw_(), progress_bar);
+    end_immediate_draw_();
 }
 
 // -------- Update --------
@@ -155,6 +241,9 @@ static inline void update_progress_bar(ProgressBar* progress_bar, SDL_Event even
 // -------- Free --------
 static inline void free_progress_bar(ProgressBar* progress_bar) {
     if (progress_bar) {
+        bind_progress_bar(progress_bar, NULL);
+        stop_tween(&progress_bar->value);
+        cancel_timer(progress_bar->sweep_timer);
         if (progress_bar->custom_bg_color) free(progress_bar->custom_bg_color);
         if (progress_bar->custom_fill_color) free(progress_bar->custom_fill_color);
         if (progress_bar->custom_text_color) free(progress_bar->custom_text_color);
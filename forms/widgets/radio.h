@@ -23,6 +23,10 @@ typedef struct {
     Color* custom_outer_color;   // Outer circle color
     Color* custom_inner_color;   // Inner circle color when selected
     Color* custom_label_color;   // Label text color
+    ChildRect rect_cache;        // Cached physical rect (see get_child_rect)
+    Observable* binding;         // Optional int cell shared by the group (see bind_radio)
+    int binding_value;           // Cell value that means "this radio is selected"
+    ChangeNotifier notifier;     // Selection callbacks (see notify.h)
 } Radio;
 
 #define MAX_RADIOS 100
@@ -40,13 +44,13 @@ static inline void register_widget_radio(Radio* radio) {
 static inline Radio* new_radio_button_(Parent* parent, int x, int y, int w, int h,
                                        const char* label, int group_id) {
     if (!parent || !parent->base.sdl_renderer) {
-        printf("Invalid parent or renderer\n");
+        LOG_ERROR("Invalid parent or renderer");
         return NULL;
     }
 
     Radio* radio = (Radio*)malloc(sizeof(Radio));
     if (!radio) {
-        printf("Failed to allocate Radio\n");
+        LOG_ERROR("Failed to allocate Radio");
         return NULL;
     }
 
@@ -58,7 +62,7 @@ static inline Radio* new_radio_button_(Parent* parent, int x, int y, int w, int
     radio->label = strdup(label);
     if (!radio->label) {
         free(radio);
-        printf("Failed to allocate memory for label\n");
+        LOG_ERROR("Failed to allocate memory for label");
         return NULL;
     }
     radio->selected = false;
@@ -68,6 +72,11 @@ static inline Radio* new_radio_button_(Parent* parent, int x, int y, int w, int
     radio->custom_outer_color = NULL;
     radio->custom_inner_color = NULL;
     radio->custom_label_color = NULL;
+    radio->rect_cache = (ChildRect){0};
+    radio->binding = NULL;
+    radio->binding_value = 0;
+    radio->notifier = new_change_notifier_();
+    radio->notifier.widget = radio;
 
     register_widget_radio(radio);
     return radio;
@@ -101,30 +110,88 @@ static inline void set_radio_label_color(Radio* radio, Color color) {
     }
 }
 
+// Physical rect covered by the radio: the circle centered on (x, y) and the label to its right
+static inline SDL_Rect radio_box_(Radio* radio, SDL_Rect rect) {
+    SDL_Rect box = {rect.x - rect.h / 2, rect.y - rect.h / 2, rect.h, rect.h};
+    box.w += rect.h + (int)roundf(estimate_text_width_(radio->label, current_theme ? current_theme->default_font_size : 16) * radio->parent->base.dpi_scale);
+    return box;
+}
+
+static inline void redraw_radio_(Radio* radio) {
+    mark_child_dirty(radio->parent, radio_box_(radio, get_child_rect(radio->parent, &radio->rect_cache, radio->x, radio->y, radio->w, radio->h)));
+}
+
+static inline void set_radio_selected_(Radio* radio, bool selected) {
+    if (radio->selected == selected) return;
+    radio->selected = selected;
+    redraw_radio_(radio);
+}
+
+static inline void on_radio_binding_(Observable* cell, void* userdata) {
+    Radio* radio = (Radio*)userdata;
+    set_radio_selected_(radio, get_observable_int(cell) == radio->binding_value);
+}
+
+// Binds a radio to an int cell shared by its group: the radio is selected while the
+// cell equals `value`, and clicking it stores `value`. NULL unbinds.
+static inline void bind_radio(Radio* radio, Observable* cell, int value) {
+    if (!radio) return;
+    if (radio->binding) unobserve(radio->binding, on_radio_binding_, radio);
+    radio->binding = cell;
+    radio->binding_value = value;
+    if (cell && observe(cell, on_radio_binding_, radio)) {
+        set_radio_selected_(radio, get_observable_int(cell) == value);
+    }
+}
+
+// Called on the radio the user selects, with its binding value (0 if unbound);
+// clicking the radio that is already selected does not call it
+static inline void set_radio_on_change(Radio* radio, ChangeFn on_change, void* userdata) {
+    if (radio) {
+        radio->notifier.on_change = on_change;
+        radio->notifier.change_userdata = userdata;
+    }
+}
+
+// Called on every click that selects the radio, after on_change
+static inline void set_radio_on_commit(Radio* radio, ChangeFn on_commit, void* userdata) {
+    if (radio) {
+        radio->notifier.on_commit = on_commit;
+        radio->notifier.commit_userdata = userdata;
+    }
+}
+
+// NOTIFY_PER_FRAME (default), or NOTIFY_THROTTLE / NOTIFY_DEBOUNCE with an interval
+static inline void set_radio_change_rate(Radio* radio, NotifyMode mode, Uint32 interval_ms) {
+    if (radio) set_change_rate_(&radio->notifier, mode, interval_ms);
+}
+
 // -------- Render --------
-static inline void render_radio_(Radio* radio) {
-    if (!radio || !radio->parent || !radio->parent->base.sdl_renderer || !radio->parent->is_open) {
-        printf("Invalid radio, renderer, or parent is not open\n");
+// Records the radio into `list`; safe on a job worker (fonts are opened at submit)
+static inline void record_radio_(DrawList* list, Radio* radio) {
+    if (!radio || !radio->parent || !radio->parent->base.sdl_renderer) {
+        LOG_ERROR("Invalid radio or renderer");
         return;
     }
+    // Children of a closed container are skipped every frame; not worth a message
+    if (!is_parent_open(radio->parent)) return;
+    // Cached physical rect; (x, y) is the circle's center
+    SDL_Rect rect = get_child_rect(radio->parent, &radio->rect_cache, radio->x, radio->y, radio->w, radio->h);
+    // Circle is centered on (x, y) and the label sits to its right
+    SDL_Rect box = radio_box_(radio, rect);
+    // Skip widgets scrolled out of the parent's viewport or hidden behind an opaque container
+    if (!is_child_visible(radio->parent, box) || is_child_occluded(radio->parent, box)) return;
+
 	//set container clipping
 	if(radio->parent->is_window == false){
 	SDL_Rect parent_bounds = get_parent_rect(radio->parent);
-	SDL_RenderSetClipRect(radio->parent->base.sdl_renderer, &parent_bounds);
+	record_clip_(list, &radio->parent->base, &parent_bounds);
 	}
 
-    // Fallback if no theme set
-    if (!current_theme) {
-        current_theme = (Theme*)&THEME_LIGHT;  // Or set a static fallback
-    }
-
     float dpi = radio->parent->base.dpi_scale;
-    // Calculate absolute position relative to parent (logical), then scale
-    int abs_x = radio->x + radio->parent->x;
-    int abs_y = radio->y + radio->parent->y + radio->parent->title_height;
-    int sx = (int)roundf(abs_x * dpi);
-    int sy = (int)roundf(abs_y * dpi);
-    int sh = (int)roundf(radio->h * dpi);  // Assuming square, w ignored or = h
+    int sx = rect.x;
+    int sy = rect.y;
+    int sh = rect.h;  // Assuming square, w ignored or = h
     int radius = (int)roundf((radio->h / 2) * dpi);
     int inner_margin = (int)roundf(4 * dpi);  // Scale the inner margin
     int inner_radius = radius - inner_margin;
@@ -142,41 +209,52 @@ static inline void render_radio_(Radio* radio) {
     Color label_color = radio->custom_label_color ? *radio->custom_label_color : current_theme->text_primary;
 
     // Outer circle (centered at sx, sy)
-    draw_circle_(base, sx, sy, radius, outer_color);
+    record_circle_(list, base, sx, sy, radius, outer_color);
 
     // Inner circle if selected
     if (radio->selected) {
-        draw_circle_(base, sx, sy, inner_radius, inner_color);
+        record_circle_(list, base, sx, sy, inner_radius, inner_color);
     }
 
     // Label text (to the right, vertically centered)
     int label_y = sy - (int)roundf((radio->h / 6) * dpi);  // Adjusted for better centering (was /3)
-    draw_text_(base, radio->label, font_size,
-               sx + sh + pad / 2, label_y,
-               label_color);
+    record_text_(list, base, NULL, font_size, radio->label,
+                 sx + sh + pad / 2, label_y,
+                 label_color, ALIGN_LEFT);
 
     // Reset clipping
-    SDL_RenderSetClipRect(radio->parent->base.sdl_renderer, NULL);
+    record_clip_(list, base, NULL);
+}
+
+static inline void render_radio_(Radio* radio) {
+    record_radio_(begin_immediate_draw_(), radio);
+    end_immediate_draw_();
 }
 
 // -------- Update --------
 static inline void update_radio_(Radio* radio, SDL_Event event) {
-    if (!radio || !radio->parent || !radio->parent->is_open) {
-        printf("Invalid radio, parent, or parent is not open\n");
+    if (!radio || !radio->parent) {
+        LOG_ERROR("Invalid radio or parent");
         return;
     }
+    // Children of a closed container are skipped every frame; not worth a message
+    if (!is_parent_open(radio->parent)) return;
 
     // Calculate absolute position relative to parent (logical)
-    int abs_x = radio->x + radio->parent->x;
-    int abs_y = radio->y + radio->parent->y + radio->parent->title_height;
+    int abs_x = radio->x + radio->parent->content_x;
+    int abs_y = radio->y + radio->parent->content_y;
 
     int mouse_x, mouse_y;
     SDL_GetMouseState(&mouse_x, &mouse_y);
 
     // Check hover (bounding box around circle)
     bool over = (mouse_x >= abs_x - radio->h/2 && mouse_x <= abs_x + radio->h/2 &&
-                 mouse_y >= abs_y - radio->h/2 && mouse_y <= abs_y + radio->h/2);
-    radio->is_hovered = over;
+                 mouse_y >= abs_y - radio->h/2 && mouse_y <= abs_y + radio->h/2) &&
+                is_logical_point_in_parent_clip(radio->parent, mouse_x, mouse_y);
+    if (over != radio->is_hovered) {
+        radio->is_hovered = over;
+        redraw_radio_(radio);
+    }
 
     if (event.type == SDL_MOUSEBUTTONDOWN && event.button.button == SDL_BUTTON_LEFT) {
         int mx = event.button.x;
@@ -184,15 +262,21 @@ static inline void update_radio_(Radio* radio, SDL_Event event) {
 
         // Hitbox: circle bounding box
         if (mx >= abs_x - radio->h/2 && mx <= abs_x + radio->h/2 &&
-            my >= abs_y - radio->h/2 && my <= abs_y + radio->h/2) {
+            my >= abs_y - radio->h/2 && my <= abs_y + radio->h/2 &&
+            is_logical_point_in_parent_clip(radio->parent, mx, my)) {
 
+            bool was_selected = radio->selected;
             // Deselect others in same group
             for (int i = 0; i < radios_count; i++) {
                 if (radio_widgets[i] && radio_widgets[i]->group_id == radio->group_id) {
-                    radio_widgets[i]->selected = false;
+                    set_radio_selected_(radio_widgets[i], false);
                 }
             }
-            radio->selected = true;
+            set_radio_selected_(radio, true);
+            set_observable_int(radio->binding, radio->binding_value);
+            // Newly selected: a change even if the previous radio had the same value
+            if (!was_selected) notify_select_(&radio->notifier, radio->binding_value);
+            notify_commit_(&radio->notifier, radio->binding_value);
         }
     }
 }
@@ -200,6 +284,8 @@ static inline void update_radio_(Radio* radio, SDL_Event event) {
 // -------- Free --------
 static inline void free_radio_(Radio* radio) {
     if (radio) {
+        bind_radio(radio, NULL, 0);
+        free_change_notifier_(&radio->notifier);
         free(radio->label);
         if (radio->custom_outer_color) free(radio->custom_outer_color);
         if (radio->custom_inner_color) free(radio->custom_inner_color);
@@ -18,13 +18,16 @@ typedef struct {
     Color* custom_track_color;   // Optional override for track color (NULL = use theme)
     Color* custom_thumb_color;   // Optional override for thumb color (NULL = use theme)
     Color* custom_label_color;   // Optional override for label color (NULL = use theme)
+    ChildRect rect_cache;        // Cached physical rect (see get_child_rect)
+    Observable* binding;         // Optional cell kept equal to value (see bind_slider)
+    ChangeNotifier notifier;     // on_change/on_commit callbacks (see notify.h)
 } Slider;
 
 
 // -------- Create --------
 static inline Slider new_slider(Parent* parent, int x, int y, int w, int h, int min, int max, int start_value, const char* label) {
     if (!parent || !parent->base.sdl_renderer) {
-        printf("Invalid parent or renderer\n");
+        LOG_ERROR("Invalid parent or renderer");
     }
 
     Slider slider;
@@ -43,10 +46,55 @@ static inline Slider new_slider(Parent* parent, int x, int y, int w, int h, int
     slider.custom_track_color = NULL;
     slider.custom_thumb_color = NULL;
     slider.custom_label_color = NULL;
+    slider.rect_cache = (ChildRect){0};
+    slider.binding = NULL;
+    slider.notifier = new_change_notifier_();
 
     return slider;
 }
 
+// Physical rect covered by the slider: the track plus the label to its right
+static inline SDL_Rect slider_box_(Slider* slider, SDL_Rect rect) {
+    rect.w += (int)roundf((10 + estimate_text_width_(slider->label, current_theme ? current_theme->default_font_size : 16)) * slider->parent->base.dpi_scale);
+    return rect;
+}
+
+// Sets the value, clamped to the slider's range
+static inline void set_slider_value(Slider* slider, int value) {
+    if (slider) {
+        if (value < slider->min) value = slider->min;
+        if (value > slider->max) value = slider->max;
+        if (value != slider->value) {
+            slider->value = value;
+            mark_child_dirty(slider->parent, slider_box_(slider, get_child_rect(slider->parent, &slider->rect_cache, slider->x, slider->y, slider->w, slider->h)));
+        }
+        set_observable_int(slider->binding, slider->value);
+    }
+}
+
+static inline void on_slider_binding_(Observable* cell, void* userdata) {
+    set_slider_value((Slider*)userdata, get_observable_int(cell));
+}
+
+// Keeps the slider and an int cell equal both ways; NULL unbinds. The slider takes the cell's value.
+static inline void bind_slider(Slider* slider, Observable* cell) {
+    if (!slider) return;
+    if (slider->binding) unobserve(slider->binding, on_slider_binding_, slider);
+    slider->binding = cell;
+    if (cell && observe(cell, on_slider_binding_, slider)) {
+        set_slider_value(slider, get_observable_int(cell));
+    }
+}
+
+static inline void apply_slider_value_(void* target, WidgetUpdateValue* value) {
+    set_slider_value((Slider*)target, value->i);
+}
+
+// Thread-safe set_slider_value; only the newest value per frame is applied (see updates.h)
+static inline void post_slider_value(Slider* slider, int value) {
+    post_widget_update_(slider, apply_slider_value_, (WidgetUpdateValue){.i = value});
+}
+
 // Setters for overrides
 static inline void set_slider_track_color(Slider* slider, Color color) {
     if (slider) {
@@ -75,31 +123,57 @@ static inline void set_slider_label_color(Slider* slider, Color color) {
     }
 }
 
+// Called with the newest value while the user drags, at the rate set by set_slider_change_rate
+static inline void set_slider_on_change(Slider* slider, ChangeFn on_change, void* userdata) {
+    if (slider) {
+        slider->notifier.widget = slider;
+        slider->notifier.on_change = on_change;
+        slider->notifier.change_userdata = userdata;
+    }
+}
+
+// Called once when a drag ends (mouse-up), after any pending on_change
+static inline void set_slider_on_commit(Slider* slider, ChangeFn on_commit, void* userdata) {
+    if (slider) {
+        slider->notifier.widget = slider;
+        slider->notifier.on_commit = on_commit;
+        slider->notifier.commit_userdata = userdata;
+    }
+}
+
+// NOTIFY_PER_FRAME (default), or NOTIFY_THROTTLE / NOTIFY_DEBOUNCE with an interval
+static inline void set_slider_change_rate(Slider* slider, NotifyMode mode, Uint32 interval_ms) {
+    if (slider) set_change_rate_(&slider->notifier, mode, interval_ms);
+}
+
 // -------- Render --------
-static inline void render_slider(Slider* slider) {
-    if (!slider || !slider->parent || !slider->parent->base.sdl_renderer || !slider->parent->is_open) {
-        printf("Invalid slider, renderer, or parent is not open\n");
+// Records the slider into `list`; safe on a job worker (fonts are opened at submit)
+static inline void record_slider_(DrawList* list, Slider* slider) {
+    if (!slider || !slider->parent || !slider->parent->base.sdl_renderer) {
+        LOG_ERROR("Invalid slider or renderer");
         return;
     }
+    // Children of a closed container are skipped every frame; not worth a message
+    if (!is_parent_open(slider->parent)) return;
+    SDL_Rect rect = get_child_rect(slider->parent, &slider->rect_cache, slider->x, slider->y, slider->w, slider->h);
+    // The label sits to the right of the track
+    SDL_Rect box = slider_box_(slider, rect);
+    // Skip widgets scrolled out of the parent's viewport or hidden behind an opaque container
+    if (!is_child_visible(slider->parent, box) || is_child_occluded(slider->parent, box)) return;
+
 	//set container clipping
 	if(slider->parent->is_window == false){
 	SDL_Rect parent_bounds = get_parent_rect(slider->parent);
-	SDL_RenderSetClipRect(slider->parent->base.sdl_renderer, &parent_bounds);
+	record_clip_(list, &slider->parent->base, &parent_bounds);
 	}
 
-    // Fallback if no theme set
-    if (!current_theme) {
-        current_theme = (Theme*)&THEME_LIGHT;  // Or set a static fallback
-    }
-
     float dpi = slider->parent->base.dpi_scale;
-    // Calculate absolute position relative to parent (logical), then scale
-    int abs_x = slider->x + slider->parent->x;
-    int abs_y = slider->y + slider->parent->y + slider->parent->title_height;
-    int sx = (int)roundf(abs_x * dpi);
-    int sy = (int)roundf(abs_y * dpi);
-    int sw = (int)roundf(slider->w * dpi);
-    int sh = (int)roundf(slider->h * dpi);
+    // Absolute logical position (for the thumb) and cached physical rect
+    int abs_x = slider->x + slider->parent->content_x;
+    int sx = rect.x;
+    int sy = rect.y;
+    int sw = rect.w;
+    int sh = rect.h;
     int track_height = (int)roundf(4 * dpi);  // Scaled thin track
     int thumb_width = (int)roundf(10 * dpi);  // Scaled fixed width for rectangular thumb
     int label_pad = (int)roundf(10 * dpi);    // Scaled padding for label
@@ -110,7 +184,7 @@ static inline void render_slider(Slider* slider) {
 
     // Draw track (horizontal bar)
     Color track_color = slider->custom_track_color ? *slider->custom_track_color : current_theme->bg_secondary;
-    draw_rect_(base, sx, sy + (sh / 2) - (track_height / 2), sw, track_height, track_color);
+    record_rect_(list, base, sx, sy + (sh / 2) - (track_height / 2), sw, track_height, track_color);
 
     // Calculate thumb position
     float range = slider->max - slider->min;
@@ -127,27 +201,35 @@ static inline void render_slider(Slider* slider) {
     }
 
     // Draw thumb as rectangle
-    draw_rect_(base, sthumb_x - (thumb_width / 2), sy, thumb_width, sh, thumb_color);
+    record_rect_(list, base, sthumb_x - (thumb_width / 2), sy, thumb_width, sh, thumb_color);
 
     // Draw label if exists (positioned to the right of the slider, centered vertically)
     if (slider->label) {
         Color label_color = slider->custom_label_color ? *slider->custom_label_color : current_theme->text_secondary;
-        draw_text_(base, slider->label, font_size, sx + sw + label_pad, sy + (sh / 2) - label_v_offset, label_color);
+        record_text_(list, base, NULL, font_size, slider->label, sx + sw + label_pad, sy + (sh / 2) - label_v_offset,
+                     label_color, ALIGN_LEFT);
     }
     // Reset clipping
-    SDL_RenderSetClipRect(slider->parent->base.sdl_renderer, NULL);
+    record_clip_(list, base, NULL);
+}
+
+static inline void render_slider(Slider* slider) {
+    record_slider_(begin_immediate_draw_(), slider);
+    end_immediate_draw_();
 }
 
 // -------- Update --------
 static inline void update_slider(Slider* slider, SDL_Event event) {
-    if (!slider || !slider->parent || !slider->parent->is_open) {
-        printf("Invalid slider, parent, or parent is not open\n");
+    if (!slider || !slider->parent) {
+        LOG_ERROR("Invalid slider or parent");
         return;
     }
+    // Children of a closed container are skipped every frame; not worth a message
+    if (!is_parent_open(slider->parent)) return;
 
     // Calculate absolute position relative to parent (logical)
-    int abs_x = slider->x + slider->parent->x;
-    int abs_y = slider->y + slider->parent->y + slider->parent->title_height;
+    int abs_x = slider->x + slider->parent->content_x;
+    int abs_y = slider->y + slider->parent->content_y;
 
     // Calculate thumb position and bounds (logical)
     float range = slider->max - slider->min;
@@ -162,8 +244,11 @@ static inline void update_slider(Slider* slider, SDL_Event event) {
 
     // Check if mouse is over the thumb for hover
     int over_thumb = (mouse_x >= thumb_rect.x && mouse_x <= thumb_rect.x + thumb_rect.w &&
-                      mouse_y >= thumb_rect.y && mouse_y <= thumb_rect.y + thumb_rect.h);
+                      mouse_y >= thumb_rect.y && mouse_y <= thumb_rect.y + thumb_rect.h) &&
+                     is_logical_point_in_parent_clip(slider->parent, mouse_x, mouse_y);
 
+    bool was_hovered = slider->is_hovered, was_dragging = slider->dragging;
+    int was_value = slider->value;
     if (event.type == SDL_MOUSEMOTION) {
         slider->is_hovered = over_thumb;
         if (slider->dragging) {
@@ -171,20 +256,28 @@ static inline void update_slider(Slider* slider, SDL_Event event) {
             int new_value = slider->min + (int)(((mouse_x - abs_x) / (float)slider->w) * range);
             if (new_value < slider->min) new_value = slider->min;
             if (new_value > slider->max) new_value = slider->max;
+            if (new_value != slider->value) notify_change_(&slider->notifier, slider->value, new_value);
             slider->value = new_value;
+            set_observable_int(slider->binding, new_value);
         }
     } else if (event.type == SDL_MOUSEBUTTONDOWN && event.button.button == SDL_BUTTON_LEFT) {
         if (over_thumb) {
             slider->dragging = true;
         }
     } else if (event.type == SDL_MOUSEBUTTONUP && event.button.button == SDL_BUTTON_LEFT) {
+        if (slider->dragging) notify_commit_(&slider->notifier, slider->value);  // Always, even if throttled
         slider->dragging = false;
     }
+    if (slider->is_hovered != was_hovered || slider->dragging != was_dragging || slider->value != was_value) {
+        mark_child_dirty(slider->parent, slider_box_(slider, get_child_rect(slider->parent, &slider->rect_cache, slider->x, slider->y, slider->w, slider->h)));
+    }
 }
 
 // -------- Free --------
 static inline void free_slider(Slider* slider) {
     if (slider) {
+        bind_slider(slider, NULL);
+        free_change_notifier_(&slider->notifier);
         free(slider->label);
         if (slider->custom_track_color) free(slider->custom_track_color);
         if (slider->custom_thumb_color) free(slider->custom_thumb_color);
@@ -10,6 +10,7 @@
 #include <string.h> // for strdup
 #include <SDL2/SDL.h> // for SDL_Event, etc.
 #include <SDL2/SDL_ttf.h> // for TTF_Font
+#include <math.h>   // For roundf in scaling
 
 
 typedef struct {
@@ -19,11 +20,13 @@ typedef struct {
     int font_size;             // Font size in points
     Color* color;               // Text color
     TextAlign align;           // Alignment (LEFT, CENTER, RIGHT)
+    ChildRect rect_cache;      // Cached physical position (see get_child_rect)
+    Observable* binding;       // Optional cell the content follows (see bind_text)
 } Text;
 
 Text new_text(Parent* parent, int x, int y, const char* content, int font_size, TextAlign align) {
     if (!parent || !parent->base.sdl_renderer) {
-        printf("Invalid parent or renderer\n");
+        LOG_ERROR("Invalid parent or renderer");
     }
 
     Text new_text;
@@ -33,50 +36,64 @@ Text new_text(Parent* parent, int x, int y, const char* content, int font_size,
     new_text.y = y;
     new_text.content = strdup(content);
     if (!new_text.content) {
-        printf("Failed to allocate memory for text content\n");
+        LOG_ERROR("Failed to allocate memory for text content");
     }
     new_text.font_size = font_size;
     new_text.color = NULL;
     new_text.align = align;
+    new_text.rect_cache = (ChildRect){0};
+    new_text.binding = NULL;
 
     return new_text;
 }
 
-void render_text(Text* text) {
-    if (!text || !text->parent || !text->parent->base.sdl_renderer || !text->parent->is_open) {
-        printf("Invalid text widget, renderer, or parent is not open\n");
+// Estimated physical extent of the text, anchored according to its alignment
+static inline SDL_Rect text_box_(Text* text) {
+    SDL_Rect rect = get_child_rect(text->parent, &text->rect_cache, text->x, text->y, 0, 0);
+    int box_size = (int)roundf(text->font_size * text->parent->base.dpi_scale);
+    SDL_Rect box = {rect.x, rect.y, estimate_text_width_(text->content, box_size), box_size};
+    if (text->align == ALIGN_CENTER) box.x -= box.w / 2;
+    else if (text->align == ALIGN_RIGHT) box.x -= box.w;
+    return box;
+}
+
+// Records the text into `list`; safe on a job worker (the font is opened at submit)
+static inline void record_text_widget_(DrawList* list, Text* text) {
+    if (!text || !text->parent || !text->parent->base.sdl_renderer) {
+        LOG_ERROR("Invalid text widget or renderer");
         return;
     }
+    // Children of a closed container are skipped every frame; not worth a message
+    if (!is_parent_open(text->parent)) return;
+    // Estimated extent of the text, anchored according to its alignment
+    SDL_Rect box = text_box_(text);
+    SDL_Rect rect = text->rect_cache.rect;
+    // Skip widgets scrolled out of the parent's viewport or hidden behind an opaque container
+    if (!is_child_visible(text->parent, box) || is_child_occluded(text->parent, box)) return;
+
     //set container clipping
     if(text->parent->is_window == false){
     SDL_Rect parent_bounds = get_parent_rect(text->parent);
-    SDL_RenderSetClipRect(text->parent->base.sdl_renderer, &parent_bounds);
+    record_clip_(list, &text->parent->base, &parent_bounds);
     }
 
-      // Fallback if no theme set
-    if (!current_theme) {
-        // Use hardcoded defaults (your original colors)
-        current_theme = (Theme*)&THEME_LIGHT;  // Or set a static fallback
-    }
-    
 	const Color* color_to_use = text->color ? text->color : &current_theme->text_primary;
 
-    // Calculate absolute position relative to parent
-    int abs_x = text->x + text->parent->x;
-    int abs_y = text->y + text->parent->y + text->parent->title_height;
+    // Cached physical position (position and font size are both DPI-scaled)
+    float dpi = text->parent->base.dpi_scale;
+    int font_size = (int)roundf(text->font_size * dpi);
 
     // Draw the text
     if (text->content) {
-        TTF_Font* font = TTF_OpenFont(FONT_FILE, text->font_size);
-        if (font) {
-            draw_text_from_font_(&(text->parent->base), font, text->content, abs_x, abs_y, *color_to_use, text->align);
-            TTF_CloseFont(font);
-        } else {
-            printf("Failed to load font for text rendering\n");
-        }
+        record_text_(list, &(text->parent->base), NULL, font_size, text->content, rect.x, rect.y, *color_to_use, text->align);
     }
     // Reset clipping
-    SDL_RenderSetClipRect(text->parent->base.sdl_renderer, NULL);
+    record_clip_(list, &text->parent->base, NULL);
+}
+
+void render_text(Text* text) {
+    record_text_widget_(begin_immediate_draw_(), text);
+    end_immediate_draw_();
 }
 // Setters for overrides
 static inline void set_text_color(Text* text, Color color) {
@@ -85,12 +102,77 @@ static inline void set_text_color(Text* text, Color color) {
     if (!text->color) {
         text->color = (Color*)malloc(sizeof(Color));
         if (!text->color) {
-            printf("Failed to allocate memory for text color\n");
+            LOG_ERROR("Failed to allocate memory for text color");
             return;
         }
     }
 
     *(text->color) = color;  // copy the struct
+    mark_child_dirty(text->parent, text_box_(text));
+}
+
+// Swaps in an owned string and redraws both the old and the new extent
+static inline void replace_text_content_(Text* text, char* content) {
+    if (text->content && strcmp(text->content, content) == 0) {
+        free(content);
+        return;
+    }
+    mark_child_dirty(text->parent, text_box_(text));
+    free(text->content);
+    text->content = content;
+    mark_child_dirty(text->parent, text_box_(text));
+}
+
+// Replaces the displayed string (copied)
+static inline void set_text_content(Text* text, const char* content) {
+    if (!text || !content) return;
+    char* copy = strdup(content);
+    if (!copy) {
+        LOG_ERROR("Failed to allocate memory for text content");
+        return;
+    }
+    replace_text_content_(text, copy);
+}
+
+static inline void on_text_binding_(Observable* cell, void* userdata) {
+    if (cell->kind == OBSERVABLE_INT) {
+        char number[16];
+        snprintf(number, sizeof(number), "%d", cell->value);
+        set_text_content((Text*)userdata, number);
+    } else {
+        set_text_content((Text*)userdata, get_observable_text(cell));
+    }
+}
+
+// Makes the text show a cell (one way); int cells are shown in decimal. NULL unbinds.
+static inline void bind_text(Text* text, Observable* cell) {
+    if (!text) return;
+    if (text->binding) unobserve(text->binding, on_text_binding_, text);
+    text->binding = cell;
+    if (cell && observe(cell, on_text_binding_, text)) {
+        on_text_binding_(cell, text);
+    }
+}
+
+// -------- Updates from other threads (applied once per frame, see updates.h) --------
+static inline void apply_text_content_(void* target, WidgetUpdateValue* value) {
+    replace_text_content_((Text*)target, value->text);  // Take the posted copy
+    value->text = NULL;
+}
+
+static inline void apply_text_color_(void* target, WidgetUpdateValue* value) {
+    set_text_color((Text*)target, value->color);
+}
+
+// Thread-safe set_text_content; only the newest string per frame is applied
+static inline void post_text_content(Text* text, const char* content) {
+    char* copy = content ? strdup(content) : NULL;
+    if (!copy) return;
+    post_widget_update_(text, apply_text_content_, (WidgetUpdateValue){.text = copy});
+}
+
+static inline void post_text_color(Text* text, Color color) {
+    post_widget_update_(text, apply_text_color_, (WidgetUpdateValue){.color = color});
 }
 
 void update_text(Text* text, SDL_Event event) {
@@ -101,6 +183,7 @@ void update_text(Text* text, SDL_Event event) {
 
 void free_text(Text *text) {
     if (!text) return;
+    bind_text(text, NULL);
     free(text->content);
     free(text->color);
 }
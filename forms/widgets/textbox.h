@@ -10,17 +10,15 @@ typedef struct {
     int len;
 } Line;
 
-Line* compute_visual_lines(const char* text, int max_width, TTF_Font* font, int* num_lines) {
-    *num_lines = 0;
-    if (!text) return NULL;
-
-    int text_len = strlen(text);
-    int max_lines = text_len * 2 + 2; // Safe upper bound for wraps and newlines
-    Line* lines = (Line*)malloc(sizeof(Line) * max_lines);
-    if (!lines) return NULL;
-
-    int line_start = 0;
-    for (int pos = 0; pos <= text_len; pos++) {
+#define TEXTBOX_PARALLEL_LAYOUT_BYTES 8192  // Smaller texts wrap inline; a job costs more than it saves
+#define TEXTBOX_LAYOUT_CHUNK_BYTES 4096     // Per job, extended to the end of a paragraph
+
+// Wraps the paragraphs of text[from..to] (`to` is a '\n' or text_len) using per-byte advances.
+// Pure and thread safe; appends to lines[*num_lines].
+static void wrap_text_range_(const char* text, int from, int to, int text_len, int max_width,
+                             const int* adv, Line* lines, int* num_lines) {
+    int line_start = from;
+    for (int pos = from; pos <= to; pos++) {
         if (pos == text_len || text[pos] == '\n') {
             int seg_start = line_start;
             int seg_len = pos - line_start;
@@ -30,13 +28,12 @@ Line* compute_visual_lines(const char* text, int max_width, TTF_Font* font, int*
                 int last_space = -1;
                 int current_width = 0;
                 while (seg_pos < seg_len) {
-                    char ch[2] = {text[seg_start + seg_pos], '\0'};
-                    int char_w;
-                    TTF_SizeText(font, ch, &char_w, NULL);
+                    unsigned char ch = (unsigned char)text[seg_start + seg_pos];
+                    int char_w = adv[ch];
                     if (current_width + char_w > max_width) {
                         if (current_width == 0) {
                             current_width += char_w;
-                            if (isspace(ch[0])) last_space = seg_pos;
+                            if (isspace(ch)) last_space = seg_pos;
                             seg_pos++;
                             continue;
                         }
@@ -58,7 +55,7 @@ Line* compute_visual_lines(const char* text, int max_width, TTF_Font* font, int*
                         continue;
                     }
                     current_width += char_w;
-                    if (isspace(text[seg_start + seg_pos])) last_space = seg_pos;
+                    if (isspace(ch)) last_space = seg_pos;
                     seg_pos++;
                 }
                 // Add last part of wrap
@@ -78,9 +75,137 @@ Line* compute_visual_lines(const char* text, int max_width, TTF_Font* font, int*
             line_start = pos + 1;
         }
     }
+}
+
+// One paragraph-aligned slice of a long text, wrapped on a job worker
+typedef struct {
+    const char* text;
+    int from, to, text_len, max_width;
+    const int* adv;
+    Line* lines;
+    int num_lines;
+} WrapJob;
+
+static void run_wrap_job_(void* data) {
+    WrapJob* job = (WrapJob*)data;
+    wrap_text_range_(job->text, job->from, job->to, job->text_len, job->max_width, job->adv, job->lines, &job->num_lines);
+}
+
+// Splits a long text into paragraph-aligned slices, each with room for its lines.
+// Returns NULL (nothing allocated) on failure.
+static WrapJob* split_wrap_jobs_(const char* text, int text_len, int max_width, const int* adv, int* count) {
+    int max_jobs = text_len / TEXTBOX_LAYOUT_CHUNK_BYTES + 1;
+    WrapJob* jobs = (WrapJob*)calloc((size_t)max_jobs, sizeof(WrapJob));
+    if (!jobs) return NULL;
+    *count = 0;
+    for (int from = 0; from <= text_len; (*count)++) {
+        int to = from + TEXTBOX_LAYOUT_CHUNK_BYTES;
+        if (to >= text_len || *count == max_jobs - 1) {
+            to = text_len;
+        } else {
+            while (to < text_len && text[to] != '\n') to++;
+        }
+        WrapJob* job = &jobs[*count];
+        job->text = text;
+        job->from = from;
+        job->to = to;
+        job->text_len = text_len;
+        job->max_width = max_width;
+        job->adv = adv;
+        job->lines = (Line*)malloc(sizeof(Line) * ((to - from) * 2 + 2));
+        if (!job->lines) {
+            for (int i = 0; i < *count; i++) free(jobs[i].lines);
+            free(jobs);
+            return NULL;
+        }
+        from = to + 1;
+    }
+    return jobs;
+}
+
+// Appends the wrapped slices' lines, in order, to lines[*num_lines]
+static void join_wrap_jobs_(const WrapJob* jobs, int count, Line* lines, int* num_lines) {
+    for (int i = 0; i < count; i++) {
+        memcpy(&lines[*num_lines], jobs[i].lines, sizeof(Line) * jobs[i].num_lines);
+        *num_lines += jobs[i].num_lines;
+    }
+}
+
+static void free_wrap_jobs_(WrapJob* jobs, int count) {
+    if (!jobs) return;
+    for (int i = 0; i < count; i++) free(jobs[i].lines);
+    free(jobs);
+}
+
+// Splits a long text into paragraph-aligned jobs and joins their lines in order.
+// Returns false (nothing allocated) if it could not be split; the caller wraps inline.
+static bool wrap_text_parallel_(const char* text, int text_len, int max_width, const int* adv, Line* lines, int* num_lines) {
+    int count = 0;
+    WrapJob* jobs = split_wrap_jobs_(text, text_len, max_width, adv, &count);
+    JobGroup* group = jobs ? new_job_group() : NULL;
+    if (!group) {
+        free_wrap_jobs_(jobs, count);
+        return false;
+    }
+    bool ok = true;
+    for (int i = 0; i < count && ok; i++) {
+        ok = add_job(group, run_wrap_job_, &jobs[i]);
+    }
+    submit_job_group(group, NULL, NULL);
+    wait_job_group(group);  // The main thread wraps chunks too while it waits
+
+    if (ok) join_wrap_jobs_(jobs, count, lines, num_lines);
+    free_wrap_jobs_(jobs, count);
+    return ok;
+}
+
+Line* compute_visual_lines(const char* text, int max_width, TTF_Font* font, int* num_lines) {
+    *num_lines = 0;
+    if (!text) return NULL;
+
+    int text_len = strlen(text);
+    int max_lines = text_len * 2 + 2; // Safe upper bound for wraps and newlines
+    Line* lines = (Line*)malloc(sizeof(Line) * max_lines);
+    if (!lines) return NULL;
+
+    // Measure each distinct byte once (TTF is main-thread only); wrapping then needs no font
+    int adv[256];
+    bool measured[256] = {false};
+    for (int i = 0; i < text_len; i++) {
+        unsigned char c = (unsigned char)text[i];
+        if (measured[c] || c == '\n') continue;
+        char ch[2] = {(char)c, '\0'};
+        adv[c] = 0;
+        TTF_SizeText(font, ch, &adv[c], NULL);
+        measured[c] = true;
+    }
+
+    if (text_len >= TEXTBOX_PARALLEL_LAYOUT_BYTES && start_jobs_() &&
+        wrap_text_parallel_(text, text_len, max_width, adv, lines, num_lines)) {
+        return lines;
+    }
+    wrap_text_range_(text, 0, text_len, text_len, max_width, adv, lines, num_lines);
     return lines;
 }
 
+typedef struct TextLayoutJob TextLayoutJob;
+
+// Line breaks of a textbox's text in logical pixels, kept between frames (see textbox_lines_)
+typedef struct {
+    Line* lines;               // Front layout: the last completed wrap, patched after each edit
+    int num_lines;
+    int capacity;
+    bool valid;                // `lines` cover the text (possibly approximately)
+    bool exact;                // `lines` are what a full wrap of the current text gives
+    int max_width;             // Key the layout is for: wrap width, font file and size
+    const char* font_file;
+    int font_size;
+    int adv[256];              // Per-byte advances of the key's font
+    bool measured[256];
+    unsigned version;          // Bumped by every edit
+    TextLayoutJob* pending;    // Full re-wrap running on the job system, or NULL
+} TextLayout;
+
 typedef struct {
     Parent* parent;            // Pointer to the parent window or container
     int x, y;                  // Position of the textbox (logical)
@@ -94,13 +219,16 @@ typedef struct {
     int visible_line_start;    // Index of first visible line
     int line_height;           // Height of each line (logical, computed from font)
     int is_mouse_selecting;    // Flag to track if mouse is being used to select text
+    ChildRect rect_cache;      // Cached physical rect (see get_child_rect)
+    CursorBlink blink;         // Cursor blink while active (see timers.h)
+    TextLayout layout;         // Wrapped lines, updated off the UI thread for long texts
 } TextBox;
 
 void register_widget_textbox(TextBox* textbox);
 
 TextBox new_textbox(Parent* parent, int x, int y, int w, int max_length) {
     if (!parent || !parent->base.sdl_renderer) {
-        printf("Invalid parent or renderer\n");
+        LOG_ERROR("Invalid parent or renderer");
     }
 
     // Fallback if no theme set
@@ -117,7 +245,7 @@ TextBox new_textbox(Parent* parent, int x, int y, int w, int max_length) {
     new_textbox.parent = parent;
     new_textbox.place_holder = strdup(" "); // Default placeholder
     if (!new_textbox.place_holder) {
-        printf("Failed to allocate memory for placeholder\n");
+        LOG_ERROR("Failed to allocate memory for placeholder");
     }
     new_textbox.x = x;
     new_textbox.y = y;
@@ -126,7 +254,7 @@ TextBox new_textbox(Parent* parent, int x, int y, int w, int max_length) {
     new_textbox.max_length = max_length;
     new_textbox.text = (char*)malloc(max_length + 1);
     if (!new_textbox.text) {
-        printf("Failed to allocate memory for textbox text\n");
+        LOG_ERROR("Failed to allocate memory for textbox text");
         free(new_textbox.place_holder);
     }
     new_textbox.text[0] = '\0';
@@ -135,9 +263,12 @@ TextBox new_textbox(Parent* parent, int x, int y, int w, int max_length) {
     new_textbox.selection_start = -1;
     new_textbox.visible_line_start = 0;
     new_textbox.is_mouse_selecting = 0; // Initialize mouse selection flag
+    new_textbox.rect_cache = (ChildRect){0};
+    new_textbox.blink = (CursorBlink){0};
+    new_textbox.layout = (TextLayout){0};
 
     // Compute line_height from font (logical)
-    TTF_Font* font = TTF_OpenFont(font_file, logical_font_size);
+    TTF_Font* font = open_font_(font_file, logical_font_size);
     if (font) {
         new_textbox.line_height = TTF_FontHeight(font);
         TTF_CloseFont(font);
@@ -148,35 +279,335 @@ TextBox new_textbox(Parent* parent, int x, int y, int w, int max_length) {
     return new_textbox;
 }
 
-// Renders the textbox widget to the screen
+// ______________LAYOUT_____________
+// Wrapping a long text takes far longer than a frame, so a textbox keeps its lines
+// (TextLayout) instead of wrapping on every render and event. An edit changes the
+// buffer at once and patches the lines around it: the edited paragraph is wrapped
+// again and the lines after it are shifted, which is exact. In a paragraph too long
+// to wrap per keystroke, only the stretch from the line before the edit to the next
+// line is wrapped, and the whole text is then wrapped again on the job system from
+// a copy of the buffer. Until that result lands the patched lines are drawn; it is
+// only swapped in if no edit came after the copy was taken.
+
+// A full wrap of one version of a textbox's text, running on the job system
+struct TextLayoutJob {
+    TextBox* owner;            // NULL once the textbox is freed
+    unsigned version;          // owner->layout.version when the text was copied
+    int max_width;             // Layout key at that time
+    const char* font_file;
+    int font_size;
+    char* text;                // Copy; the textbox keeps being edited meanwhile
+    int adv[256];
+    WrapJob* chunks;
+    int chunk_count;
+    bool failed;               // A chunk could not be queued; the result is incomplete
+    JobGroup* group;
+};
+
+static void start_layout_job_(TextBox* textbox);
+
+// Index of the first line starting after `pos` (lines are sorted by start)
+static int line_after_(const TextLayout* layout, int pos) {
+    int lo = 0, hi = layout->num_lines;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (layout->lines[mid].start <= pos) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+// Visual line holding byte `pos` (the earlier one where two lines meet), or -1
+static int find_text_line_(const Line* lines, int num_lines, int pos) {
+    int lo = 0, hi = num_lines;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (lines[mid].start <= pos) lo = mid + 1;
+        else hi = mid;
+    }
+    for (int i = lo - 2; i < lo; i++) {
+        if (i >= 0 && pos >= lines[i].start && pos <= lines[i].start + lines[i].len) return i;
+    }
+    return -1;
+}
+
+// Measures the bytes of text[from..to) the layout has no advance for yet. SDL_ttf, so
+// UI thread only; the font is opened on first need and left in *font for the caller.
+static void measure_layout_bytes_(TextLayout* layout, const char* text, int from, int to, TTF_Font** font) {
+    for (int i = from; i < to; i++) {
+        unsigned char c = (unsigned char)text[i];
+        if (layout->measured[c] || c == '\n') continue;
+        layout->adv[c] = 0;
+        layout->measured[c] = true;
+        if (!*font) {
+            *font = open_font_(layout->font_file, layout->font_size);
+            if (!*font) {
+                LOG_ERROR("Failed to load font: %s", TTF_GetError());
+                continue;
+            }
+        }
+        char ch[2] = {(char)c, '\0'};
+        TTF_SizeText(*font, ch, &layout->adv[c], NULL);
+    }
+}
+
+// Makes `lines` (count of capacity, malloc'ed) the front layout
+static void install_layout_lines_(TextLayout* layout, Line* lines, int count, int capacity, bool exact) {
+    free(layout->lines);
+    layout->lines = lines;
+    layout->num_lines = count;
+    layout->capacity = capacity;
+    layout->valid = true;
+    layout->exact = exact;
+}
+
+// Wraps text[0..to) right here (to < text_len gives an approximate head of a long text)
+static void wrap_layout_now_(TextLayout* layout, const char* text, int to, int text_len) {
+    TTF_Font* font = NULL;
+    measure_layout_bytes_(layout, text, 0, to, &font);
+    if (font) TTF_CloseFont(font);
+
+    int capacity = to * 2 + 2;
+    Line* lines = (Line*)malloc(sizeof(Line) * capacity);
+    if (!lines) {
+        LOG_ERROR("Failed to allocate textbox lines");
+        return;
+    }
+    int count = 0;
+    wrap_text_range_(text, 0, to, to, layout->max_width, layout->adv, lines, &count);
+    install_layout_lines_(layout, lines, count, capacity, to == text_len);
+}
+
+// Replaces lines [first, last) with `count` new ones and moves the starts of the lines
+// after them by `shift` bytes
+static bool splice_layout_lines_(TextLayout* layout, int first, int last, const Line* lines, int count, int shift) {
+    int tail = layout->num_lines - last;
+    int needed = first + count + tail;
+    if (needed > layout->capacity) {
+        int capacity = layout->capacity * 2 > needed ? layout->capacity * 2 : needed;
+        Line* grown = (Line*)realloc(layout->lines, sizeof(Line) * capacity);
+        if (!grown) return false;
+        layout->lines = grown;
+        layout->capacity = capacity;
+    }
+    memmove(&layout->lines[first + count], &layout->lines[last], sizeof(Line) * tail);
+    memcpy(&layout->lines[first], lines, sizeof(Line) * count);
+    for (int i = first + count; i < needed; i++) layout->lines[i].start += shift;
+    layout->num_lines = needed;
+    return true;
+}
+
+// Brings the layout key in line with the theme and the textbox width. A changed key keeps
+// the old lines on screen until they are wrapped again.
+static void sync_layout_key_(TextBox* textbox) {
+    if (!current_theme) {
+        current_theme = (Theme*)&THEME_LIGHT;
+    }
+    TextLayout* layout = &textbox->layout;
+    const char* font_file = current_theme->font_file ? current_theme->font_file : "FreeMono.ttf";
+    int font_size = current_theme->default_font_size;
+    int max_width = textbox->w - 2 * current_theme->padding;
+    if (font_file == layout->font_file && font_size == layout->font_size && max_width == layout->max_width) return;
+
+    if (font_file != layout->font_file || font_size != layout->font_size) {
+        memset(layout->measured, 0, sizeof(layout->measured));
+    }
+    layout->font_file = font_file;
+    layout->font_size = font_size;
+    layout->max_width = max_width;
+    layout->exact = false;
+}
+
+// Records an edit already applied to textbox->text: `removed` bytes at `pos` were
+// replaced by `inserted` bytes. Patches the front layout around it (see above).
+static void textbox_edited_(TextBox* textbox, int pos, int removed, int inserted) {
+    TextLayout* layout = &textbox->layout;
+    layout->version++;
+    sync_layout_key_(textbox);
+    if (!layout->valid) return;  // textbox_lines_ wraps from scratch
+
+    const char* text = textbox->text;
+    int text_len = strlen(text);
+    int shift = inserted - removed;
+
+    // The edited paragraph(s) in the new text; wrapping restarts at a paragraph start
+    int from = pos;
+    while (from > 0 && text[from - 1] != '\n') from--;
+    int to = pos + inserted;
+    while (to < text_len && text[to] != '\n') to++;
+    int first = line_after_(layout, from - 1);     // Old lines from `from` ...
+    int last = line_after_(layout, to - shift);    // ... through the old paragraph end
+    bool exact = layout->exact;
+
+    if (to - from > TEXTBOX_LAYOUT_CHUNK_BYTES) {
+        // Too long to wrap per keystroke: from the line before the edit (it may take a
+        // word back) to the line after it; the rest is corrected by the full re-wrap
+        int line = line_after_(layout, pos) - 2;
+        if (line >= 0 && layout->lines[line].start > from) from = layout->lines[line].start;
+        int next = line_after_(layout, pos + removed);
+        if (next < layout->num_lines && layout->lines[next].start + shift < to) {
+            to = layout->lines[next].start + shift;  // Ends the stretch with a forced break
+            last = next;
+        }
+        first = line_after_(layout, from - 1);
+        exact = false;
+    }
+
+    TTF_Font* font = NULL;
+    measure_layout_bytes_(layout, text, from, to, &font);
+    if (font) TTF_CloseFont(font);
+
+    Line* lines = (Line*)malloc(sizeof(Line) * ((to - from) * 2 + 2));
+    int count = 0;
+    if (lines) {
+        wrap_text_range_(text, from, to, to, layout->max_width, layout->adv, lines, &count);
+    }
+    if (!lines || !splice_layout_lines_(layout, first, last, lines, count, shift)) {
+        layout->valid = layout->exact = false;  // Wrapped from scratch on next use
+        free(lines);
+        return;
+    }
+    free(lines);
+    layout->exact = exact;
+    if (!exact && !layout->pending) start_layout_job_(textbox);
+}
+
+// Job group `done`, on the UI thread: swaps the new layout in unless it is outdated
+static void finish_layout_job_(void* data) {
+    TextLayoutJob* job = (TextLayoutJob*)data;
+    TextBox* textbox = job->owner;
+    if (textbox) {
+        TextLayout* layout = &textbox->layout;
+        layout->pending = NULL;
+        bool current = job->version == layout->version && job->max_width == layout->max_width &&
+                       job->font_file == layout->font_file && job->font_size == layout->font_size;
+        int capacity = 0;
+        Line* lines = NULL;
+        if (current && !job->failed) {
+            for (int i = 0; i < job->chunk_count; i++) capacity += job->chunks[i].num_lines;
+            lines = (Line*)malloc(sizeof(Line) * (capacity > 0 ? capacity : 1));
+        }
+        if (lines) {
+            int count = 0;
+            join_wrap_jobs_(job->chunks, job->chunk_count, lines, &count);
+            install_layout_lines_(layout, lines, count, capacity, true);
+            mark_child_dirty(textbox->parent, get_child_rect(textbox->parent, &textbox->rect_cache,
+                                                             textbox->x, textbox->y, textbox->w, textbox->h));
+        } else if (current) {
+            wrap_layout_now_(layout, textbox->text, strlen(textbox->text), strlen(textbox->text));
+        } else if (!layout->exact) {
+            start_layout_job_(textbox);  // Edited since the copy: wrap the text as it is now
+        }
+    }
+    free_wrap_jobs_(job->chunks, job->chunk_count);
+    free(job->text);
+    free(job);
+}
+
+// Starts a full wrap of textbox->text on the job system (or does it right here if the
+// job system is unavailable)
+static void start_layout_job_(TextBox* textbox) {
+    TextLayout* layout = &textbox->layout;
+    const char* text = textbox->text;
+    int text_len = strlen(text);
+    TTF_Font* font = NULL;
+    measure_layout_bytes_(layout, text, 0, text_len, &font);  // TTF stays on this thread
+    if (font) TTF_CloseFont(font);
+
+    TextLayoutJob* job = start_jobs_() ? (TextLayoutJob*)calloc(1, sizeof(TextLayoutJob)) : NULL;
+    if (job) job->text = (char*)malloc(text_len + 1);
+    if (job && job->text) {
+        memcpy(job->text, text, text_len + 1);
+        memcpy(job->adv, layout->adv, sizeof(job->adv));
+        job->chunks = split_wrap_jobs_(job->text, text_len, layout->max_width, job->adv, &job->chunk_count);
+    }
+    if (job && job->chunks) job->group = new_job_group();
+    if (!job || !job->group) {
+        if (job) {
+            free_wrap_jobs_(job->chunks, job->chunk_count);
+            free(job->text);
+            free(job);
+        }
+        wrap_layout_now_(layout, text, text_len, text_len);
+        return;
+    }
+
+    job->owner = textbox;
+    job->version = layout->version;
+    job->max_width = layout->max_width;
+    job->font_file = layout->font_file;
+    job->font_size = layout->font_size;
+    for (int i = 0; i < job->chunk_count; i++) {
+        if (!add_job(job->group, run_wrap_job_, &job->chunks[i])) job->failed = true;
+    }
+    layout->pending = job;
+    submit_job_group(job->group, finish_layout_job_, job);
+}
+
+// Line breaks of textbox->text for the current theme and width, in logical pixels.
+// Never waits for a wrap of a long text: while one runs on the job system this gives
+// the last completed layout with the edits patched in. UI thread only.
+static const Line* textbox_lines_(TextBox* textbox, int* num_lines) {
+    TextLayout* layout = &textbox->layout;
+    sync_layout_key_(textbox);
+    if (!layout->exact && !layout->pending) {
+        int text_len = strlen(textbox->text);
+        if (text_len < TEXTBOX_PARALLEL_LAYOUT_BYTES) {
+            wrap_layout_now_(layout, textbox->text, text_len, text_len);
+        } else {
+            if (!layout->valid) {
+                // Nothing to show yet: the start of the text stands in until the job lands
+                wrap_layout_now_(layout, textbox->text, TEXTBOX_LAYOUT_CHUNK_BYTES, text_len);
+            }
+            start_layout_job_(textbox);
+        }
+    }
+    *num_lines = layout->valid ? layout->num_lines : 0;
+    return layout->lines;
+}
+
+// Drops the layout; waits for a running wrap so that no job outlives the textbox
+static void free_textbox_layout_(TextBox* textbox) {
+    TextLayout* layout = &textbox->layout;
+    if (layout->pending) {
+        layout->pending->owner = NULL;
+        wait_job_group(layout->pending->group);  // Its `done` frees the job
+        layout->pending = NULL;
+    }
+    free(layout->lines);
+    *layout = (TextLayout){0};
+}
+
+// Records the textbox widget into `list`
+// Wraps and measures with SDL_ttf, so it runs on the thread that draws (never on a job worker)
 // Parameters:
+// - list: The draw list to append to
 // - textbox: The TextBox widget to render
-void render_textbox(TextBox* textbox) {
+static inline void record_textbox_(DrawList* list, TextBox* textbox) {
     // Validate inputs to ensure the textbox, its parent, and renderer are valid
-    if (!textbox || !textbox->parent || !textbox->parent->base.sdl_renderer || !textbox->parent->is_open) {
-        printf("Invalid textbox, renderer, or parent is not open\n");
+    if (!textbox || !textbox->parent || !textbox->parent->base.sdl_renderer) {
+        LOG_ERROR("Invalid textbox or renderer");
         return;
     }
+    // Children of a closed container are skipped every frame; not worth a message
+    if (!is_parent_open(textbox->parent)) return;
+    // Absolute physical rect, cached until the textbox or an ancestor moves
+    SDL_Rect rect = get_child_rect(textbox->parent, &textbox->rect_cache, textbox->x, textbox->y, textbox->w, textbox->h);
+    // Skip widgets scrolled out of the parent's viewport or hidden behind an opaque container
+    if (!is_child_visible(textbox->parent, rect) || is_child_occluded(textbox->parent, rect)) return;
+
 	//set container clipping
 	if(textbox->parent->is_window == false){
 	SDL_Rect parent_bounds = get_parent_rect(textbox->parent);
-	SDL_RenderSetClipRect(textbox->parent->base.sdl_renderer, &parent_bounds);
+	record_clip_(list, &textbox->parent->base, &parent_bounds);
 	}
-    // Default to light theme if none is set
-    if (!current_theme) {
-        current_theme = (Theme*)&THEME_LIGHT;
-    }
-
     // Get DPI scale for converting logical coordinates to physical pixels
     float dpi = textbox->parent->base.dpi_scale;
 
-    // Calculate absolute position in logical coordinates, accounting for parent position and title bar
-    int abs_x = textbox->x + textbox->parent->x;
-    int abs_y = textbox->y + textbox->parent->y + textbox->parent->title_height;
-    int sx = (int)roundf(abs_x * dpi);
-    int sy = (int)roundf(abs_y * dpi);
-    int sw = (int)roundf(textbox->w * dpi);
-    int sh = (int)roundf(textbox->h * dpi);
+    int sx = rect.x;
+    int sy = rect.y;
+    int sw = rect.w;
+    int sh = rect.h;
     int border_width = (int)roundf(2 * dpi);
     int padding = (int)roundf(current_theme->padding * dpi);
     int cursor_width = (int)roundf(2 * dpi);
@@ -184,9 +615,9 @@ void render_textbox(TextBox* textbox) {
     char* font_file = current_theme->font_file ? current_theme->font_file : "FreeMono.ttf";
 
     // Load the font for rendering text
-    TTF_Font* font = TTF_OpenFont(font_file, font_size);
+    TTF_Font* font = open_font_(font_file, font_size);
     if (!font) {
-        printf("Failed to load font: %s\n", TTF_GetError());
+        LOG_ERROR("Failed to load font: %s", TTF_GetError());
         return;
     }
 
@@ -200,28 +631,40 @@ void render_textbox(TextBox* textbox) {
     Color highlight_color = current_theme->accent_hovered; // Selection highlight color
 
     // Draw outline rect
-    draw_rect_(&textbox->parent->base, sx, sy, sw, sh, outline_color);
+    record_rect_(list, &textbox->parent->base, sx, sy, sw, sh, outline_color);
     // Draw textbox rect (background)
-    draw_rect_(&textbox->parent->base, sx + border_width, sy + border_width, 
-               sw - 2 * border_width, sh - 2 * border_width, bg_color);
+    record_rect_(list, &textbox->parent->base, sx + border_width, sy + border_width, 
+                       sw - 2 * border_width, sh - 2 * border_width, bg_color);
 
     // Determine text to display
     char* display_text = (textbox->is_active || textbox->text[0] != '\0') ? textbox->text : textbox->place_holder;
     Color text_color = (display_text == textbox->place_holder) ? current_theme->text_secondary : current_theme->text_primary;
     int text_x = sx + padding;
     int text_y = sy + padding;
-    int max_text_width = sw - 2 * padding;
 
-    // Compute visual lines (using scaled font and width, but since scale-invariant, lines same as logical)
+    // Visual lines in logical space (breaks are scale-invariant); the text's come from its
+    // kept layout, the placeholder is short and wrapped here
     int num_lines = 0;
-    Line* lines = compute_visual_lines(display_text, max_text_width, font, &num_lines);
+    Line* placeholder_lines = NULL;
+    const Line* lines;
+    if (display_text == textbox->text) {
+        lines = textbox_lines_(textbox, &num_lines);
+    } else {
+        placeholder_lines = compute_visual_lines(display_text, sw - 2 * padding, font, &num_lines);
+        lines = placeholder_lines;
+    }
 
     // Calculate number of visible lines
     int visible_lines_count = (sh - 2 * padding) / font_height;
 
     // Clip rendering to textbox rectangle
     SDL_Rect clip_rect = {sx + border_width, sy + border_width, sw - 2 * border_width, sh - 2 * border_width};
-    SDL_RenderSetClipRect(textbox->parent->base.sdl_renderer, &clip_rect);
+    if (textbox->parent->is_window == false) {
+        // Stay inside the container's (possibly nested) clip as well
+        SDL_Rect parent_bounds = get_parent_rect(textbox->parent);
+        if (!SDL_IntersectRect(&clip_rect, &parent_bounds, &clip_rect)) clip_rect.w = clip_rect.h = 0;
+    }
+    record_clip_(list, &textbox->parent->base, &clip_rect);
 
     // Determine selection range
     int sel_min = -1;
@@ -273,57 +716,59 @@ void render_textbox(TextBox* textbox) {
                         free(temp);
 
                         // Draw highlight
-                        draw_rect_(&textbox->parent->base, highlight_x, draw_y, highlight_w, font_height, highlight_color);
+                        record_rect_(list, &textbox->parent->base, highlight_x, draw_y, highlight_w, font_height, highlight_color);
                     }
                 }
             }
         }
 
         // Render line text
-        draw_text_from_font_(&textbox->parent->base, font, line_text, text_x, draw_y, text_color, ALIGN_LEFT);
+        record_text_(list, &textbox->parent->base, font_file, font_size, line_text, text_x, draw_y, text_color, ALIGN_LEFT);
 
         free(line_text);
     }
 
-    // Render cursor if active
-    if (textbox->is_active) {
-        for (int i = 0; i < num_lines; i++) {
+    // Render cursor if active and in the "on" half of its blink
+    if (textbox->is_active && textbox->blink.visible) {
+        int i = find_text_line_(lines, num_lines, textbox->cursor_pos);
+        if (i >= textbox->visible_line_start && i < textbox->visible_line_start + visible_lines_count) {
             Line l = lines[i];
-            if (textbox->cursor_pos >= l.start && textbox->cursor_pos <= l.start + l.len) {
-                if (i < textbox->visible_line_start || i >= textbox->visible_line_start + visible_lines_count) {
-                    break; // Not visible
-                }
-                int rel_line = i - textbox->visible_line_start;
-                int draw_y = text_y + rel_line * font_height;
-                int offset_chars = textbox->cursor_pos - l.start;
-
-                char* temp = (char*)malloc(offset_chars + 1);
-                if (temp) {
-                    strncpy(temp, display_text + l.start, offset_chars);
-                    temp[offset_chars] = '\0';
-                    int cursor_offset = 0;
-                    TTF_SizeText(font, temp, &cursor_offset, NULL);
-                    free(temp);
-
-                    int cursor_x = text_x + cursor_offset;
-                    draw_rect_(&textbox->parent->base, cursor_x, draw_y, cursor_width, font_height, cursor_color);
-                }
-                break;
+            int rel_line = i - textbox->visible_line_start;
+            int draw_y = text_y + rel_line * font_height;
+            int offset_chars = textbox->cursor_pos - l.start;
+
+            char* temp = (char*)malloc(offset_chars + 1);
+            if (temp) {
+                strncpy(temp, display_text + l.start, offset_chars);
+                temp[offset_chars] = '\0';
+                int cursor_offset = 0;
+                TTF_SizeText(font, temp, &cursor_offset, NULL);
+                free(temp);
+
+                int cursor_x = text_x + cursor_offset;
+                record_rect_(list, &textbox->parent->base, cursor_x, draw_y, cursor_width, font_height, cursor_color);
             }
         }
     }
 
-    free(lines);
-    SDL_RenderSetClipRect(textbox->parent->base.sdl_renderer, NULL);
+    free(placeholder_lines);
     TTF_CloseFont(font);
     // Reset clipping
-    SDL_RenderSetClipRect(textbox->parent->base.sdl_renderer, NULL);
+    record_clip_(list, &textbox->parent->base, NULL);
+}
+
+// Renders the textbox widget to the screen
+// Parameters:
+// - textbox: The TextBox widget to render
+void render_textbox(TextBox* textbox) {
+    record_textbox_(begin_immediate_draw_(), textbox);
+    end_immediate_draw_();
 }
 
 
 void update_visible_lines(TextBox* textbox) {
     if (!textbox || !textbox->parent) {
-        printf("Invalid textbox or parent\n");
+        LOG_ERROR("Invalid textbox or parent");
         return;
     }
 
@@ -332,31 +777,15 @@ void update_visible_lines(TextBox* textbox) {
         current_theme = (Theme*)&THEME_LIGHT;
     }
 
-    int logical_font_size = current_theme->default_font_size;
-    char* font_file = current_theme->font_file ? current_theme->font_file : "FreeMono.ttf";
     int logical_padding = current_theme->padding;
 
-    TTF_Font* font = TTF_OpenFont(font_file, logical_font_size);
-    if (!font) {
-        printf("Failed to load font: %s\n", TTF_GetError());
-        return;
-    }
-
-    int max_text_width = textbox->w - 2 * logical_padding;
     int num_lines = 0;
-    Line* lines = compute_visual_lines(textbox->text, max_text_width, font, &num_lines);
+    const Line* lines = textbox_lines_(textbox, &num_lines);
 
     int visible_lines = (textbox->h - 2 * logical_padding) / textbox->line_height;
 
     // Find cursor's visual line
-    int cursor_line = -1;
-    for (int i = 0; i < num_lines; i++) {
-        Line l = lines[i];
-        if (textbox->cursor_pos >= l.start && textbox->cursor_pos <= l.start + l.len) {
-            cursor_line = i;
-            break;
-        }
-    }
+    int cursor_line = find_text_line_(lines, num_lines, textbox->cursor_pos);
 
     if (cursor_line != -1) {
         if (cursor_line < textbox->visible_line_start) {
@@ -370,21 +799,20 @@ void update_visible_lines(TextBox* textbox) {
         textbox->visible_line_start = num_lines > visible_lines ? num_lines - visible_lines : 0;
     }
     if (textbox->visible_line_start < 0) textbox->visible_line_start = 0;
-
-    free(lines);
-    TTF_CloseFont(font);
 }
 
 // Updates the textbox widget based on SDL events (mouse, keyboard, text input)
 // Parameters:
 // - textbox: The TextBox widget to update
 // - event: The SDL event to process
-void update_textbox(TextBox* textbox, SDL_Event event) {
+static void handle_textbox_event_(TextBox* textbox, SDL_Event event) {
     // Validate inputs to ensure the textbox, its parent, and parent state are valid
-    if (!textbox || !textbox->parent || !textbox->parent->is_open) {
-        printf("Invalid textbox, parent, or parent is not open\n");
+    if (!textbox || !textbox->parent) {
+        LOG_ERROR("Invalid textbox or parent");
         return;
     }
+    // Children of a closed container are skipped every frame; not worth a message
+    if (!is_parent_open(textbox->parent)) return;
 
     // Default to light theme if none is set for consistent styling
     if (!current_theme) {
@@ -396,21 +824,27 @@ void update_textbox(TextBox* textbox, SDL_Event event) {
     Uint16 mod = SDL_GetModState(); // Current keyboard modifier state (e.g., Shift, Ctrl)
 
     // Calculate absolute position in logical coordinates, accounting for parent and title bar
-    int abs_x = textbox->x + textbox->parent->x;
-    int abs_y = textbox->y + textbox->parent->y + textbox->parent->title_height;
-    // Scale to physical for hit test
-    int s_abs_x = (int)roundf(abs_x * dpi);
-    int s_abs_y = (int)roundf(abs_y * dpi);
-    int s_w = (int)roundf(textbox->w * dpi);
-    int s_h = (int)roundf(textbox->h * dpi);
+    int abs_x = textbox->x + textbox->parent->content_x;
+    int abs_y = textbox->y + textbox->parent->content_y;
+    // Cached physical rect for hit test
+    SDL_Rect rect = get_child_rect(textbox->parent, &textbox->rect_cache, textbox->x, textbox->y, textbox->w, textbox->h);
+    int s_abs_x = rect.x;
+    int s_abs_y = rect.y;
+    int s_w = rect.w;
+    int s_h = rect.h;
+
+    // Inactive widgets scrolled out of view can't be clicked; skip the font load below
+    if (!textbox->is_active && !is_child_visible(textbox->parent, rect)) {
+        return;
+    }
 
     // Load font for cursor position calculations
     int logical_font_size = current_theme->default_font_size;
     char* font_file = current_theme->font_file ? current_theme->font_file : "FreeMono.ttf";
     int logical_padding = current_theme->padding;
-    TTF_Font* font = TTF_OpenFont(font_file, logical_font_size);
+    TTF_Font* font = open_font_(font_file, logical_font_size);
     if (!font) {
-        printf("Failed to load font: %s\n", TTF_GetError());
+        LOG_ERROR("Failed to load font: %s", TTF_GetError());
         return;
     }
 
@@ -420,20 +854,20 @@ void update_textbox(TextBox* textbox, SDL_Event event) {
         int mouseY = event.button.y;
         // Check if click is inside the textbox (physical coords)
         if (mouseX >= s_abs_x && mouseX <= s_abs_x + s_w &&
-            mouseY >= s_abs_y && mouseY <= s_abs_y + s_h) {
+            mouseY >= s_abs_y && mouseY <= s_abs_y + s_h &&
+            is_point_in_parent_clip(textbox->parent, mouseX, mouseY)) {
             textbox->is_active = 1; // Activate the textbox
             textbox->is_mouse_selecting = 1; // Enable mouse-based selection
             textbox->selection_start = -1; // Clear existing selection
-            printf("Textbox clicked! Active\n");
+            LOG_DEBUG("Textbox clicked! Active");
 
             // Calculate cursor_pos from click position (logical)
             int logical_mouse_x = (int)roundf(mouseX / dpi);
             int logical_mouse_y = (int)roundf(mouseY / dpi);
             int click_y = logical_mouse_y - (abs_y + logical_padding);
             int clicked_line = textbox->visible_line_start + click_y / textbox->line_height;
-            int max_text_width = textbox->w - 2 * logical_padding;
             int num_lines = 0;
-            Line* lines = compute_visual_lines(textbox->text, max_text_width, font, &num_lines);
+            const Line* lines = textbox_lines_(textbox, &num_lines);
             if (clicked_line < num_lines) {
                 Line l = lines[clicked_line];
                 int click_x = logical_mouse_x - (abs_x + logical_padding);
@@ -452,13 +886,12 @@ void update_textbox(TextBox* textbox, SDL_Event event) {
             } else {
                 textbox->cursor_pos = strlen(textbox->text); // Click beyond text sets cursor to end
             }
-            free(lines);
             update_visible_lines(textbox);
         } else {
             textbox->is_active = 0; // Deactivate if clicked outside
             textbox->is_mouse_selecting = 0; // Stop mouse selection
             textbox->selection_start = -1; // Clear selection
-            printf("Clicked outside textbox! Inactive\n");
+            LOG_DEBUG("Clicked outside textbox! Inactive");
         }
     } 
     // Handle mouse button up event (left click)
@@ -481,9 +914,8 @@ void update_textbox(TextBox* textbox, SDL_Event event) {
             int logical_mouse_y = (int)roundf(mouseY / dpi);
             int click_y = logical_mouse_y - (abs_y + logical_padding);
             int clicked_line = textbox->visible_line_start + click_y / textbox->line_height;
-            int max_text_width = textbox->w - 2 * logical_padding;
             int num_lines = 0;
-            Line* lines = compute_visual_lines(textbox->text, max_text_width, font, &num_lines);
+            const Line* lines = textbox_lines_(textbox, &num_lines);
             if (clicked_line < num_lines) {
                 Line l = lines[clicked_line];
                 int click_x = logical_mouse_x - (abs_x + logical_padding);
@@ -502,7 +934,6 @@ void update_textbox(TextBox* textbox, SDL_Event event) {
             } else {
                 textbox->cursor_pos = strlen(textbox->text);
             }
-            free(lines);
             update_visible_lines(textbox);
         }
     } 
@@ -515,6 +946,7 @@ void update_textbox(TextBox* textbox, SDL_Event event) {
             memmove(textbox->text + sel_start, textbox->text + sel_end, strlen(textbox->text) - sel_end + 1);
             textbox->cursor_pos = sel_start;
             textbox->selection_start = -1;
+            textbox_edited_(textbox, sel_start, sel_end - sel_start, 0);
         }
         // Insert new text at cursor position
         int len = strlen(textbox->text);
@@ -523,6 +955,7 @@ void update_textbox(TextBox* textbox, SDL_Event event) {
             memmove(textbox->text + textbox->cursor_pos + input_len, 
                     textbox->text + textbox->cursor_pos, len - textbox->cursor_pos + 1);
             strncpy(textbox->text + textbox->cursor_pos, event.text.text, input_len);
+            textbox_edited_(textbox, textbox->cursor_pos, 0, input_len);
             textbox->cursor_pos += input_len;
             update_visible_lines(textbox);
         }
@@ -537,11 +970,13 @@ void update_textbox(TextBox* textbox, SDL_Event event) {
                 memmove(textbox->text + sel_start, textbox->text + sel_end, strlen(textbox->text) - sel_end + 1);
                 textbox->cursor_pos = sel_start;
                 textbox->selection_start = -1;
+                textbox_edited_(textbox, sel_start, sel_end - sel_start, 0);
             } else if (textbox->cursor_pos > 0) {
                 // Delete character before cursor
                 memmove(textbox->text + textbox->cursor_pos - 1, 
                         textbox->text + textbox->cursor_pos, strlen(textbox->text) - textbox->cursor_pos + 1);
                 textbox->cursor_pos--;
+                textbox_edited_(textbox, textbox->cursor_pos, 1, 0);
             }
             update_visible_lines(textbox);
         } else if (event.key.keysym.sym == SDLK_DELETE) {
@@ -552,10 +987,12 @@ void update_textbox(TextBox* textbox, SDL_Event event) {
                 memmove(textbox->text + sel_start, textbox->text + sel_end, strlen(textbox->text) - sel_end + 1);
                 textbox->cursor_pos = sel_start;
                 textbox->selection_start = -1;
+                textbox_edited_(textbox, sel_start, sel_end - sel_start, 0);
             } else if (textbox->cursor_pos < strlen(textbox->text)) {
                 // Delete character after cursor
                 memmove(textbox->text + textbox->cursor_pos, 
                         textbox->text + textbox->cursor_pos + 1, strlen(textbox->text) - textbox->cursor_pos);
+                textbox_edited_(textbox, textbox->cursor_pos, 1, 0);
             }
             update_visible_lines(textbox);
         } else if (event.key.keysym.sym == SDLK_LEFT) {
@@ -585,22 +1022,13 @@ void update_textbox(TextBox* textbox, SDL_Event event) {
                 update_visible_lines(textbox);
             }
         } else if (event.key.keysym.sym == SDLK_UP || event.key.keysym.sym == SDLK_DOWN) {
-            int max_text_width = textbox->w - 2 * logical_padding;
             int num_lines = 0;
-            Line* lines = compute_visual_lines(textbox->text, max_text_width, font, &num_lines);
+            const Line* lines = textbox_lines_(textbox, &num_lines);
 
             // Find current line and offset
-            int curr_line_idx = -1;
-            int curr_offset_chars = 0;
+            int curr_line_idx = find_text_line_(lines, num_lines, textbox->cursor_pos);
+            int curr_offset_chars = curr_line_idx != -1 ? textbox->cursor_pos - lines[curr_line_idx].start : 0;
             int old_cursor_pos = textbox->cursor_pos;
-            for (int i = 0; i < num_lines; i++) {
-                Line l = lines[i];
-                if (textbox->cursor_pos >= l.start && textbox->cursor_pos <= l.start + l.len) {
-                    curr_line_idx = i;
-                    curr_offset_chars = textbox->cursor_pos - l.start;
-                    break;
-                }
-            }
 
             if (curr_line_idx != -1) {
                 // Compute preferred width (logical)
@@ -643,8 +1071,6 @@ void update_textbox(TextBox* textbox, SDL_Event event) {
                 }
             }
 
-            free(lines);
-
             if (mod & KMOD_SHIFT) {
                 if (textbox->selection_start == -1) textbox->selection_start = old_cursor_pos;
             } else {
@@ -657,6 +1083,7 @@ void update_textbox(TextBox* textbox, SDL_Event event) {
             if (len + 1 < textbox->max_length) {
                 memmove(textbox->text + textbox->cursor_pos + 1, textbox->text + textbox->cursor_pos, len - textbox->cursor_pos + 1);
                 textbox->text[textbox->cursor_pos] = '\n';
+                textbox_edited_(textbox, textbox->cursor_pos, 0, 1);
                 textbox->cursor_pos++;
                 update_visible_lines(textbox);
             }
@@ -690,6 +1117,7 @@ void update_textbox(TextBox* textbox, SDL_Event event) {
                 memmove(textbox->text + sel_start, textbox->text + sel_start + sel_len, strlen(textbox->text) - (sel_start + sel_len) + 1);
                 textbox->cursor_pos = sel_start;
                 textbox->selection_start = -1;
+                textbox_edited_(textbox, sel_start, sel_len, 0);
                 update_visible_lines(textbox);
             }
         } else if (event.key.keysym.sym == SDLK_v && (mod & KMOD_CTRL)) {
@@ -706,10 +1134,12 @@ void update_textbox(TextBox* textbox, SDL_Event event) {
                         textbox->cursor_pos = sel_start;
                         textbox->selection_start = -1;
                         len -= sel_len;
+                        textbox_edited_(textbox, sel_start, sel_len, 0);
                     }
                     if (len + paste_len < textbox->max_length) {
                         memmove(textbox->text + textbox->cursor_pos + paste_len, textbox->text + textbox->cursor_pos, len - textbox->cursor_pos + 1);
                         strncpy(textbox->text + textbox->cursor_pos, paste_text, paste_len);
+                        textbox_edited_(textbox, textbox->cursor_pos, 0, paste_len);
                         textbox->cursor_pos += paste_len;
                         update_visible_lines(textbox);
                     }
@@ -722,9 +1152,42 @@ void update_textbox(TextBox* textbox, SDL_Event event) {
     TTF_CloseFont(font); // Free the font resource
 }
 
+// Blink timer callback: toggles the cursor and redraws only this textbox
+static void on_textbox_blink_(void* userdata) {
+    TextBox* textbox = (TextBox*)userdata;
+    textbox->blink.visible = !textbox->blink.visible;
+    mark_child_dirty(textbox->parent, get_child_rect(textbox->parent, &textbox->rect_cache, textbox->x, textbox->y, textbox->w, textbox->h));
+}
+
+// Updates the textbox from an SDL event and keeps the cursor blink in step with focus
+void update_textbox(TextBox* textbox, SDL_Event event) {
+    if (!textbox) {
+        handle_textbox_event_(textbox, event);  // Reports the invalid textbox
+        return;
+    }
+    int was_active = textbox->is_active;
+    int cursor_pos = textbox->cursor_pos, selection_start = textbox->selection_start;
+    int visible_line_start = textbox->visible_line_start;
+    unsigned version = textbox->layout.version;
+    handle_textbox_event_(textbox, event);
+    // Keys and text restart the cursor blink of an active textbox even when nothing else changes
+    bool typed = was_active && (event.type == SDL_KEYDOWN || event.type == SDL_TEXTINPUT);
+    if (typed || textbox->is_active != was_active || textbox->cursor_pos != cursor_pos || textbox->layout.version != version ||
+        textbox->selection_start != selection_start || textbox->visible_line_start != visible_line_start) {
+        mark_child_dirty(textbox->parent, get_child_rect(textbox->parent, &textbox->rect_cache, textbox->x, textbox->y, textbox->w, textbox->h));
+    }
+    // The cursor stays solid while focusing and typing, and blinks when idle
+    if (textbox->is_active && (!was_active || event.type == SDL_KEYDOWN || event.type == SDL_TEXTINPUT)) {
+        restart_cursor_blink_(&textbox->blink, on_textbox_blink_, textbox);
+    } else if (!textbox->is_active && was_active) {
+        stop_cursor_blink_(&textbox->blink);
+    }
+}
 
 void free_textbox(TextBox* textbox) {
     if (textbox) {
+        stop_cursor_blink_(&textbox->blink);
+        free_textbox_layout_(textbox);
         free(textbox->text);
         free(textbox->place_holder);
     }
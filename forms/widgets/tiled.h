@@ -0,0 +1,463 @@
+#include<SDL2/SDL.h>
+#include<SDL2/SDL_image.h>
+#include<stdio.h>
+#include<stdlib.h>
+#include<math.h>
+#ifdef _WIN32
+#include<direct.h>
+#define tiled_mkdir_(path) _mkdir(path)
+#else
+#include<sys/stat.h>
+#define tiled_mkdir_(path) mkdir(path, 0755)
+#endif
+
+// Tiled viewer for images too large for one texture (e.g. 40k x 40k scans).
+// The image is stored as a tile pyramid in a directory:
+//   <dir>/pyramid.txt            "FORMS-PYRAMID 1" then "width height tile_size levels ext"
+//   <dir>/<level>/<col>_<row>.<ext>
+// Level 0 is full resolution; each level halves the one before it, down to a
+// level that fits in one tile. Only tiles in view are loaded (on loader threads),
+// at the level closest to the current zoom; coarser tiles stand in while they load.
+
+#define TILED_PYRAMID_FILE "pyramid.txt"
+#define TILED_DEFAULT_TILE_SIZE 256
+#define TILED_MAX_TILES 256       // Tile textures kept per viewer (64 MB at 256 x 256)
+#define TILED_ZOOM_STEP 1.25f     // Zoom factor per mouse wheel notch
+#define TILED_MAX_ZOOM 8.0        // Screen pixels per image pixel at the closest zoom
+#define TILED_PATH_MAX 512
+
+// One tile texture held by a viewer
+typedef struct {
+	int level, col, row;
+	TextureCacheEntry *entry;  // Reference into the texture cache
+	Uint32 last_frame;         // Viewer frame the tile was last drawn (LRU)
+} TileSlot;
+
+typedef struct TiledImage{
+	Parent *parent;
+	int x, y, w, h;
+	const char *dir;           // Pyramid directory
+	int image_w, image_h;      // Level 0 size in pixels
+	int tile_size;
+	int levels;
+	char ext[8];               // Tile file extension, e.g. "png"
+	bool pyramid_ok;           // pyramid.txt was read
+	double view_x, view_y;     // Level 0 pixel at the viewer's top-left corner
+	double zoom;               // Physical screen pixels per level 0 pixel (0 = fit on first frame)
+	bool dragging;
+	int drag_x, drag_y;        // Last mouse position while panning (logical)
+	TileSlot tiles[TILED_MAX_TILES];
+	int tile_count;
+	Uint32 frame;              // Incremented every rendered frame
+	ChildRect rect_cache;      // Cached physical rect (see get_child_rect)
+}TiledImage;
+
+// Reads <dir>/pyramid.txt
+static inline bool read_tile_pyramid_(TiledImage *viewer){
+	char path[TILED_PATH_MAX];
+	snprintf(path, sizeof(path), "%s/%s", viewer->dir, TILED_PYRAMID_FILE);
+	FILE *in = fopen(path, "r");
+	if (!in) {
+		LOG_ERROR("Failed to open tile pyramid %s", path);
+		return false;
+	}
+	int version = 0;
+	bool ok = fscanf(in, "FORMS-PYRAMID %d %d %d %d %d %7s", &version, &viewer->image_w, &viewer->image_h,
+	                 &viewer->tile_size, &viewer->levels, viewer->ext) == 6 &&
+	          version == 1 && viewer->image_w > 0 && viewer->image_h > 0 &&
+	          viewer->tile_size > 0 && viewer->levels > 0;
+	fclose(in);
+	if (!ok) LOG_ERROR("Invalid tile pyramid %s", path);
+	return ok;
+}
+
+/**
+ * Writes a tile pyramid for an image that fits in memory. Pyramids for images larger
+ * than that can be made with any tiler that writes the same layout.
+ * @param tile_size Tile width/height in pixels (0 for TILED_DEFAULT_TILE_SIZE)
+ * @return true on success
+ */
+bool build_tile_pyramid(const char *image_path, const char *out_dir, int tile_size){
+	if (tile_size <= 0) tile_size = TILED_DEFAULT_TILE_SIZE;
+	SDL_Surface *level_surface = load_surface_(image_path);
+	if (!level_surface) {
+		LOG_ERROR("Failed to load img %s : %s", image_path, IMG_GetError());
+		return false;
+	}
+	int image_w = level_surface->w, image_h = level_surface->h;
+	char path[TILED_PATH_MAX];
+	tiled_mkdir_(out_dir);
+
+	int level = 0;
+	bool ok = true;
+	while (ok) {
+		SDL_SetSurfaceBlendMode(level_surface, SDL_BLENDMODE_NONE);  // Copy alpha as is
+		snprintf(path, sizeof(path), "%s/%d", out_dir, level);
+		tiled_mkdir_(path);
+
+		int cols = (level_surface->w + tile_size - 1) / tile_size;
+		int rows = (level_surface->h + tile_size - 1) / tile_size;
+		for (int row = 0; row < rows && ok; row++) {
+			for (int col = 0; col < cols && ok; col++) {
+				SDL_Rect src = {col * tile_size, row * tile_size, tile_size, tile_size};
+				if (src.x + src.w > level_surface->w) src.w = level_surface->w - src.x;
+				if (src.y + src.h > level_surface->h) src.h = level_surface->h - src.y;
+				SDL_Surface *tile = SDL_CreateRGBSurfaceWithFormat(0, src.w, src.h, 32, SDL_PIXELFORMAT_ARGB8888);
+				snprintf(path, sizeof(path), "%s/%d/%d_%d.png", out_dir, level, col, row);
+				ok = tile && SDL_BlitSurface(level_surface, &src, tile, NULL) == 0 && IMG_SavePNG(tile, path) == 0;
+				if (tile) SDL_FreeSurface(tile);
+			}
+		}
+		if (!ok || (level_surface->w <= tile_size && level_surface->h <= tile_size)) break;
+
+		SDL_Surface *next = scale_surface_(level_surface, (level_surface->w + 1) / 2, (level_surface->h + 1) / 2);
+		SDL_FreeSurface(level_surface);
+		level_surface = next;
+		ok = next != NULL;
+		level++;
+	}
+	if (level_surface) SDL_FreeSurface(level_surface);
+	if (!ok) {
+		LOG_ERROR("Failed to write tile pyramid %s : %s", out_dir, SDL_GetError());
+		return false;
+	}
+
+	snprintf(path, sizeof(path), "%s/%s", out_dir, TILED_PYRAMID_FILE);
+	FILE *out = fopen(path, "w");
+	if (!out) {
+		LOG_ERROR("Failed to write tile pyramid %s", path);
+		return false;
+	}
+	fprintf(out, "FORMS-PYRAMID 1\n%d %d %d %d png\n", image_w, image_h, tile_size, level + 1);
+	fclose(out);
+	return true;
+}
+
+/**
+ * Creates a viewer for the tile pyramid in pyramid_dir (see build_tile_pyramid).
+ * The whole image is fitted into the w x h box on the first frame.
+ */
+TiledImage new_tiled_image(Parent *parent, int x, int y, int w, int h, const char *pyramid_dir){
+	if(!parent || !parent->base.sdl_renderer){
+		LOG_ERROR("Invalid parent or renderer for tiled image widget");
+	}
+
+	TiledImage viewer;
+
+	viewer.parent = parent;
+	viewer.x = x;
+	viewer.y = y;
+	viewer.w = w;
+	viewer.h = h;
+	viewer.dir = pyramid_dir;
+	viewer.image_w = 0;
+	viewer.image_h = 0;
+	viewer.tile_size = TILED_DEFAULT_TILE_SIZE;
+	viewer.levels = 0;
+	viewer.ext[0] = '\0';
+	viewer.pyramid_ok = pyramid_dir && read_tile_pyramid_(&viewer);
+	viewer.view_x = 0;
+	viewer.view_y = 0;
+	viewer.zoom = 0;
+	viewer.dragging = false;
+	viewer.drag_x = 0;
+	viewer.drag_y = 0;
+	viewer.tile_count = 0;
+	viewer.frame = 0;
+	viewer.rect_cache = (ChildRect){0};
+
+	return viewer;
+}
+
+// Smallest zoom that still shows the whole image in a w x h (physical) box
+static inline double tiled_fit_zoom_(TiledImage *viewer, int w, int h){
+	double zx = (double)w / viewer->image_w, zy = (double)h / viewer->image_h;
+	return zx < zy ? zx : zy;
+}
+
+// Keeps the image on screen; centres it along axes where it is smaller than the viewer
+static inline void clamp_tiled_view_(TiledImage *viewer, SDL_Rect rect){
+	double min_zoom = tiled_fit_zoom_(viewer, rect.w, rect.h);
+	if (viewer->zoom < min_zoom) viewer->zoom = min_zoom;
+	if (viewer->zoom > TILED_MAX_ZOOM) viewer->zoom = TILED_MAX_ZOOM;
+
+	double span_x = rect.w / viewer->zoom, span_y = rect.h / viewer->zoom;
+	if (span_x >= viewer->image_w) viewer->view_x = (viewer->image_w - span_x) / 2;
+	else if (viewer->view_x < 0) viewer->view_x = 0;
+	else if (viewer->view_x > viewer->image_w - span_x) viewer->view_x = viewer->image_w - span_x;
+	if (span_y >= viewer->image_h) viewer->view_y = (viewer->image_h - span_y) / 2;
+	else if (viewer->view_y < 0) viewer->view_y = 0;
+	else if (viewer->view_y > viewer->image_h - span_y) viewer->view_y = viewer->image_h - span_y;
+}
+
+/**
+ * Centres the view on a level 0 pixel.
+ * @param zoom Screen pixels per image pixel (0 keeps the current zoom)
+ */
+void set_tiled_view(TiledImage *viewer, double center_x, double center_y, double zoom){
+	if (!viewer || !viewer->pyramid_ok) return;
+	SDL_Rect rect = get_child_rect(viewer->parent, &viewer->rect_cache, viewer->x, viewer->y, viewer->w, viewer->h);
+	if (zoom > 0) viewer->zoom = zoom;
+	if (viewer->zoom <= 0) viewer->zoom = tiled_fit_zoom_(viewer, rect.w, rect.h);
+	viewer->view_x = center_x - rect.w / viewer->zoom / 2;
+	viewer->view_y = center_y - rect.h / viewer->zoom / 2;
+	clamp_tiled_view_(viewer, rect);
+}
+
+// Size of a level in pixels and in tiles
+static inline void tiled_level_size_(TiledImage *viewer, int level, int *w, int *h, int *cols, int *rows){
+	double scale = ldexp(1.0, level);  // Level 0 pixels per pixel of this level
+	*w = (int)ceil(viewer->image_w / scale);
+	*h = (int)ceil(viewer->image_h / scale);
+	*cols = (*w + viewer->tile_size - 1) / viewer->tile_size;
+	*rows = (*h + viewer->tile_size - 1) / viewer->tile_size;
+}
+
+// Finest level whose pixels are no smaller than a screen pixel at this zoom
+static inline int tiled_level_for_zoom_(TiledImage *viewer){
+	int level = viewer->zoom >= 1.0 ? 0 : (int)floor(log2(1.0 / viewer->zoom));
+	return level < viewer->levels ? level : viewer->levels - 1;
+}
+
+static inline int find_tile_(TiledImage *viewer, int level, int col, int row){
+	for (int i = 0; i < viewer->tile_count; i++) {
+		TileSlot *slot = &viewer->tiles[i];
+		if (slot->level == level && slot->col == col && slot->row == row) return i;
+	}
+	return -1;
+}
+
+// Frees the least recently drawn slot not needed this frame; false if every slot is in use
+static inline bool evict_lru_tile_(TiledImage *viewer){
+	int lru = -1;
+	for (int i = 0; i < viewer->tile_count; i++) {
+		if (viewer->tiles[i].last_frame == viewer->frame) continue;
+		if (lru < 0 || viewer->tiles[i].last_frame < viewer->tiles[lru].last_frame) lru = i;
+	}
+	if (lru < 0) return false;
+	release_texture_(viewer->tiles[lru].entry);
+	viewer->tiles[lru] = viewer->tiles[--viewer->tile_count];
+	return true;
+}
+
+// Returns the tile's cache entry, queueing its load if it is not held yet (NULL if no slot is free)
+static inline TextureCacheEntry* request_tile_(TiledImage *viewer, int level, int col, int row){
+	int index = find_tile_(viewer, level, col, row);
+	if (index < 0) {
+		if (viewer->tile_count == TILED_MAX_TILES && !evict_lru_tile_(viewer)) return NULL;
+		char path[TILED_PATH_MAX];
+		snprintf(path, sizeof(path), "%s/%d/%d_%d.%s", viewer->dir, level, col, row, viewer->ext);
+		TextureCacheEntry *entry = acquire_texture_async_(viewer->parent->base.sdl_renderer, path, 0, 0);
+		if (!entry) return NULL;
+		index = viewer->tile_count++;
+		viewer->tiles[index] = (TileSlot){level, col, row, entry, 0};
+	}
+	TileSlot *slot = &viewer->tiles[index];
+	slot->last_frame = viewer->frame;
+	if (slot->entry->state == TEXTURE_EVICTED) reload_texture_async_(slot->entry);
+	touch_texture_(slot->entry);
+	return slot->entry;
+}
+
+// Records the part of a ready coarser tile that covers (level, col, row); false if none is loaded
+static inline bool record_tile_fallback_(DrawList *list, TiledImage *viewer, int level, int col, int row, SDL_Rect dst, int tile_w, int tile_h){
+	for (int coarse = level + 1; coarse < viewer->levels; coarse++) {
+		int shift = coarse - level;
+		int index = find_tile_(viewer, coarse, col >> shift, row >> shift);
+		if (index < 0) continue;
+		TextureCacheEntry *entry = viewer->tiles[index].entry;
+		if (entry->state != TEXTURE_READY) continue;
+
+		viewer->tiles[index].last_frame = viewer->frame;
+		int size = viewer->tile_size;
+		SDL_Rect src = {((col * size) >> shift) - (col >> shift) * size,
+		                ((row * size) >> shift) - (row >> shift) * size,
+		                (tile_w >> shift) > 0 ? tile_w >> shift : 1,
+		                (tile_h >> shift) > 0 ? tile_h >> shift : 1};
+		record_texture_(list, &(viewer->parent->base), NULL, entry, &src, dst);
+		return true;
+	}
+	return false;
+}
+
+// Records the visible tiles into `list`, requesting the missing ones. Calling thread only
+// (tile loads go through the texture cache).
+static inline void record_tiled_image_(DrawList *list, TiledImage *viewer){
+	if (!viewer || !viewer->parent || !viewer->parent->base.sdl_renderer) {
+		LOG_ERROR("Invalid tiled image widget or renderer");
+		return;
+	}
+	// Children of a closed container are skipped every frame; not worth a message
+	if (!is_parent_open(viewer->parent) || !viewer->pyramid_ok) return;
+
+	SDL_Rect rect = get_child_rect(viewer->parent, &viewer->rect_cache, viewer->x, viewer->y, viewer->w, viewer->h);
+	// Skip widgets scrolled out of the parent's viewport or hidden behind an opaque container
+	if (!is_child_visible(viewer->parent, rect) || is_child_occluded(viewer->parent, rect)) return;
+	if (rect.w <= 0 || rect.h <= 0) return;
+
+	viewer->frame++;
+	if (viewer->zoom <= 0) viewer->zoom = tiled_fit_zoom_(viewer, rect.w, rect.h);
+	clamp_tiled_view_(viewer, rect);
+
+	// Clip to the viewer, and to the container like any other child
+	SDL_Rect clip = rect;
+	if (viewer->parent->is_window == false) {
+		SDL_Rect parent_bounds = get_parent_rect(viewer->parent);
+		if (!SDL_IntersectRect(&rect, &parent_bounds, &clip)) return;
+	}
+	record_clip_(list, &viewer->parent->base, &clip);
+	record_rect_(list, &(viewer->parent->base), rect.x, rect.y, rect.w, rect.h, current_theme->bg_secondary);
+
+	int level = tiled_level_for_zoom_(viewer);
+	int size = viewer->tile_size;
+	double scale = ldexp(1.0, level);  // Level 0 pixels per pixel of this level
+	int level_w, level_h, cols, rows;
+	tiled_level_size_(viewer, level, &level_w, &level_h, &cols, &rows);
+
+	// Tiles overlapping the view, in this level's tile grid
+	int col0 = (int)floor(viewer->view_x / scale / size), row0 = (int)floor(viewer->view_y / scale / size);
+	int col1 = (int)floor((viewer->view_x + rect.w / viewer->zoom) / scale / size);
+	int row1 = (int)floor((viewer->view_y + rect.h / viewer->zoom) / scale / size);
+	if (col0 < 0) col0 = 0;
+	if (row0 < 0) row0 = 0;
+	if (col1 >= cols) col1 = cols - 1;
+	if (row1 >= rows) row1 = rows - 1;
+
+	// The coarsest level is tiny and always requested, so there is something to show while zooming
+	int top = viewer->levels - 1;
+	if (level != top) {
+		int shift = top - level, top_w, top_h, top_cols, top_rows;
+		tiled_level_size_(viewer, top, &top_w, &top_h, &top_cols, &top_rows);
+		for (int row = row0 >> shift; row <= row1 >> shift && row < top_rows; row++) {
+			for (int col = col0 >> shift; col <= col1 >> shift && col < top_cols; col++) {
+				request_tile_(viewer, top, col, row);
+			}
+		}
+	}
+
+	for (int row = row0; row <= row1; row++) {
+		for (int col = col0; col <= col1; col++) {
+			int tile_w = (col + 1) * size > level_w ? level_w - col * size : size;
+			int tile_h = (row + 1) * size > level_h ? level_h - row * size : size;
+			// Snap both edges so neighbouring tiles never leave a gap
+			int x0 = rect.x + (int)floor((col * size * scale - viewer->view_x) * viewer->zoom);
+			int y0 = rect.y + (int)floor((row * size * scale - viewer->view_y) * viewer->zoom);
+			int x1 = rect.x + (int)floor(((col * size + tile_w) * scale - viewer->view_x) * viewer->zoom);
+			int y1 = rect.y + (int)floor(((row * size + tile_h) * scale - viewer->view_y) * viewer->zoom);
+			SDL_Rect dst = {x0, y0, x1 - x0, y1 - y0};
+			if (dst.w <= 0 || dst.h <= 0) continue;
+
+			TextureCacheEntry *entry = request_tile_(viewer, level, col, row);
+			if (entry && entry->state == TEXTURE_READY) {
+				record_texture_(list, &(viewer->parent->base), NULL, entry, NULL, dst);
+			} else {
+				if (entry && entry->state == TEXTURE_LOADING) wait_for_texture_(entry, dst);  // Redrawn when it arrives
+				record_tile_fallback_(list, viewer, level, col, row, dst, tile_w, tile_h);
+			}
+		}
+	}
+	// Reset clipping
+	record_clip_(list, &viewer->parent->base, NULL);
+}
+
+void render_tiled_image(TiledImage *viewer){
+	record_tiled_image_(begin_immediate_draw_(), viewer);
+	end_immediate_draw_();
+}
+
+// Pans with a left-button drag and zooms around the cursor with the wheel.
+// Returns true if it consumed a wheel event (so containers do not also scroll).
+bool update_tiled_image(TiledImage *viewer, SDL_Event event){
+	if (!viewer || !viewer->parent) {
+		LOG_ERROR("Invalid tiled image or parent");
+		return false;
+	}
+	if (!is_parent_open(viewer->parent) || !viewer->pyramid_ok || viewer->zoom <= 0) return false;
+
+	// Logical bounds for hit testing
+	int abs_x = viewer->x + viewer->parent->content_x;
+	int abs_y = viewer->y + viewer->parent->content_y;
+	int mouse_x, mouse_y;
+	SDL_GetMouseState(&mouse_x, &mouse_y);
+	bool over = mouse_x >= abs_x && mouse_x < abs_x + viewer->w &&
+	            mouse_y >= abs_y && mouse_y < abs_y + viewer->h &&
+	            is_logical_point_in_parent_clip(viewer->parent, mouse_x, mouse_y);
+	float dpi = viewer->parent->base.dpi_scale;
+
+	if (event.type == SDL_MOUSEWHEEL && over && event.wheel.y != 0) {
+		SDL_Rect rect = get_child_rect(viewer->parent, &viewer->rect_cache, viewer->x, viewer->y, viewer->w, viewer->h);
+		// Keep the image point under the cursor fixed
+		double cursor_x = (mouse_x - abs_x) * dpi, cursor_y = (mouse_y - abs_y) * dpi;
+		double image_x = viewer->view_x + cursor_x / viewer->zoom;
+		double image_y = viewer->view_y + cursor_y / viewer->zoom;
+		viewer->zoom *= pow(TILED_ZOOM_STEP, event.wheel.y);
+		clamp_tiled_view_(viewer, rect);
+		viewer->view_x = image_x - cursor_x / viewer->zoom;
+		viewer->view_y = image_y - cursor_y / viewer->zoom;
+		clamp_tiled_view_(viewer, rect);
+		mark_child_dirty(viewer->parent, rect);
+		return true;
+	} else if (event.type == SDL_MOUSEBUTTONDOWN && event.button.button == SDL_BUTTON_LEFT && over) {
+		viewer->dragging = true;
+		viewer->drag_x = mouse_x;
+		viewer->drag_y = mouse_y;
+	} else if (event.type == SDL_MOUSEBUTTONUP && event.button.button == SDL_BUTTON_LEFT) {
+		viewer->dragging = false;
+	} else if (event.type == SDL_MOUSEMOTION && viewer->dragging) {
+		viewer->view_x -= (mouse_x - viewer->drag_x) * dpi / viewer->zoom;
+		viewer->view_y -= (mouse_y - viewer->drag_y) * dpi / viewer->zoom;
+		viewer->drag_x = mouse_x;
+		viewer->drag_y = mouse_y;  // Clamped on the next render
+		mark_child_dirty(viewer->parent, get_child_rect(viewer->parent, &viewer->rect_cache, viewer->x, viewer->y, viewer->w, viewer->h));
+	}
+	return false;
+}
+
+void free_tiled_image(TiledImage *viewer){
+	if (!viewer) return;
+	for (int i = 0; i < viewer->tile_count; i++) {
+		release_texture_(viewer->tiles[i].entry);
+	}
+	viewer->tile_count = 0;
+}
+
+
+// Registration of widgets for rendering
+#define MAX_TILED_IMAGES 16
+TiledImage * tiled_image_widgets[MAX_TILED_IMAGES];
+
+int tiled_images_count = 0;
+
+void register_tiled_image(TiledImage* viewer) {
+    if (tiled_images_count < MAX_TILED_IMAGES) {
+        tiled_image_widgets[tiled_images_count] = viewer;
+        tiled_images_count++;
+    }
+}
+
+void render_all_registered_tiled_images(void) {
+    for (int i = 0; i < tiled_images_count; i++) {
+        if (tiled_image_widgets[i]) {
+            render_tiled_image(tiled_image_widgets[i]);
+        }
+    }
+}
+
+// Returns true if a viewer consumed a wheel event
+bool update_all_registered_tiled_images(SDL_Event event) {
+    bool consumed = false;
+    for (int i = 0; i < tiled_images_count; i++) {
+        if (tiled_image_widgets[i] && update_tiled_image(tiled_image_widgets[i], event)) {
+            consumed = true;
+        }
+    }
+    return consumed;
+}
+
+void free_all_registered_tiled_images(void){
+	for(int i=0; i< tiled_images_count; i++){
+		free_tiled_image(tiled_image_widgets[i]);
+		tiled_image_widgets[i]=NULL;
+	}
+	tiled_images_count = 0;
+}
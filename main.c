@@ -9,6 +9,8 @@ int main(void) {
 
     // Enable moving, title bar, close button,
     set_container_properties(&container, true, "My Container", true, true);
+    // Content below the bottom edge is reached with the mouse wheel or the scrollbar
+    set_container_scrollable(&container, true);
     register_container(&container);
 
     Parent container2 = new_container(&app.window, 400, 10, 400, 650);
@@ -38,8 +40,8 @@ int main(void) {
          Drop drop_down = new_drop_down(&container, 15, 200, 170, 30, options, option_count);
          register_drop(&drop_down);
 // ---------- SLIDER DEMO ----------
-    // Create a slider in container (horizontal, 100px wide, 20px high, range 0-100, starting at 50)
-    Slider slider = new_slider(&container, 10, 370, 250, 15, 0, 100, 50, "Volume");
+    // Create a slider below the visible area of the container (horizontal, 100px wide, 20px high, range 0-100, starting at 50)
+    Slider slider = new_slider(&container, 10, 570, 250, 15, 0, 100, 50, "Volume");
     register_slider(&slider);
 
  	 Entry entry =  new_entry(&container2, 20, 70, 300, 2048);
@@ -58,9 +60,37 @@ int main(void) {
 
     register_progress_bar(&prox);
 
+    // Containers can be nested; children are positioned and clipped inside their parent
+    Parent panel = new_container(&container2, 20, 530, 360, 80);
+    set_container_properties(&panel, false, "Nested Panel", true, false);
+    register_container(&panel);
+
+    Text panel_text = new_text(&panel, 10, 10, "Inside a nested container", 14, ALIGN_LEFT);
+    register_text(&panel_text);
+
+    // Live values from another process: run `make feed` while the demo is open (see forms/core/feed.h)
+    Observable cpu = new_observable_int(50);
+    Observable status = new_observable_text("Inside a nested container");
+    bind_progress_bar(&prox, &cpu);
+    bind_text(&panel_text, &status);
+    UiFeed* feed = open_ui_feed("/forms-demo");
+    bind_feed_int(feed, "cpu", &cpu);
+    bind_feed_text(feed, "status", &status);
+
+    // Keep the second container stretched to the window height when it is resized
+    Layout window_layout = new_layout(&app.window, LAYOUT_ANCHOR);
+    int c2 = layout_add_container(&window_layout, &container2);
+    set_layout_item_anchors(&window_layout, c2, ANCHOR_LEFT | ANCHOR_TOP | ANCHOR_BOTTOM);
+    register_layout(&window_layout);
+
     Image  image = new_image(&app.window, 400, 0, "img.jpg", 0, 0 );
 	register_image(&image);
     app_run_(&app.window);
+    free_observable(&cpu);
+    free_observable(&status);
+
+    // Where launch time went (SDL init, fonts, images, first layout/render/present)
+    print_startup_report(get_startup_report(&app), stdout);
 
 
     return 0;
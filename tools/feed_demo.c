@@ -0,0 +1,72 @@
+// Stand-in for a monitoring backend: posts to a forms feed (see forms/core/feed.h).
+//
+//   feed_demo [-n /forms-demo] [-r 250] [-c 0]
+//
+// Posts "cpu" (0-100), "status" texts and "latency" series points at -r updates per
+// second until -c updates have been posted (0 = forever). Waits for the app to open
+// the feed and reattaches when the app restarts. Prints how many were dropped.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../forms/core/feed_writer.h"
+
+static void sleep_ms(long ms) {
+    struct timespec ts = {ms / 1000, (ms % 1000) * 1000000L};
+    nanosleep(&ts, NULL);
+}
+
+int main(int argc, char** argv) {
+    const char* name = "/forms-demo";
+    long rate = 250;
+    long limit = 0;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "-n") == 0) name = argv[i + 1];
+        else if (strcmp(argv[i], "-r") == 0) rate = atol(argv[i + 1]);
+        else if (strcmp(argv[i], "-c") == 0) limit = atol(argv[i + 1]);
+        else {
+            fprintf(stderr, "usage: %s [-n name] [-r updates per second] [-c count]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (rate < 1) rate = 1;
+
+    FeedWriter* writer = NULL;
+    long posted = 0, dropped = 0;
+    int cpu = 50;
+    srand((unsigned)time(NULL));
+    while (limit == 0 || posted + dropped < limit) {
+        if (!is_feed_reader_open(writer)) {
+            close_feed_writer(writer);
+            writer = open_feed_writer(name);
+            if (!writer) {
+                sleep_ms(100);  // The app has not opened the feed yet
+                continue;
+            }
+            printf("attached to %s\n", name);
+        }
+
+        long n = posted + dropped;
+        bool ok;
+        if (n % 50 == 0) {
+            char status[64];
+            snprintf(status, sizeof(status), "backend: %ld updates, cpu %d%%", n, cpu);
+            ok = post_feed_text(writer, "status", status);
+        } else if (n % 5 == 0) {
+            ok = post_feed_point(writer, "latency", (double)n / rate, 10.0 + rand() % 40);
+        } else {
+            cpu += rand() % 11 - 5;
+            cpu = cpu < 0 ? 0 : cpu > 100 ? 100 : cpu;
+            ok = post_feed_int(writer, "cpu", cpu);
+        }
+        if (ok) posted++;
+        else dropped++;
+        sleep_ms(1000 / rate);
+    }
+
+    printf("%ld posted, %ld dropped\n", posted, dropped);
+    close_feed_writer(writer);
+    return 0;
+}
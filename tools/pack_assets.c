@@ -0,0 +1,148 @@
+// Builds an asset pack (see forms/core/pack.h for the format).
+//
+//   pack_assets -o assets.pak file...          binary pack, loaded with mmap
+//   pack_assets -c -o assets_pack.h file...    C header embedding the pack
+//
+// Files are stored under the path given on the command line ("./" stripped),
+// which is the name the library looks them up by.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PACK_MAGIC "FPAK"
+#define PACK_VERSION 1
+#define PACK_ALIGN 16
+#define PACK_HEADER_SIZE 16
+#define PACK_ENTRY_SIZE 24
+
+typedef struct {
+    const char* name;
+    unsigned char* data;
+    uint64_t size;
+    uint64_t offset;
+    uint32_t name_offset;
+} PackFile;
+
+static int compare_names(const void* a, const void* b) {
+    return strcmp(((const PackFile*)a)->name, ((const PackFile*)b)->name);
+}
+
+static void put_u32(unsigned char* p, uint32_t v) {
+    for (int i = 0; i < 4; i++) p[i] = (unsigned char)(v >> (8 * i));
+}
+
+static void put_u64(unsigned char* p, uint64_t v) {
+    for (int i = 0; i < 8; i++) p[i] = (unsigned char)(v >> (8 * i));
+}
+
+static unsigned char* read_file(const char* path, uint64_t* size) {
+    FILE* in = fopen(path, "rb");
+    if (!in) return NULL;
+    fseek(in, 0, SEEK_END);
+    long length = ftell(in);
+    fseek(in, 0, SEEK_SET);
+    unsigned char* data = length >= 0 ? malloc(length ? (size_t)length : 1) : NULL;
+    if (data && fread(data, 1, (size_t)length, in) != (size_t)length) {
+        free(data);
+        data = NULL;
+    }
+    fclose(in);
+    *size = (uint64_t)length;
+    return data;
+}
+
+static int write_header(FILE* out, const unsigned char* pack, uint64_t size) {
+    fprintf(out, "// Generated by tools/pack_assets. Do not edit.\n");
+    fprintf(out, "static const unsigned char forms_embedded_pack[] = {");
+    for (uint64_t i = 0; i < size; i++) {
+        fprintf(out, "%s0x%02x,", i % 16 ? " " : "\n    ", pack[i]);
+    }
+    fprintf(out, "\n};\nstatic const size_t forms_embedded_pack_size = %llu;\n", (unsigned long long)size);
+    return ferror(out) ? -1 : 0;
+}
+
+int main(int argc, char** argv) {
+    const char* output = NULL;
+    int as_header = 0;
+    int first = 1;
+    for (; first < argc && argv[first][0] == '-'; first++) {
+        if (strcmp(argv[first], "-c") == 0) {
+            as_header = 1;
+        } else if (strcmp(argv[first], "-o") == 0 && first + 1 < argc) {
+            output = argv[++first];
+        } else {
+            break;
+        }
+    }
+    int count = argc - first;
+    if (!output || count <= 0) {
+        fprintf(stderr, "usage: %s [-c] -o output file...\n", argv[0]);
+        return 1;
+    }
+
+    PackFile* files = calloc((size_t)count, sizeof(PackFile));
+    if (!files) return 1;
+    for (int i = 0; i < count; i++) {
+        const char* name = argv[first + i];
+        while (name[0] == '.' && name[1] == '/') name += 2;
+        files[i].name = name;
+        files[i].data = read_file(argv[first + i], &files[i].size);
+        if (!files[i].data) {
+            fprintf(stderr, "pack_assets: cannot read %s\n", argv[first + i]);
+            return 1;
+        }
+    }
+    qsort(files, (size_t)count, sizeof(PackFile), compare_names);
+
+    // Lay out: header, index, names, then aligned data
+    uint64_t offset = PACK_HEADER_SIZE + (uint64_t)count * PACK_ENTRY_SIZE;
+    for (int i = 0; i < count; i++) {
+        if (i > 0 && strcmp(files[i].name, files[i - 1].name) == 0) {
+            fprintf(stderr, "pack_assets: %s given twice\n", files[i].name);
+            return 1;
+        }
+        files[i].name_offset = (uint32_t)offset;
+        offset += strlen(files[i].name) + 1;
+    }
+    for (int i = 0; i < count; i++) {
+        offset = (offset + PACK_ALIGN - 1) / PACK_ALIGN * PACK_ALIGN;
+        files[i].offset = offset;
+        offset += files[i].size;
+    }
+
+    unsigned char* pack = calloc(1, (size_t)offset);
+    if (!pack) return 1;
+    memcpy(pack, PACK_MAGIC, 4);
+    put_u32(pack + 4, PACK_VERSION);
+    put_u32(pack + 8, (uint32_t)count);
+    for (int i = 0; i < count; i++) {
+        unsigned char* entry = pack + PACK_HEADER_SIZE + (size_t)i * PACK_ENTRY_SIZE;
+        size_t name_length = strlen(files[i].name);
+        put_u32(entry, files[i].name_offset);
+        put_u32(entry + 4, (uint32_t)name_length);
+        put_u64(entry + 8, files[i].offset);
+        put_u64(entry + 16, files[i].size);
+        memcpy(pack + files[i].name_offset, files[i].name, name_length + 1);
+        memcpy(pack + files[i].offset, files[i].data, (size_t)files[i].size);
+        free(files[i].data);
+    }
+
+    FILE* out = fopen(output, as_header ? "w" : "wb");
+    if (!out) {
+        fprintf(stderr, "pack_assets: cannot write %s\n", output);
+        return 1;
+    }
+    int failed = as_header ? write_header(out, pack, offset)
+                           : fwrite(pack, 1, (size_t)offset, out) != (size_t)offset;
+    failed |= fclose(out) != 0;
+    free(pack);
+    free(files);
+    if (failed) {
+        fprintf(stderr, "pack_assets: failed writing %s\n", output);
+        return 1;
+    }
+    printf("Packed %d files (%llu bytes) into %s\n", count, (unsigned long long)offset, output);
+    return 0;
+}